@@ -559,10 +559,14 @@ MappedName ElementMap::setElementName(const IndexedName& element,
         return {};
     }
 
-    for (int i = 0, count = name.size(); i < count; ++i) {
-        char check = name[i];
-        if (check == '.' || (std::isspace((int)check) != 0)) {
-            FC_THROWM(Base::RuntimeError, "Illegal character in mapped name: " << name);  // NOLINT
+    // Check the raw bytes instead of going through MappedName::operator[] because this is
+    // called for every element of every shape that gets a new element map
+    for (const QByteArray* bytes : {&name.dataBytes(), &name.postfixBytes()}) {
+        for (char check : *bytes) {
+            if (check == '.' || (std::isspace((int)check) != 0)) {
+                FC_THROWM(Base::RuntimeError,  // NOLINT
+                          "Illegal character in mapped name: " << name);
+            }
         }
     }
     for (const char* readChar = element.getType(); *readChar != 0; ++readChar) {
@@ -25,6 +25,8 @@
 #ifndef APP_MAPPED_NAME_H
 #define APP_MAPPED_NAME_H
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -646,15 +648,20 @@ public:
     {
         int thisSize = this->size();
         int otherSize = other.size();
-        for (int i = 0, count = std::min(thisSize, otherSize); i < count; ++i) {
-            char thisChar = this->operator[](i);
-            char otherChar = other[i];
-            if (thisChar < otherChar) {
-                return -1;
-            }
-            if (thisChar > otherChar) {
-                return 1;
+        int count = std::min(thisSize, otherSize);
+        // Compare the longest runs that are contiguous in both names instead of going through
+        // operator[] for every byte. This is the hot path of all maps keyed by a MappedName.
+        for (int pos = 0; pos < count;) {
+            int thisRun = 0;
+            int otherRun = 0;
+            const char* thisChars = this->segment(pos, thisRun);
+            const char* otherChars = other.segment(pos, otherRun);
+            int run = std::min({thisRun, otherRun, count - pos});
+            if (std::memcmp(thisChars, otherChars, run) != 0) {
+                auto diff = std::mismatch(thisChars, thisChars + run, otherChars);
+                return *diff.first < *diff.second ? -1 : 1;
             }
+            pos += run;
         }
         if (thisSize < otherSize) {
             return -1;
@@ -923,6 +930,20 @@ public:
         return qHash(data, qHash(postfix));
     }
 
+private:
+    /// Returns the bytes starting at \a pos up to the end of data or postfix, whichever
+    /// contains \a pos, and their number in \a count.
+    const char* segment(int pos, int& count) const
+    {
+        if (pos < this->data.size()) {
+            count = this->data.size() - pos;
+            return this->data.constData() + pos;
+        }
+        pos -= this->data.size();
+        count = this->postfix.size() - pos;
+        return this->postfix.constData() + pos;
+    }
+
 private:
     QByteArray data;
     QByteArray postfix;
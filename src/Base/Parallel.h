@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef BASE_PARALLEL_H
+#define BASE_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+
+namespace Base
+{
+
+/** Calls \a func(index) for all indices in [0, count) using all available cores.
+ * The indices are handed out one by one, so calls of different duration are balanced over
+ * the threads. The calling thread takes part in the work and the function returns when all
+ * calls have finished. If a call throws, the remaining indices are skipped and the first
+ * exception is rethrown.
+ */
+template<typename Func>
+void runConcurrently(std::size_t count, Func&& func)
+{
+    std::atomic<std::size_t> next {0};
+    auto worker = [&next, count, &func]() {
+        try {
+            for (std::size_t index = next++; index < count; index = next++) {
+                func(index);
+            }
+        }
+        catch (...) {
+            next = count;
+            throw;
+        }
+    };
+
+    std::size_t numThreads =
+        std::min<std::size_t>(count, std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> tasks;
+    for (std::size_t i = 1; i < numThreads; i++) {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+
+    std::exception_ptr error;
+    try {
+        worker();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    for (auto& task : tasks) {
+        try {
+            task.get();
+        }
+        catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace Base
+
+#endif  // BASE_PARALLEL_H
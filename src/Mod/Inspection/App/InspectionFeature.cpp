@@ -24,19 +24,30 @@
 
 #ifndef _PreComp_
 #include <boost/core/ignore_unused.hpp>
+#include <cstring>
 #include <numeric>
 
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
+#include <BRepClass_FaceClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <Geom_Surface.hxx>
 #include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 
 #include <QEventLoop>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 #endif
 
@@ -555,6 +566,206 @@ bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
 
 // ----------------------------------------------------------------
 
+struct InspectNominalFastShape::Private
+{
+    std::vector<TopoDS_Face> faces;
+    std::vector<unsigned long> facetToFace;
+    MeshCore::MeshKernel mesh;
+    std::unique_ptr<MeshInspectGrid> grid;
+    Base::BoundBox3f box;
+    float deflection {0.0F};
+    float gridLen {0.0F};
+    unsigned long maxLevel {0};
+};
+
+InspectNominalFastShape::InspectNominalFastShape(const TopoDS_Shape& shape, float offset)
+    : d(new Private)
+{
+    if (shape.IsNull()) {
+        return;
+    }
+
+    // Tessellate the shape. The triangles are only used to find the candidate faces, so the
+    // deviation of the mesh to the shape is taken into account when selecting them
+    Part::TopoShape topoShape(shape);
+    double deflection = topoShape.getAccuracy();
+    BRepMesh_IncrementalMesh(shape, deflection, Standard_False, 0.5, Standard_True);
+    d->deflection = float(deflection);
+
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        d->faces.push_back(TopoDS::Face(xp.Current()));
+    }
+
+    // getDomains() returns one domain per face in the same order as the explorer
+    std::vector<Data::ComplexGeoData::Domain> domains;
+    topoShape.getDomains(domains);
+
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (std::size_t index = 0; index < domains.size(); index++) {
+        const auto& domain = domains[index];
+        auto offsetPt = static_cast<MeshCore::PointIndex>(points.size());
+        for (const auto& pnt : domain.points) {
+            points.push_back(MeshCore::MeshPoint(Base::toVector<float>(pnt)));
+        }
+        for (const auto& tria : domain.facets) {
+            facets.push_back(MeshCore::MeshFacet(offsetPt + tria.I1,
+                                                 offsetPt + tria.I2,
+                                                 offsetPt + tria.I3));
+            d->facetToFace.push_back(static_cast<unsigned long>(index));
+        }
+    }
+
+    d->mesh.Adopt(points, facets);
+    if (d->mesh.CountFacets() == 0) {
+        return;
+    }
+
+    // Max. limit of grid elements
+    float fMaxGridElements = 8000000.0f;
+    Base::BoundBox3f box = d->mesh.GetBoundBox();
+
+    // estimate the minimum allowed grid length
+    float fMinGridLen =
+        (float)pow((box.LengthX() * box.LengthY() * box.LengthZ() / fMaxGridElements), 0.3333f);
+    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(d->mesh).GetAverageEdgeLength();
+    fGridLen = std::max<float>(fMinGridLen, fGridLen);
+
+    d->grid = std::make_unique<MeshInspectGrid>(d->mesh, fGridLen, Base::Matrix4D());
+    d->gridLen = fGridLen;
+    d->box = box;
+    d->box.Enlarge(offset + d->deflection);
+    d->maxLevel = (unsigned long)((offset + d->deflection) / fGridLen) + 1;
+}
+
+InspectNominalFastShape::~InspectNominalFastShape() = default;
+
+float InspectNominalFastShape::getDistance(const Base::Vector3f& point) const
+{
+    if (!d->grid || !d->box.IsInBox(point)) {
+        return FLT_MAX;  // must be inside bbox
+    }
+
+    // Stage 1: search the nearest triangle in the grid
+    unsigned long ulX, ulY, ulZ;
+    d->grid->Position(point, ulX, ulY, ulZ);
+
+    std::set<MeshCore::ElementIndex> indices;
+    unsigned long ulLevel = 0;
+    while (indices.empty() && ulLevel <= d->maxLevel) {
+        d->grid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
+    }
+    if (indices.empty()) {
+        return FLT_MAX;
+    }
+
+    // a triangle in the next level can be nearer
+    d->grid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
+
+    std::vector<std::pair<float, MeshCore::FacetIndex>> triangles;
+    triangles.reserve(indices.size());
+    float fMinDist = FLT_MAX;
+    bool positive = true;
+    for (auto it : indices) {
+        MeshCore::MeshGeomFacet geomFace = d->mesh.GetFacet(it);
+        float fDist = geomFace.DistanceToPoint(point);
+        triangles.emplace_back(fDist, it);
+        if (fDist < fMinDist) {
+            fMinDist = fDist;
+            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
+        }
+    }
+
+    // The true distance to the shape differs from the mesh distance by at most the deflection.
+    // So, every face with a triangle closer than the limit can contain the nearest point.
+    float fLimit = fMinDist + 2.0f * d->deflection;
+    std::set<unsigned long> candidates;
+    for (const auto& it : triangles) {
+        if (it.first <= fLimit) {
+            candidates.insert(d->facetToFace[it.second]);
+        }
+    }
+
+    // Stage 2: exact distance to the candidate faces only
+    gp_Pnt pnt3d(point.x, point.y, point.z);
+    double minDist = DBL_MAX;
+    int minSide = 0;
+    for (auto face : candidates) {
+        double dist {};
+        int side {};
+        if (projectOnFace(face, pnt3d, dist, side) && dist < minDist) {
+            minDist = dist;
+            minSide = side;
+        }
+    }
+
+    if (minDist == DBL_MAX) {
+        // use the approximation if the refinement failed
+        minDist = fMinDist;
+    }
+
+    // the sign of the mesh is only taken if the nearest point is on an edge or vertex
+    if (minSide == 0) {
+        minSide = positive ? 1 : -1;
+    }
+
+    return minSide > 0 ? float(minDist) : -float(minDist);
+}
+
+bool InspectNominalFastShape::projectOnFace(unsigned long face,
+                                            const gp_Pnt& pnt3d,
+                                            double& dist,
+                                            int& side) const
+{
+    // All algorithm objects are created locally so that this can be used by several threads
+    const TopoDS_Face& shape = d->faces[face];
+    side = 0;
+
+    Handle(Geom_Surface) surface = BRep_Tool::Surface(shape);
+    if (!surface.IsNull()) {
+        Standard_Real u1, u2, v1, v2;
+        BRepTools::UVBounds(shape, u1, u2, v1, v2);
+        GeomAPI_ProjectPointOnSurf proj(pnt3d, surface, u1, u2, v1, v2);
+        if (proj.NbPoints() > 0) {
+            Standard_Real u, v;
+            proj.LowerDistanceParameters(u, v);
+
+            // the projection lies inside the surface bounds but may be outside the face
+            BRepClass_FaceClassifier classifier(shape, gp_Pnt2d(u, v), BRep_Tool::Tolerance(shape));
+            if (classifier.State() == TopAbs_IN) {
+                dist = proj.LowerDistance();
+                BRepGProp_Face props(shape);
+                gp_Vec normal;
+                gp_Pnt center;
+                props.Normal(u, v, center, normal);
+                side = normal.Dot(gp_Vec(center, pnt3d)) < 0 ? -1 : 1;
+                return true;
+            }
+        }
+    }
+
+    // The nearest point lies on the boundary of the face
+    BRepBuilderAPI_MakeVertex mkVert(pnt3d);
+    BRepExtrema_DistShapeShape distss(mkVert.Vertex(), shape);
+    if (distss.IsDone() && distss.NbSolution() > 0) {
+        dist = distss.Value();
+        if (distss.SupportTypeShape2(1) == BRepExtrema_IsInFace) {
+            Standard_Real u, v;
+            distss.ParOnFaceS2(1, u, v);
+            BRepGProp_Face props(shape);
+            gp_Vec normal;
+            gp_Pnt center;
+            props.Normal(u, v, center, normal);
+            side = normal.Dot(gp_Vec(center, pnt3d)) < 0 ? -1 : 1;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// ----------------------------------------------------------------
+
 TYPESYSTEM_SOURCE(Inspection::PropertyDistanceList, App::PropertyLists)
 
 PropertyDistanceList::PropertyDistanceList() = default;
@@ -736,30 +947,96 @@ struct DistanceInspection
     std::vector<InspectNominalGeometry*> nominal;
 };
 
-// Helper internal class for QtConcurrent map operation. Holds sums-of-squares and counts for RMS
-// calculation
-class DistanceInspectionRMS
+// Helper internal class for QtConcurrent map-reduce operation. Holds sums-of-squares and counts
+// for RMS calculation, the distance range, a fine histogram for the percentiles and the distances
+// that are kept if not all of them are stored
+class DistanceInspectionStats
 {
 public:
-    DistanceInspectionRMS() = default;
-    DistanceInspectionRMS& operator+=(const DistanceInspectionRMS& rhs)
+    // Number of bins of the fine histogram over [-SearchRadius, SearchRadius]
+    static constexpr std::size_t FineBins = 10000;
+
+    DistanceInspectionStats() = default;
+    DistanceInspectionStats& operator+=(const DistanceInspectionStats& rhs)
     {
         this->m_numv += rhs.m_numv;
         this->m_sumsq += rhs.m_sumsq;
+        this->m_min = std::min(this->m_min, rhs.m_min);
+        this->m_max = std::max(this->m_max, rhs.m_max);
+        this->m_outOfTolerance += rhs.m_outOfTolerance;
+        if (this->m_histogram.empty()) {
+            this->m_histogram = rhs.m_histogram;
+        }
+        else if (!rhs.m_histogram.empty()) {
+            for (std::size_t i = 0; i < FineBins; i++) {
+                this->m_histogram[i] += rhs.m_histogram[i];
+            }
+        }
+        this->m_indices.insert(this->m_indices.end(), rhs.m_indices.begin(), rhs.m_indices.end());
+        this->m_values.insert(this->m_values.end(), rhs.m_values.begin(), rhs.m_values.end());
         return *this;
     }
-    double getRMS()
+    void add(float dist, float radius)
+    {
+        m_sumsq += dist * dist;
+        m_numv++;
+        m_min = std::min(m_min, dist);
+        m_max = std::max(m_max, dist);
+        if (m_histogram.empty()) {
+            m_histogram.resize(FineBins, 0);
+        }
+        m_histogram[bin(dist, radius)]++;
+    }
+    double getRMS() const
     {
         if (this->m_numv == 0) {
             return 0.0;
         }
         return sqrt(this->m_sumsq / (double)this->m_numv);
     }
+    std::vector<long> getHistogram(int bins) const
+    {
+        std::vector<long> coarse(std::max(bins, 1), 0);
+        for (std::size_t i = 0; i < m_histogram.size(); i++) {
+            coarse[i * coarse.size() / FineBins] += long(m_histogram[i]);
+        }
+        return coarse;
+    }
+    double getPercentile(double percent, float radius) const
+    {
+        if (m_numv == 0 || m_histogram.empty()) {
+            return 0.0;
+        }
+        auto target = (unsigned long)std::ceil(percent / 100.0 * double(m_numv));
+        unsigned long sum = 0;
+        for (std::size_t i = 0; i < FineBins; i++) {
+            sum += m_histogram[i];
+            if (sum >= std::max<unsigned long>(target, 1)) {
+                // take the center of the bin
+                return -radius + (double(i) + 0.5) * 2.0 * radius / double(FineBins);
+            }
+        }
+        return m_max;
+    }
+    static std::size_t bin(float dist, float radius)
+    {
+        double pos = (double(dist) + radius) / (2.0 * radius) * double(FineBins);
+        return std::min<std::size_t>(std::size_t(std::max(pos, 0.0)), FineBins - 1);
+    }
+
     int m_numv {0};
     double m_sumsq {0.0};
+    float m_min {FLT_MAX};
+    float m_max {-FLT_MAX};
+    int m_outOfTolerance {0};
+    std::vector<unsigned long> m_histogram;
+    std::vector<long> m_indices;
+    std::vector<float> m_values;
 };
 }  // namespace Inspection
 
+const char* Feature::StoreDistancesEnums[] = {"All", "OutOfTolerance", "Decimated", "None", nullptr};
+
 PROPERTY_SOURCE(Inspection::Feature, App::DocumentObject)
 
 Feature::Feature()
@@ -768,7 +1045,80 @@ Feature::Feature()
     ADD_PROPERTY(Thickness, (0.0));
     ADD_PROPERTY(Actual, (nullptr));
     ADD_PROPERTY(Nominals, (nullptr));
+    ADD_PROPERTY_TYPE(FastShapeDistance,
+                      (false),
+                      nullptr,
+                      App::Prop_None,
+                      "Use a tessellation to pre-select the faces of nominal shapes.\n"
+                      "This is much faster and allows multi-threading.");
+    ADD_PROPERTY_TYPE(StoreDistances,
+                      (0L),
+                      nullptr,
+                      App::Prop_None,
+                      "Defines which distances are stored:\n"
+                      "All: the distance of every point\n"
+                      "OutOfTolerance: only the distances exceeding the tolerance\n"
+                      "Decimated: only the distance of every n-th point\n"
+                      "None: only the statistics are computed");
+    StoreDistances.setEnums(StoreDistancesEnums);
+    ADD_PROPERTY_TYPE(Tolerance,
+                      (0.01),
+                      nullptr,
+                      App::Prop_None,
+                      "Points with a larger absolute distance are out of tolerance");
+    ADD_PROPERTY_TYPE(DecimationStep,
+                      (10),
+                      nullptr,
+                      App::Prop_None,
+                      "Only store every n-th distance in 'Decimated' mode");
+    ADD_PROPERTY_TYPE(HistogramBins,
+                      (20),
+                      nullptr,
+                      App::Prop_None,
+                      "Number of bins of the histogram over [-SearchRadius, SearchRadius]");
     ADD_PROPERTY(Distances, (0.0));
+    ADD_PROPERTY_TYPE(DistanceIndices,
+                      (),
+                      nullptr,
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Point indices of the stored distances if not all are stored");
+
+    ADD_PROPERTY_TYPE(RMS,
+                      (0.0),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "RMS value of the distances inside the search radius");
+    ADD_PROPERTY_TYPE(MinDistance,
+                      (0.0),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Minimum distance inside the search radius");
+    ADD_PROPERTY_TYPE(MaxDistance,
+                      (0.0),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Maximum distance inside the search radius");
+    ADD_PROPERTY_TYPE(CountInside,
+                      (0),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Number of points inside the search radius");
+    ADD_PROPERTY_TYPE(CountOutOfTolerance,
+                      (0),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Number of points out of tolerance");
+    ADD_PROPERTY_TYPE(Histogram,
+                      (),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "Histogram of the distances inside the search radius");
+    ADD_PROPERTY_TYPE(Percentiles,
+                      (),
+                      "Statistics",
+                      App::PropertyType(App::Prop_ReadOnly | App::Prop_Output),
+                      "The 5%, 25%, 50%, 75% and 95% percentiles of the distances.\n"
+                      "The accuracy is 1/5000 of the search radius.");
 }
 
 Feature::~Feature() = default;
@@ -787,6 +1137,13 @@ short Feature::mustExecute() const
     if (Nominals.isTouched()) {
         return 1;
     }
+    if (FastShapeDistance.isTouched()) {
+        return 1;
+    }
+    if (StoreDistances.isTouched() || Tolerance.isTouched() || DecimationStep.isTouched()
+        || HistogramBins.isTouched()) {
+        return 1;
+    }
     return 0;
 }
 
@@ -832,9 +1189,16 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
-            nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
+            if (FastShapeDistance.getValue()) {
+                nominal = new InspectNominalFastShape(part->Shape.getValue(),
+                                                      this->SearchRadius.getValue());
+            }
+            else {
+                useMultithreading = false;
+                nominal = new InspectNominalShape(part->Shape.getValue(),
+                                                  this->SearchRadius.getValue());
+            }
         }
 
         if (nominal) {
@@ -899,55 +1263,102 @@ App::DocumentObjectExecReturn* Feature::execute()
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
     unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index) {
-        DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
+    float radius = this->SearchRadius.getValue();
+    float tolerance = this->Tolerance.getValue();
+    long step = std::max<long>(this->DecimationStep.getValue(), 1);
+    const char* storeMode = this->StoreDistances.getValueAsString();
+    bool storeAll = strcmp(storeMode, "All") == 0;
+    bool storeOutOfTolerance = strcmp(storeMode, "OutOfTolerance") == 0;
+    bool storeDecimated = strcmp(storeMode, "Decimated") == 0;
+
+    // Only allocate the full array of distances if all of them are kept
+    std::vector<float> vals;
+    if (storeAll) {
+        vals.resize(count);
+    }
 
-        float fMinDist = FLT_MAX;
-        for (auto it : inspectNominal) {
-            float fDist = it->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist)) {
-                fMinDist = fDist;
-            }
-        }
+    // Accumulates the distances of the points in [first, last) into the given statistics
+    auto fAccumulate =
+        [&](DistanceInspectionStats& res, unsigned long first, unsigned long last) {
+            for (unsigned long index = first; index < last; index++) {
+                Base::Vector3f pnt = actual->getPoint(index);
+
+                float fMinDist = FLT_MAX;
+                for (auto it : inspectNominal) {
+                    float fDist = it->getDistance(pnt);
+                    if (fabs(fDist) < fabs(fMinDist)) {
+                        fMinDist = fDist;
+                    }
+                }
 
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = FLT_MAX;
-        }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -FLT_MAX;
-        }
-        else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
-        }
+                // Points without a nominal within the search radius have no valid distance and
+                // are left out of the statistics
+                bool valid = true;
+                if (fMinDist > radius) {
+                    fMinDist = FLT_MAX;
+                    valid = false;
+                }
+                else if (-fMinDist > radius) {
+                    fMinDist = -FLT_MAX;
+                    valid = false;
+                }
+                else {
+                    res.add(fMinDist, radius);
+                }
 
-        vals[index] = fMinDist;
-        return res;
-    };
+                bool outOfTolerance = valid && fabs(fMinDist) > tolerance;
+                if (outOfTolerance) {
+                    res.m_outOfTolerance++;
+                }
 
-    DistanceInspectionRMS res;
+                if (storeAll) {
+                    vals[index] = fMinDist;
+                }
+                else if ((storeOutOfTolerance && outOfTolerance)
+                         || (storeDecimated && index % step == 0)) {
+                    res.m_indices.push_back(long(index));
+                    res.m_values.push_back(fMinDist);
+                }
+            }
+        };
+
+    DistanceInspectionStats res;
 
     if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future =
-            QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+        // Give each thread one contiguous range so that only one fine histogram is allocated and
+        // merged per thread
+        auto numRanges = static_cast<unsigned long>(std::max(QThread::idealThreadCount(), 1));
+        unsigned long rangeSize = std::max<unsigned long>((count + numRanges - 1) / numRanges, 1);
+        std::vector<std::pair<unsigned long, unsigned long>> ranges;
+        for (unsigned long first = 0; first < count; first += rangeSize) {
+            ranges.emplace_back(first, std::min(first + rangeSize, count));
+        }
+
+        std::function<DistanceInspectionStats(const std::pair<unsigned long, unsigned long>&)>
+            fMap = [&](const std::pair<unsigned long, unsigned long>& range) {
+                DistanceInspectionStats stats;
+                fAccumulate(stats, range.first, range.second);
+                return stats;
+            };
+
+        // Perform map-reduce operation : compute distances and update the statistics. The ordered
+        // reduction keeps the indices of the stored distances sorted
+        QFuture<DistanceInspectionStats> future =
+            QtConcurrent::mappedReduced(ranges,
+                                        fMap,
+                                        &DistanceInspectionStats::operator+=,
+                                        QtConcurrent::OrderedReduce);
         // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
+        Base::FutureWatcherProgress progress("Inspecting...", ranges.size());
+        QFutureWatcher<DistanceInspectionStats> watcher;
         QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
+                         &QFutureWatcher<DistanceInspectionStats>::progressValueChanged,
                          &progress,
                          &Base::FutureWatcherProgress::progressValueChanged);
         // Keep UI responsive during computation
         QEventLoop loop;
         QObject::connect(&watcher,
-                         &QFutureWatcher<DistanceInspectionRMS>::finished,
+                         &QFutureWatcher<DistanceInspectionStats>::finished,
                          &loop,
                          &QEventLoop::quit);
         watcher.setFuture(future);
@@ -955,22 +1366,44 @@ App::DocumentObjectExecReturn* Feature::execute()
         res = future.result();
     }
     else {
-        // Single-threaded operation
+        // Single-threaded operation, processed in blocks to keep the progress bar updated
+        const unsigned long blockSize = 4096;
         std::stringstream str;
         str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
+        Base::SequencerLauncher seq(str.str().c_str(), (count + blockSize - 1) / blockSize);
 
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
+        for (unsigned long first = 0; first < count; first += blockSize) {
+            fAccumulate(res, first, std::min(first + blockSize, count));
+            seq.next();
         }
     }
 
     Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
                             this->Label.getValue(),
-                            -this->SearchRadius.getValue(),
-                            this->SearchRadius.getValue(),
+                            -radius,
+                            radius,
                             res.getRMS());
-    Distances.setValues(vals);
+
+    RMS.setValue(res.getRMS());
+    MinDistance.setValue(res.m_numv > 0 ? res.m_min : 0.0F);
+    MaxDistance.setValue(res.m_numv > 0 ? res.m_max : 0.0F);
+    CountInside.setValue(res.m_numv);
+    CountOutOfTolerance.setValue(res.m_outOfTolerance);
+    Histogram.setValues(res.getHistogram(HistogramBins.getValue()));
+    std::vector<double> percentiles;
+    for (double percent : {5.0, 25.0, 50.0, 75.0, 95.0}) {
+        percentiles.push_back(res.getPercentile(percent, radius));
+    }
+    Percentiles.setValues(percentiles);
+
+    if (storeAll) {
+        DistanceIndices.setValues(std::vector<long>());
+        Distances.setValues(vals);
+    }
+    else {
+        DistanceIndices.setValues(res.m_indices);
+        Distances.setValues(res.m_values);
+    }
 #endif
 
     delete actual;
@@ -23,6 +23,8 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -176,6 +178,30 @@ private:
     bool isSolid {false};
 };
 
+/** Computes the distance to a shape in two stages. A grid over a fine tessellation of the shape
+ * delivers the candidate faces and an approximate distance, and the exact distance is only
+ * computed for the candidate faces by projecting the point onto them.
+ * Unlike InspectNominalShape this class can be used from several threads at the same time.
+ */
+class InspectionExport InspectNominalFastShape: public InspectNominalGeometry
+{
+public:
+    InspectNominalFastShape(const TopoDS_Shape&, float offset);
+    ~InspectNominalFastShape() override;
+    float getDistance(const Base::Vector3f&) const override;
+
+private:
+    /** Computes the exact distance of \a pnt3d to the face with index \a face. \a side is set to
+     * 1 or -1 if the nearest point lies in the interior of the face and the point is above or
+     * below the face, otherwise it's set to 0.
+     */
+    bool projectOnFace(unsigned long face, const gp_Pnt& pnt3d, double& dist, int& side) const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+
 class InspectionExport PropertyDistanceList: public App::PropertyLists
 {
     TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -254,7 +280,24 @@ public:
     App::PropertyFloat Thickness;
     App::PropertyLink Actual;
     App::PropertyLinkList Nominals;
+    App::PropertyBool FastShapeDistance;
+    App::PropertyEnumeration StoreDistances;
+    App::PropertyFloat Tolerance;
+    App::PropertyInteger DecimationStep;
+    App::PropertyInteger HistogramBins;
     PropertyDistanceList Distances;
+    App::PropertyIntegerList DistanceIndices;
+    //@}
+
+    /** @name Statistics */
+    //@{
+    App::PropertyFloat RMS;
+    App::PropertyFloat MinDistance;
+    App::PropertyFloat MaxDistance;
+    App::PropertyInteger CountInside;
+    App::PropertyInteger CountOutOfTolerance;
+    App::PropertyIntegerList Histogram;
+    App::PropertyFloatList Percentiles;
     //@}
 
     /** @name Actions */
@@ -269,6 +312,9 @@ public:
     {
         return "InspectionGui::ViewProviderInspection";
     }
+
+private:
+    static const char* StoreDistancesEnums[];
 };
 
 class InspectionExport Group: public App::DocumentObjectGroup
@@ -36,6 +36,8 @@
 
 // STL
 #include <cfloat>
+#include <cmath>
+#include <limits>
 
 // Inventor
 #include <Inventor/SoPickedPoint.h>
@@ -23,6 +23,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <cmath>
+#include <limits>
+
 #include <QApplication>
 #include <QMenu>
 #include <QMessageBox>
@@ -356,6 +359,7 @@ void ViewProviderInspection::updateData(const App::Property* prop)
             if (link) {
                 updateData(link);
             }
+            updateDistances();
             setDistances();
         }
     }
@@ -394,8 +398,7 @@ void ViewProviderInspection::setDistances()
     }
 
     // distance values
-    const std::vector<float>& fValues =
-        static_cast<Inspection::PropertyDistanceList*>(pDistances)->getValues();
+    const std::vector<float>& fValues = getDistances();
     if ((int)fValues.size() != this->pcCoords->point.getNum()) {
         pcMatBinding->value = SoMaterialBinding::OVERALL;
         return;
@@ -413,6 +416,12 @@ void ViewProviderInspection::setDistances()
 
     unsigned long j = 0;
     for (std::vector<float>::const_iterator jt = fValues.begin(); jt != fValues.end(); ++jt, j++) {
+        if (std::isnan(*jt)) {
+            // no distance stored for this vertex
+            cols[j] = SbColor(0.5f, 0.5f, 0.5f);
+            tran[j] = 0.8f;
+            continue;
+        }
         App::Color col = pcColorBar->getColor(*jt);
         cols[j] = SbColor(col.r, col.g, col.b);
         if (pcColorBar->isVisible(*jt)) {
@@ -428,6 +437,39 @@ void ViewProviderInspection::setDistances()
     pcMatBinding->value = SoMaterialBinding::PER_VERTEX_INDEXED;
 }
 
+const std::vector<float>& ViewProviderInspection::getDistances() const
+{
+    return distances;
+}
+
+void ViewProviderInspection::updateDistances()
+{
+    distances.clear();
+    auto dist = dynamic_cast<Inspection::PropertyDistanceList*>(
+        pcObject->getPropertyByName("Distances"));
+    if (!dist) {
+        return;
+    }
+
+    // if only a subset of the distances is stored the point indices are given by 'DistanceIndices'
+    auto indices = dynamic_cast<App::PropertyIntegerList*>(
+        pcObject->getPropertyByName("DistanceIndices"));
+    if (!indices || indices->getSize() == 0 || indices->getSize() != dist->getSize()) {
+        distances = dist->getValues();
+        return;
+    }
+
+    int numPoints = this->pcCoords->point.getNum();
+    distances.resize(numPoints, std::numeric_limits<float>::quiet_NaN());
+    const std::vector<long>& idx = indices->getValues();
+    const std::vector<float>& val = dist->getValues();
+    for (std::size_t i = 0; i < idx.size(); i++) {
+        if (idx[i] >= 0 && idx[i] < numPoints) {
+            distances[idx[i]] = val[i];
+        }
+    }
+}
+
 QIcon ViewProviderInspection::getIcon() const
 {
     // Get the icon of the view provider to the associated feature
@@ -664,21 +706,24 @@ QString ViewProviderInspection::inspectDistance(const SoPickedPoint* pp) const
     if (detail && detail->getTypeId() == SoFaceDetail::getClassTypeId()) {
         // get the distances of the three points of the picked facet
         const SoFaceDetail* facedetail = static_cast<const SoFaceDetail*>(detail);
-        App::Property* pDistance = this->pcObject->getPropertyByName("Distances");
-        if (pDistance && pDistance->is<Inspection::PropertyDistanceList>()) {
-            Inspection::PropertyDistanceList* dist =
-                static_cast<Inspection::PropertyDistanceList*>(pDistance);
-            int index1 = facedetail->getPoint(0)->getCoordinateIndex();
-            int index2 = facedetail->getPoint(1)->getCoordinateIndex();
-            int index3 = facedetail->getPoint(2)->getCoordinateIndex();
-            float fVal1 = (*dist)[index1];
-            float fVal2 = (*dist)[index2];
-            float fVal3 = (*dist)[index3];
+        const std::vector<float>& dist = getDistances();
+        int index1 = facedetail->getPoint(0)->getCoordinateIndex();
+        int index2 = facedetail->getPoint(1)->getCoordinateIndex();
+        int index3 = facedetail->getPoint(2)->getCoordinateIndex();
+        int numValues = static_cast<int>(dist.size());
+        if (index1 >= 0 && index1 < numValues && index2 >= 0 && index2 < numValues && index3 >= 0
+            && index3 < numValues) {
+            float fVal1 = dist[index1];
+            float fVal2 = dist[index2];
+            float fVal3 = dist[index3];
 
             App::Property* pActual = this->pcObject->getPropertyByName("Actual");
             if (pActual && pActual->isDerivedFrom<App::PropertyLink>()) {
                 float fSearchRadius = this->search_radius;
-                if (fVal1 > fSearchRadius || fVal2 > fSearchRadius || fVal3 > fSearchRadius) {
+                if (std::isnan(fVal1) || std::isnan(fVal2) || std::isnan(fVal3)) {
+                    info = QObject::tr("Distance: not stored");
+                }
+                else if (fVal1 > fSearchRadius || fVal2 > fSearchRadius || fVal3 > fSearchRadius) {
                     info = QObject::tr("Distance: > %1").arg(fSearchRadius);
                 }
                 else if (fVal1 < -fSearchRadius || fVal2 < -fSearchRadius
@@ -715,12 +760,15 @@ QString ViewProviderInspection::inspectDistance(const SoPickedPoint* pp) const
 
         // get the distance of the picked point
         int index = pointdetail->getCoordinateIndex();
-        App::Property* prop = this->pcObject->getPropertyByName("Distances");
-        if (prop && prop->is<Inspection::PropertyDistanceList>()) {
-            Inspection::PropertyDistanceList* dist =
-                static_cast<Inspection::PropertyDistanceList*>(prop);
-            float fVal = (*dist)[index];
-            info = QObject::tr("Distance: %1").arg(fVal);
+        const std::vector<float>& dist = getDistances();
+        if (index >= 0 && index < static_cast<int>(dist.size())) {
+            float fVal = dist[index];
+            if (std::isnan(fVal)) {
+                info = QObject::tr("Distance: not stored");
+            }
+            else {
+                info = QObject::tr("Distance: %1").arg(fVal);
+            }
         }
     }
 
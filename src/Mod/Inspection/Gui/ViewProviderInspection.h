@@ -84,6 +84,8 @@ public:
 protected:
     void onChanged(const App::Property* prop) override;
     void setDistances();
+    /// Returns the distance of every vertex. Vertices without a stored distance are set to NaN.
+    const std::vector<float>& getDistances() const;
     QString inspectDistance(const SoPickedPoint* pp) const;
 
 private:
@@ -95,6 +97,7 @@ private:
     void setupLineIndexes(const std::vector<Data::ComplexGeoData::Line>&);
     void setupFaceIndexes(const std::vector<Data::ComplexGeoData::Facet>&);
     void deleteColorBar();
+    void updateDistances();
 
 private:
     SoMaterial* pcColorMat;
@@ -108,6 +111,8 @@ private:
 
 private:
     float search_radius {FLT_MAX};
+    /// The distance of every vertex, updated when the distances of the feature change
+    std::vector<float> distances;
     static bool addflag;
     static App::PropertyFloatConstraint::Constraints floatRange;
 };
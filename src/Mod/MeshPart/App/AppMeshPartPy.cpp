@@ -41,6 +41,7 @@
 #include <Mod/Part/App/TopoShapeWirePy.h>
 
 #include "MeshAlgos.h"
+#include "MeshProjectionPy.h"
 #include "Mesher.h"
 
 
@@ -78,6 +79,9 @@ public:
             "projectShapeOnMesh(Shape, Mesh, float) -> list of polygons\n"
             "projectShapeOnMesh(Shape, Mesh, Vector) -> list of polygons\n"
             "projectShapeOnMesh(list of polygons, Mesh, Vector) -> list of polygons\n"
+            "\n"
+            "To project many shapes onto the same mesh use a MeshProjection object,\n"
+            "which builds the search structure of the mesh only once.\n"
         );
         add_varargs_method("projectPointsOnMesh",&Module::projectPointsOnMesh,
             "Projects points onto a mesh with a given direction\n"
@@ -100,7 +104,8 @@ public:
             "                         AngularDeflection=0.5,\n"
             "                         Relative=False,"
             "                         Segments=False,\n"
-            "                         GroupColors=[])\n"
+            "                         GroupColors=[],\n"
+            "                         Parallel=True)\n"
             "    meshFromShape(Shape, MaxLength)\n"
             "    meshFromShape(Shape, MaxArea)\n"
             "    meshFromShape(Shape, LocalLength)\n"
@@ -126,6 +131,7 @@ public:
             "    AngularDeflection (optional, float)\n"
             "    Segments (optional, boolean)\n"
             "    GroupColors (optional, list of (Red, Green, Blue) tuples)\n"
+            "    Parallel (optional, boolean) - tessellate the faces in parallel\n"
             "    MaxLength (required, float)\n"
             "    MaxArea (required, float)\n"
             "    LocalLength (required, float)\n"
@@ -482,18 +488,21 @@ private:
             return Py::asObject(new Mesh::MeshPy(mesh));
         };
 
-        static const std::array<const char *, 7> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
-                                                                    "Relative", "Segments", "GroupColors", nullptr};
+        static const std::array<const char *, 8> kwds_lindeflection{"Shape", "LinearDeflection", "AngularDeflection",
+                                                                    "Relative", "Segments", "GroupColors",
+                                                                    "Parallel", nullptr};
         PyErr_Clear();
         double lindeflection=0;
         double angdeflection=0.5;
         PyObject* relative = Py_False;
         PyObject* segment = Py_False;
         PyObject* groupColors = nullptr;
-        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!O", kwds_lindeflection,
+        PyObject* parallel = Py_True;
+        if (Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dO!O!OO!", kwds_lindeflection,
                                                 &(Part::TopoShapePy::Type), &shape, &lindeflection,
                                                 &angdeflection, &(PyBool_Type), &relative,
-                                                &(PyBool_Type), &segment, &groupColors)) {
+                                                &(PyBool_Type), &segment, &groupColors,
+                                                &(PyBool_Type), &parallel)) {
             MeshPart::Mesher mesher(static_cast<Part::TopoShapePy*>(shape)->getTopoShapePtr()->getShape());
             mesher.setMethod(MeshPart::Mesher::Standard);
             mesher.setDeflection(lindeflection);
@@ -501,6 +510,7 @@ private:
             mesher.setRegular(true);
             mesher.setRelative(Base::asBoolean(relative));
             mesher.setSegments(Base::asBoolean(segment));
+            mesher.setParallel(Base::asBoolean(parallel));
             if (groupColors) {
                 Py::Sequence list(groupColors);
                 std::vector<uint32_t> colors;
@@ -644,7 +654,10 @@ private:
 
 PyObject* initModule()
 {
-    return Base::Interpreter().addModule(new Module);
+    PyObject* mod = Base::Interpreter().addModule(new Module);
+    MeshProjectionPy::init_type();
+    Base::Interpreter().addType(MeshProjectionPy::type_object(), mod, "MeshProjection");
+    return mod;
 }
 
 } // namespace MeshPart
@@ -25,6 +25,8 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <functional>
+
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
@@ -44,8 +46,14 @@
 #include <gp_Pln.hxx>
 #endif
 
+#include <QEventLoop>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
+#include <Base/FutureWatcherProgress.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
@@ -66,6 +74,46 @@ using MeshCore::MeshFacetIterator;
 using MeshCore::MeshKernel;
 using MeshCore::MeshPointIterator;
 
+namespace
+{
+// Maps the elements of a sequence concurrently, keeps their order and shows the progress
+template<typename Result, typename Input>
+std::vector<Result> mappedWithProgress(const char* text,
+                                       const std::vector<Input>& input,
+                                       std::function<Result(const Input&)> func)
+{
+    if (input.empty()) {
+        return {};
+    }
+
+    QFuture<Result> future = QtConcurrent::mapped(input, func);
+    // Setup progress bar
+    Base::FutureWatcherProgress progress(text, static_cast<unsigned int>(input.size()));
+    QFutureWatcher<Result> watcher;
+    QObject::connect(&watcher,
+                     &QFutureWatcher<Result>::progressValueChanged,
+                     &progress,
+                     &Base::FutureWatcherProgress::progressValueChanged);
+    // Keep UI responsive during computation
+    QEventLoop loop;
+    QObject::connect(&watcher, &QFutureWatcher<Result>::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(future);
+    loop.exec();
+
+    QList<Result> results = future.results();
+    return {results.begin(), results.end()};
+}
+
+std::vector<TopoDS_Edge> getEdges(const TopoDS_Shape& shape)
+{
+    std::vector<TopoDS_Edge> edges;
+    for (TopExp_Explorer xp(shape, TopAbs_EDGE); xp.More(); xp.Next()) {
+        edges.push_back(TopoDS::Edge(xp.Current()));
+    }
+    return edges;
+}
+}  // namespace
+
 CurveProjector::CurveProjector(const TopoDS_Shape& aShape, const MeshKernel& pMesh)
     : _Shape(aShape)
     , _Mesh(pMesh)
@@ -100,10 +148,21 @@ CurveProjectorShape::CurveProjectorShape(const TopoDS_Shape& aShape, const MeshK
 
 void CurveProjectorShape::Do()
 {
-    TopExp_Explorer Ex;
-    for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        projectCurve(aEdge, mvEdgeSplitPoints[aEdge]);
+    // The edges are independent of each other, so project them concurrently
+    std::vector<TopoDS_Edge> edges = getEdges(_Shape);
+    std::vector<std::vector<FaceSplitEdge>> splitEdges =
+        QtConcurrent::blockingMapped<std::vector<std::vector<FaceSplitEdge>>>(
+            edges,
+            std::function<std::vector<FaceSplitEdge>(const TopoDS_Edge&)>(
+                [this](const TopoDS_Edge& aEdge) {
+                    std::vector<FaceSplitEdge> vSplitEdges;
+                    projectCurve(aEdge, vSplitEdges);
+                    return vSplitEdges;
+                }));
+
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        std::vector<FaceSplitEdge>& vSplitEdges = mvEdgeSplitPoints[edges[i]];
+        vSplitEdges.insert(vSplitEdges.end(), splitEdges[i].begin(), splitEdges[i].end());
     }
 }
 
@@ -494,6 +553,19 @@ MeshProjection::MeshProjection(const MeshKernel& rMesh)
     : _rcMesh(rMesh)
 {}
 
+MeshProjection::~MeshProjection() = default;
+
+const MeshFacetGrid& MeshProjection::getFacetGrid() const
+{
+    std::call_once(_gridFlag, [this]() {
+        // calculate the average edge length and create a grid
+        MeshAlgorithm clAlg(_rcMesh);
+        float fAvgLen = clAlg.GetAverageEdgeLength();
+        _grid = std::make_unique<MeshFacetGrid>(_rcMesh, 5.0f * fAvgLen);
+    });
+    return *_grid;
+}
+
 void MeshProjection::discretize(const TopoDS_Edge& aEdge,
                                 std::vector<Base::Vector3f>& polyline,
                                 std::size_t minPoints) const
@@ -631,32 +703,22 @@ void MeshProjection::projectToMesh(const TopoDS_Shape& aShape,
                                    float fMaxDist,
                                    std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    const MeshFacetGrid& cGrid = getFacetGrid();
+    std::vector<TopoDS_Edge> edges = getEdges(aShape);
 
-    TopExp_Explorer Ex;
-
-    int iCnt = 0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
-    }
-
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
-
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
+    std::function<PolyLine(const TopoDS_Edge&)> fMap = [&](const TopoDS_Edge& aEdge) {
         std::vector<SplitEdge> rSplitEdges;
         projectEdgeToEdge(aEdge, fMaxDist, cGrid, rSplitEdges);
         PolyLine polyline;
         polyline.points.reserve(rSplitEdges.size());
-        for (auto it : rSplitEdges) {
+        for (const auto& it : rSplitEdges) {
             polyline.points.push_back(it.cPt);
         }
-        rPolyLines.push_back(polyline);
-        seq.next();
-    }
+        return polyline;
+    };
+
+    std::vector<PolyLine> polylines = mappedWithProgress("Project curve on mesh", edges, fMap);
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
@@ -664,10 +726,8 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                    float tolerance,
                                    std::vector<Base::Vector3f>& pointsOut) const
 {
-    // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    const MeshFacetGrid& cGrid = getFacetGrid();
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -689,20 +749,20 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
         }
     }
 
-    Base::SequencerLauncher seq("Project points on mesh", pointsIn.size());
-
-    for (auto it : pointsIn) {
+    // the first element is set to true if the point could be projected
+    using Projected = std::pair<bool, Base::Vector3f>;
+    std::function<Projected(const Base::Vector3f&)> fMap = [&](const Base::Vector3f& it) {
         Base::Vector3f result;
         MeshCore::FacetIndex index;
         if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
             MeshCore::MeshGeomFacet geomFacet = _rcMesh.GetFacet(index);
             if (tolerance > 0 && geomFacet.IntersectPlaneWithLine(it, dir, result)) {
                 if (geomFacet.IsPointOfFace(result, tolerance)) {
-                    pointsOut.push_back(result);
+                    return Projected(true, result);
                 }
             }
             else {
-                pointsOut.push_back(result);
+                return Projected(true, result);
             }
         }
         else {
@@ -717,139 +777,102 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                             });
 
             if (boundaryPnt != boundaryPoints.end()) {
-                pointsOut.push_back(*boundaryPnt);
+                return Projected(true, *boundaryPnt);
             }
-            else {
-                // go through the boundary edges and check if the point can be directly projected
-                // onto one of them
-                Base::Vector3f result1, result2;
-                for (auto jt : boundaryEdges) {
-                    jt.ClosestPointsToLine(it, dir, result1, result2);
-                    float dot = (result1 - jt._aclPoints[0]).Dot(result1 - jt._aclPoints[1]);
-                    Base::Vector3f vec = result1 - it;
-                    float angle = vec.GetAngle(dir);
-                    if (dot <= 0 && angle < 1e-6f) {
-                        pointsOut.push_back(result1);
-                        break;
-                    }
+
+            // go through the boundary edges and check if the point can be directly projected
+            // onto one of them
+            Base::Vector3f result1, result2;
+            for (auto jt : boundaryEdges) {
+                jt.ClosestPointsToLine(it, dir, result1, result2);
+                float dot = (result1 - jt._aclPoints[0]).Dot(result1 - jt._aclPoints[1]);
+                Base::Vector3f vec = result1 - it;
+                float angle = vec.GetAngle(dir);
+                if (dot <= 0 && angle < 1e-6f) {
+                    return Projected(true, result1);
                 }
             }
         }
 
-        seq.next();
+        return Projected(false, Base::Vector3f());
+    };
+
+    std::vector<Projected> projected = mappedWithProgress("Project points on mesh", pointsIn, fMap);
+    for (const auto& it : projected) {
+        if (it.first) {
+            pointsOut.push_back(it.second);
+        }
     }
 }
 
-void MeshProjection::projectParallelToMesh(const TopoDS_Shape& aShape,
-                                           const Base::Vector3f& dir,
-                                           std::vector<PolyLine>& rPolyLines) const
+MeshProjection::PolyLine MeshProjection::projectPolyLine(const std::vector<Base::Vector3f>& points,
+                                                         const Base::Vector3f& dir) const
 {
-    // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-    TopExp_Explorer Ex;
-
-    int iCnt = 0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
-    }
-
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
+    const MeshFacetGrid& cGrid = getFacetGrid();
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
+    using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
+    std::vector<HitPoint> hitPoints;
+    using HitPoints = std::pair<HitPoint, HitPoint>;
+    std::vector<HitPoints> hitPointPairs;
+    for (auto it : points) {
+        Base::Vector3f result;
+        MeshCore::FacetIndex index;
+        if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+            hitPoints.emplace_back(result, index);
 
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
+            if (hitPoints.size() > 1) {
+                HitPoint p1 = hitPoints[hitPoints.size() - 2];
+                HitPoint p2 = hitPoints[hitPoints.size() - 1];
+                hitPointPairs.emplace_back(p1, p2);
             }
         }
+    }
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
+    MeshCore::MeshProjection meshProjection(_rcMesh);
+    PolyLine polyline;
+    std::vector<Base::Vector3f> section;
+    for (auto it : hitPointPairs) {
+        section.clear();
+        if (meshProjection.projectLineOnMesh(cGrid,
+                                             it.first.first,
+                                             it.first.second,
+                                             it.second.first,
+                                             it.second.second,
+                                             dir,
+                                             section)) {
+            polyline.points.insert(polyline.points.end(), section.begin(), section.end());
         }
-        rPolyLines.push_back(polyline);
-
-        seq.next();
     }
+
+    return polyline;
 }
 
-void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
+void MeshProjection::projectParallelToMesh(const TopoDS_Shape& aShape,
                                            const Base::Vector3f& dir,
                                            std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
-
-    Base::SequencerLauncher seq("Project curve on mesh", aEdges.size());
-
-    for (const auto& it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
+    std::vector<TopoDS_Edge> edges = getEdges(aShape);
+    std::function<PolyLine(const TopoDS_Edge&)> fMap = [&](const TopoDS_Edge& aEdge) {
+        std::vector<Base::Vector3f> points;
+        discretize(aEdge, points, 5);
+        return projectPolyLine(points, dir);
+    };
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
-        }
-        rPolyLines.push_back(polyline);
+    std::vector<PolyLine> polylines = mappedWithProgress("Project curve on mesh", edges, fMap);
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
+}
 
-        seq.next();
-    }
+void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
+                                           const Base::Vector3f& dir,
+                                           std::vector<PolyLine>& rPolyLines) const
+{
+    std::function<PolyLine(const PolyLine&)> fMap = [&](const PolyLine& edge) {
+        return projectPolyLine(edge.points, dir);
+    };
+
+    std::vector<PolyLine> polylines = mappedWithProgress("Project curve on mesh", aEdges, fMap);
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
@@ -895,12 +918,10 @@ void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
     MeshPointIterator cPI(_rcMesh);
     MeshFacetIterator cFI(_rcMesh);
 
-    Base::SequencerLauncher seq("Project curve on mesh", pEdgeToFace.size());
+    // This may run in a worker thread, so no progress is reported here
     std::map<std::pair<MeshCore::PointIndex, MeshCore::PointIndex>,
              std::list<MeshCore::FacetIndex>>::iterator it;
     for (it = pEdgeToFace.begin(); it != pEdgeToFace.end(); ++it) {
-        seq.next();
-
         // edge points
         MeshCore::PointIndex uE0 = it->first.first;
         cPI.Set(uE0);
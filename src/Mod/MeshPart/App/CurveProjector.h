@@ -23,6 +23,9 @@
 #ifndef _CurveProjector_h_
 #define _CurveProjector_h_
 
+#include <memory>
+#include <mutex>
+
 #include <TopoDS_Edge.hxx>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -166,6 +169,10 @@ protected:
 
 /**
  * The MeshProjection class projects a shape onto a mesh.
+ * The facet grid of the mesh is created on first use and shared by all subsequent calls,
+ * so one instance should be used to project many curves onto the same mesh. The edges or
+ * points of a call are processed concurrently.
+ * @note The mesh must not be modified during the lifetime of the instance.
  * @author Werner Mayer
  */
 class MeshPartExport MeshProjection
@@ -188,6 +195,7 @@ public:
     };
 
     explicit MeshProjection(const MeshKernel& rMesh);
+    ~MeshProjection();
 
     /**
      * @brief findSectionParameters
@@ -252,9 +260,14 @@ protected:
                           const Edge&,
                           const Base::Vector3f& dir,
                           Base::Vector3f& res) const;
+    PolyLine projectPolyLine(const std::vector<Base::Vector3f>& points,
+                             const Base::Vector3f& dir) const;
+    const MeshCore::MeshFacetGrid& getFacetGrid() const;
 
 private:
     const MeshKernel& _rcMesh;
+    mutable std::once_flag _gridFlag;
+    mutable std::unique_ptr<MeshCore::MeshFacetGrid> _grid;
 };
 
 }  // namespace MeshPart
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
@@ -36,6 +37,8 @@
 
 #include <Eigen/SparseCholesky>
 
+#include <Base/Parallel.h>
+
 #include "MeshFlatteningLscmRelax.h"
 
 
@@ -148,65 +151,88 @@ LscmRelax::LscmRelax(
 void LscmRelax::relax(double weight)
 {
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
-    // for every triangle
-    Eigen::Matrix<double, 3, 6> B;
-    Eigen::Matrix<double, 2, 2> T;
-    Eigen::Matrix<double, 6, 6> K_m;
-    Eigen::Matrix<double, 6, 1> u_m, rhs_m;
-    Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
+    long num_vertices = this->vertices.cols();
+    long num_triangles = this->triangles.cols();
+    long dim = num_vertices * 2 + 3;
+    Eigen::VectorXd rhs(dim);
     if (this->sol.size() == 0)
-        this->sol.Zero(this->vertices.cols() * 2 + 3);
-    spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
-    Vector2 v1, v2, v3, v12, v23, v31;
-    long row_pos, col_pos;
-    double A;
+        this->sol.Zero(dim);
 
     rhs.setZero();
 
-    for (long i=0; i<this->triangles.cols(); i++)
+    // 1: element stiffness matrices and forces. The triangles are independent of each other,
+    //    so they are computed concurrently. The values are stored in the same order as the
+    //    triplets of the global stiffness matrix (see get_stiffness_triplets).
+    std::vector<double> K_values(num_triangles * 36 + num_vertices * 8);
+    std::vector<double> rhs_values(num_triangles * 6);
+    const long chunk_size = 1024;
+    long num_chunks = (num_triangles + chunk_size - 1) / chunk_size;
+    Base::runConcurrently(num_chunks, [&](std::size_t chunk)
     {
-        // 1: construct B-mat in m-system
-        v1 = this->flat_vertices.col(this->triangles(0, i));
-        v2 = this->flat_vertices.col(this->triangles(1, i));
-        v3 = this->flat_vertices.col(this->triangles(2, i));
-        v12 = v2 - v1;
-        v23 = v3 - v2;
-        v31 = v1 - v3;
-        B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
-              0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
-             -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
-        T << v12.x(), -v12.y(),
-             v12.y(), v12.x();
-        T /= v12.norm();
-        A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
-        B /= A * 2; // (2*area)
-
-        // 2: sigma due dqlg in m-system
-        u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
-
-        // 3: rhs_m = B.T * C * B * dqlg_m
-        //    K_m = B.T * C * B
-        rhs_m = B.transpose() * this->C * B * u_m * A;
-        K_m = B.transpose() * this->C * B * A;
-
-        // 5: add to rhs_g, K_g
-        for (int j=0; j < 3; j++)
+        long begin = static_cast<long>(chunk) * chunk_size;
+        long end = std::min(begin + chunk_size, num_triangles);
+        Eigen::Matrix<double, 3, 6> B;
+        Eigen::Matrix<double, 2, 2> T;
+        Eigen::Matrix<double, 6, 6> K_m;
+        Eigen::Matrix<double, 6, 1> u_m, rhs_m;
+        Vector2 v1, v2, v3, v12, v23, v31;
+        double A;
+
+        for (long i=begin; i<end; i++)
         {
-            row_pos = this->triangles(j, i);
-            rhs[row_pos * 2]     += rhs_m[j * 2];
-            rhs[row_pos * 2 + 1] += rhs_m[j * 2 +1];
-            for (int k=0; k < 3; k++)
+            // 1: construct B-mat in m-system
+            v1 = this->flat_vertices.col(this->triangles(0, i));
+            v2 = this->flat_vertices.col(this->triangles(1, i));
+            v3 = this->flat_vertices.col(this->triangles(2, i));
+            v12 = v2 - v1;
+            v23 = v3 - v2;
+            v31 = v1 - v3;
+            B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
+                  0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
+                 -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
+            T << v12.x(), -v12.y(),
+                 v12.y(), v12.x();
+            T /= v12.norm();
+            A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
+            B /= A * 2; // (2*area)
+
+            // 2: sigma due dqlg in m-system
+            u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
+
+            // 3: rhs_m = B.T * C * B * dqlg_m
+            //    K_m = B.T * C * B
+            rhs_m = B.transpose() * this->C * B * u_m * A;
+            K_m = B.transpose() * this->C * B * A;
+
+            // 4: store the element values
+            double* K_i = &K_values[i * 36];
+            for (int j=0; j < 3; j++)
             {
-                col_pos = this->triangles(k, i);
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2)));
-                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1)));
-                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1)));
-                // we don't have to fill all because the matrix is symmetric.
+                rhs_values[i * 6 + j * 2]     = rhs_m[j * 2];
+                rhs_values[i * 6 + j * 2 + 1] = rhs_m[j * 2 + 1];
+                for (int k=0; k < 3; k++)
+                {
+                    *K_i++ = K_m(j * 2,      k * 2);
+                    *K_i++ = K_m(j * 2 + 1,  k * 2);
+                    *K_i++ = K_m(j * 2 + 1,  k * 2 + 1);
+                    *K_i++ = K_m(j * 2,      k * 2 + 1);
+                    // we don't have to fill all because the matrix is symmetric.
+                }
             }
         }
+    });
+
+    // 5: add to rhs_g
+    for (long i=0; i<num_triangles; i++)
+    {
+        for (int j=0; j < 3; j++)
+        {
+            long row_pos = this->triangles(j, i);
+            rhs[row_pos * 2]     += rhs_values[i * 6 + j * 2];
+            rhs[row_pos * 2 + 1] += rhs_values[i * 6 + j * 2 + 1];
+        }
     }
+
     // FIXING SOME PINS:
     // - if there are no pins (or only one pin) selected solve the system without the nullspace solution.
     // - if there are some pins selected, delete all columns, rows that refer to this pins
@@ -251,19 +277,20 @@ void LscmRelax::relax(double weight)
     //     K_g_triplets.push_back(trip(i, i, 0.01));
 
     // lagrange multiplier
-    for (long i=0; i < this->flat_vertices.cols() ; i++)
+    double* K_lagrange = &K_values[num_triangles * 36];
+    for (long i=0; i < num_vertices; i++)
     {
         // fixing total ux
-        K_g_triplets.emplace_back(trip(i * 2, this->flat_vertices.cols() * 2, 1));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2, i * 2, 1));
+        *K_lagrange++ = 1;
+        *K_lagrange++ = 1;
         // fixing total uy
-        K_g_triplets.emplace_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 1, 1));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 1, i * 2 + 1, 1));
+        *K_lagrange++ = 1;
+        *K_lagrange++ = 1;
         // fixing ux*y-uy*x
-        K_g_triplets.emplace_back(trip(i * 2, this->flat_vertices.cols() * 2 + 2, - this->flat_vertices(1, i)));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2, - this->flat_vertices(1, i)));
-        K_g_triplets.emplace_back(trip(i * 2 + 1, this->flat_vertices.cols() * 2 + 2, this->flat_vertices(0, i)));
-        K_g_triplets.emplace_back(trip(this->flat_vertices.cols() * 2 + 2, i * 2 + 1, this->flat_vertices(0, i)));
+        *K_lagrange++ = - this->flat_vertices(1, i);
+        *K_lagrange++ = - this->flat_vertices(1, i);
+        *K_lagrange++ = this->flat_vertices(0, i);
+        *K_lagrange++ = this->flat_vertices(0, i);
     }
 
     // project out the nullspace solution:
@@ -282,17 +309,88 @@ void LscmRelax::relax(double weight)
     // rhs -= nullspace1.dot(rhs) * nullspace1;
     // rhs -= nullspace2.dot(rhs) * nullspace2;
 
-    K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
+    // 6: assemble K_g. The sparsity pattern is the same for all iterations, so it's only
+    //    computed once together with the position of every element value in K_g.
+    if (this->K_g.rows() != dim || this->K_g_index.size() != K_values.size())
+    {
+        std::vector<trip> K_g_triplets = this->get_stiffness_triplets(K_values);
+        this->K_g.resize(dim, dim);
+        this->K_g.setFromTriplets(K_g_triplets.begin(), K_g_triplets.end());
+        this->K_g.makeCompressed();
+
+        this->K_g_index.resize(K_g_triplets.size());
+        const int* outer = this->K_g.outerIndexPtr();
+        const int* inner = this->K_g.innerIndexPtr();
+        for (std::size_t t=0; t < K_g_triplets.size(); t++)
+        {
+            const int* first = inner + outer[K_g_triplets[t].col()];
+            const int* last = inner + outer[K_g_triplets[t].col() + 1];
+            this->K_g_index[t] = std::lower_bound(first, last, K_g_triplets[t].row()) - inner;
+        }
+
+        // the symbolic factorization only depends on the pattern
+        this->K_g_solver = std::make_shared<Eigen::SimplicialLDLT<spMat, Eigen::Lower>>();
+        this->K_g_solver->analyzePattern(this->K_g);
+    }
+    else
+    {
+        double* values = this->K_g.valuePtr();
+        std::fill(values, values + this->K_g.nonZeros(), 0.0);
+        for (std::size_t t=0; t < K_values.size(); t++)
+            values[this->K_g_index[t]] += K_values[t];
+    }
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
 
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    this->K_g_solver->factorize(this->K_g);
+    this->sol = this->K_g_solver->solve(-rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
 
+std::vector<trip> LscmRelax::get_stiffness_triplets(const std::vector<double>& K_values) const
+{
+    long num_vertices = this->vertices.cols();
+    long num_triangles = this->triangles.cols();
+    std::vector<trip> K_g_triplets;
+    K_g_triplets.reserve(K_values.size());
+    const double* value = K_values.data();
+
+    for (long i=0; i<num_triangles; i++)
+    {
+        for (int j=0; j < 3; j++)
+        {
+            long row_pos = this->triangles(j, i);
+            for (int k=0; k < 3; k++)
+            {
+                long col_pos = this->triangles(k, i);
+                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2,        *value++));
+                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2,        *value++));
+                K_g_triplets.emplace_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    *value++));
+                K_g_triplets.emplace_back(trip(row_pos * 2,     col_pos * 2 + 1,    *value++));
+            }
+        }
+    }
+
+    // lagrange multiplier
+    for (long i=0; i < num_vertices; i++)
+    {
+        // fixing total ux
+        K_g_triplets.emplace_back(trip(i * 2, num_vertices * 2, *value++));
+        K_g_triplets.emplace_back(trip(num_vertices * 2, i * 2, *value++));
+        // fixing total uy
+        K_g_triplets.emplace_back(trip(i * 2 + 1, num_vertices * 2 + 1, *value++));
+        K_g_triplets.emplace_back(trip(num_vertices * 2 + 1, i * 2 + 1, *value++));
+        // fixing ux*y-uy*x
+        K_g_triplets.emplace_back(trip(i * 2, num_vertices * 2 + 2, *value++));
+        K_g_triplets.emplace_back(trip(num_vertices * 2 + 2, i * 2, *value++));
+        K_g_triplets.emplace_back(trip(i * 2 + 1, num_vertices * 2 + 2, *value++));
+        K_g_triplets.emplace_back(trip(num_vertices * 2 + 2, i * 2 + 1, *value++));
+    }
+
+    return K_g_triplets;
+}
+
 
 void LscmRelax::area_relax(double weight)
 {
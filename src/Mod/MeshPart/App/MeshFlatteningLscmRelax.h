@@ -40,6 +40,8 @@
 #include <tuple>
 #include <vector>
 
+#include <Eigen/SparseCholesky>
+
 #include "MeshFlattening.h"
 
 
@@ -71,6 +73,8 @@ using Vector2 = Eigen::Vector2d;
 
 class LscmRelax{
 private:
+    using trip = Eigen::Triplet<double>;
+
     ColMat<double, 3> q_l_g;  // the position of the 3d triangles at there locale coord sys
     ColMat<double, 3> q_l_m;  // the mapped position in local coord sys
 
@@ -86,6 +90,12 @@ private:
     Eigen::Matrix<double, 3, 3> C;
     Eigen::VectorXd sol;
 
+    // the stiffness matrix of the relaxation keeps its sparsity pattern between the iterations
+    spMat K_g;
+    std::vector<Eigen::Index> K_g_index;  // position of the element values in K_g
+    std::shared_ptr<Eigen::SimplicialLDLT<spMat, Eigen::Lower>> K_g_solver;
+    std::vector<trip> get_stiffness_triplets(const std::vector<double>& K_values) const;
+
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <Standard_Failure.hxx>
+#include <TopoDS.hxx>
+#endif
+
+#include <Base/Converter.h>
+#include <Base/GeometryPyCXX.h>
+#include <Base/VectorPy.h>
+#include <Mod/Mesh/App/MeshPy.h>
+#include <Mod/Part/App/OCCError.h>
+#include <Mod/Part/App/TopoShapeEdgePy.h>
+#include <Mod/Part/App/TopoShapePy.h>
+
+#include "MeshProjectionPy.h"
+
+
+using namespace MeshPart;
+
+namespace
+{
+
+Py::List toList(const std::vector<MeshProjection::PolyLine>& polylines)
+{
+    Py::List list;
+    for (const auto& it : polylines) {
+        Py::List poly;
+        for (const auto& jt : it.points) {
+            poly.append(Py::Vector(jt));
+        }
+        list.append(poly);
+    }
+    return list;
+}
+
+template<typename Func>
+Py::Object callProjection(Func&& func)
+{
+    try {
+        return func();
+    }
+    catch (const Standard_Failure& e) {
+        throw Py::Exception(Part::PartExceptionOCCError, e.GetMessageString());
+    }
+    catch (const Base::Exception& e) {
+        throw Py::RuntimeError(e.what());
+    }
+}
+
+}  // namespace
+
+void MeshProjectionPy::init_type()
+{
+    behaviors().name("MeshProjection");
+    behaviors().doc("MeshProjection(Mesh)\n"
+                    "Projects shapes, polygons and points onto a mesh. The search structure of\n"
+                    "the mesh is built once and reused by all projections of this object, so\n"
+                    "it should be used to project many curves onto the same mesh.\n"
+                    "Later changes of the mesh are not taken into account.");
+    // you must have overwritten the virtual functions
+    behaviors().supportRepr();
+    behaviors().supportGetattr();
+    behaviors().supportSetattr();
+    behaviors().set_tp_new(PyMake);
+
+    add_varargs_method("projectShape",
+                       &MeshProjectionPy::projectShape,
+                       "projectShape(Shape, MaxDistance) -> list of polygons\n"
+                       "Projects the edges of the shape onto the mesh with a given maximum "
+                       "distance");
+    add_varargs_method("projectParallel",
+                       &MeshProjectionPy::projectParallel,
+                       "projectParallel(Shape, Vector) -> list of polygons\n"
+                       "projectParallel(list of polygons, Vector) -> list of polygons\n"
+                       "Projects the edges of the shape or the polygons onto the mesh along a "
+                       "direction");
+    add_varargs_method("projectPoints",
+                       &MeshProjectionPy::projectPoints,
+                       "projectPoints(list of points, Vector, [float]) -> list of points\n"
+                       "Projects the points onto the mesh along a direction");
+    add_varargs_method("findSectionParameters",
+                       &MeshProjectionPy::findSectionParameters,
+                       "findSectionParameters(Edge, Vector) -> list\n"
+                       "Finds the parameters of the edge where the projected point lies on an "
+                       "edge of the mesh");
+}
+
+Py::PythonType& MeshProjectionPy::behaviors()
+{
+    return Py::PythonExtension<MeshProjectionPy>::behaviors();
+}
+
+PyTypeObject* MeshProjectionPy::type_object()
+{
+    return Py::PythonExtension<MeshProjectionPy>::type_object();
+}
+
+bool MeshProjectionPy::check(PyObject* py)
+{
+    return Py::PythonExtension<MeshProjectionPy>::check(py);
+}
+
+PyObject* MeshProjectionPy::PyMake(PyTypeObject* /*unused*/, PyObject* args, PyObject* /*unused*/)
+{
+    PyObject* m {};
+    if (!PyArg_ParseTuple(args, "O!", &Mesh::MeshPy::Type, &m)) {
+        return nullptr;
+    }
+
+    const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
+    MeshCore::MeshKernel kernel(mesh->getKernel());
+    kernel.Transform(mesh->getTransform());
+    return new MeshProjectionPy(kernel);
+}
+
+MeshProjectionPy::MeshProjectionPy(const MeshCore::MeshKernel& kernel)
+    : _kernel(kernel)
+    , _projection(_kernel)
+{}
+
+MeshProjectionPy::~MeshProjectionPy() = default;
+
+Py::Object MeshProjectionPy::repr()
+{
+    std::string s = "MeshPart.MeshProjection";
+    return Py::String(s);  // NOLINT
+}
+
+Py::Object MeshProjectionPy::projectShape(const Py::Tuple& args)
+{
+    PyObject* s {};
+    double maxDist {};
+    if (!PyArg_ParseTuple(args.ptr(), "O!d", &Part::TopoShapePy::Type, &s, &maxDist)) {
+        throw Py::Exception();
+    }
+
+    return callProjection([&]() {
+        TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
+        std::vector<MeshProjection::PolyLine> polylines;
+        _projection.projectToMesh(shape, static_cast<float>(maxDist), polylines);
+        return toList(polylines);
+    });
+}
+
+Py::Object MeshProjectionPy::projectParallel(const Py::Tuple& args)
+{
+    PyObject* s {};
+    PyObject* v {};
+    if (PyArg_ParseTuple(args.ptr(),
+                         "O!O!",
+                         &Part::TopoShapePy::Type,
+                         &s,
+                         &Base::VectorPy::Type,
+                         &v)) {
+        return callProjection([&]() {
+            TopoDS_Shape shape =
+                static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
+            Base::Vector3f dir =
+                Base::convertTo<Base::Vector3f>(*static_cast<Base::VectorPy*>(v)->getVectorPtr());
+            std::vector<MeshProjection::PolyLine> polylines;
+            _projection.projectParallelToMesh(shape, dir, polylines);
+            return toList(polylines);
+        });
+    }
+
+    PyErr_Clear();
+    PyObject* seq {};
+    if (PyArg_ParseTuple(args.ptr(), "OO!", &seq, &Base::VectorPy::Type, &v)) {
+        std::vector<MeshProjection::PolyLine> polylinesIn;
+        Py::Sequence edges(seq);
+        polylinesIn.reserve(edges.size());
+
+        for (Py::Sequence::iterator it = edges.begin(); it != edges.end(); ++it) {
+            Py::Sequence edge(*it);
+            MeshProjection::PolyLine poly;
+            poly.points.reserve(edge.size());
+            for (Py::Sequence::iterator jt = edge.begin(); jt != edge.end(); ++jt) {
+                Py::Vector pnt(*jt);
+                poly.points.push_back(Base::convertTo<Base::Vector3f>(pnt.toVector()));
+            }
+            polylinesIn.push_back(poly);
+        }
+
+        return callProjection([&]() {
+            Base::Vector3f dir =
+                Base::convertTo<Base::Vector3f>(*static_cast<Base::VectorPy*>(v)->getVectorPtr());
+            std::vector<MeshProjection::PolyLine> polylines;
+            _projection.projectParallelToMesh(polylinesIn, dir, polylines);
+            return toList(polylines);
+        });
+    }
+
+    throw Py::TypeError("Expected arguments are:\n"
+                        "Shape, Vector or\n"
+                        "Polygons, Vector\n");
+}
+
+Py::Object MeshProjectionPy::projectPoints(const Py::Tuple& args)
+{
+    PyObject* seq {};
+    PyObject* v {};
+    double precision = -1;
+    if (!PyArg_ParseTuple(args.ptr(), "OO!|d", &seq, &Base::VectorPy::Type, &v, &precision)) {
+        throw Py::Exception();
+    }
+
+    std::vector<Base::Vector3f> pointsIn;
+    Py::Sequence points(seq);
+    pointsIn.reserve(points.size());
+    for (Py::Sequence::iterator it = points.begin(); it != points.end(); ++it) {
+        Py::Vector pnt(*it);
+        pointsIn.push_back(Base::convertTo<Base::Vector3f>(pnt.toVector()));
+    }
+
+    return callProjection([&]() {
+        Base::Vector3f dir =
+            Base::convertTo<Base::Vector3f>(*static_cast<Base::VectorPy*>(v)->getVectorPtr());
+        std::vector<Base::Vector3f> pointsOut;
+        _projection.projectOnMesh(pointsIn, dir, static_cast<float>(precision), pointsOut);
+
+        Py::List list;
+        for (const auto& it : pointsOut) {
+            list.append(Py::Vector(it));
+        }
+        return list;
+    });
+}
+
+Py::Object MeshProjectionPy::findSectionParameters(const Py::Tuple& args)
+{
+    PyObject* e {};
+    PyObject* v {};
+    if (!PyArg_ParseTuple(args.ptr(),
+                          "O!O!",
+                          &Part::TopoShapeEdgePy::Type,
+                          &e,
+                          &Base::VectorPy::Type,
+                          &v)) {
+        throw Py::Exception();
+    }
+
+    return callProjection([&]() {
+        TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(e)->getTopoShapePtr()->getShape();
+        Base::Vector3f dir =
+            Base::convertTo<Base::Vector3f>(*static_cast<Base::VectorPy*>(v)->getVectorPtr());
+        std::set<double> parameters;
+        _projection.findSectionParameters(TopoDS::Edge(shape), dir, parameters);
+
+        Py::List list;
+        for (double it : parameters) {
+            list.append(Py::Float(it));
+        }
+        return list;
+    });
+}
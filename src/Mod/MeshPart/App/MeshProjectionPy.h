@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef MESHPART_MESHPROJECTIONPY_H
+#define MESHPART_MESHPROJECTIONPY_H
+
+#include <CXX/Extensions.hxx>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+#include "CurveProjector.h"
+
+
+namespace MeshPart
+{
+
+/**
+ * The MeshProjectionPy class exposes a MeshProjection to Python. It keeps a copy of the
+ * transformed mesh, so the facet grid is only built once and reused by all projections
+ * made with the same object.
+ */
+// NOLINTNEXTLINE
+class MeshProjectionPy: public Py::PythonExtension<MeshProjectionPy>
+{
+public:
+    static void init_type();  // announce properties and methods
+    static Py::PythonType& behaviors();
+    static PyTypeObject* type_object();
+    static bool check(PyObject* py);
+
+    explicit MeshProjectionPy(const MeshCore::MeshKernel& kernel);
+    ~MeshProjectionPy() override;
+
+    Py::Object repr() override;
+
+    Py::Object projectShape(const Py::Tuple&);
+    Py::Object projectParallel(const Py::Tuple&);
+    Py::Object projectPoints(const Py::Tuple&);
+    Py::Object findSectionParameters(const Py::Tuple&);
+
+private:
+    static PyObject* PyMake(struct _typeobject*, PyObject*, PyObject*);
+
+private:
+    MeshCore::MeshKernel _kernel;
+    MeshProjection _projection;
+};
+
+}  // namespace MeshPart
+
+#endif  // MESHPART_MESHPROJECTIONPY_H
@@ -27,9 +27,14 @@
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
 #include <Standard_Version.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/Console.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
@@ -135,6 +140,28 @@ public:
         , colors(c)
     {}
 
+    /// Converts the triangulations of all faces of \a shape into domains. The order of the
+    /// domains matches the order of the faces so that segments and colors can be mapped.
+    static std::vector<Part::TopoShape::Domain> getDomains(const TopoDS_Shape& shape,
+                                                           bool parallel)
+    {
+        std::vector<Part::TopoShape::Domain> domains;
+        if (!parallel) {
+            Part::TopoShape(shape).getDomains(domains);
+            return domains;
+        }
+
+        std::vector<TopoDS_Face> faces;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            faces.push_back(TopoDS::Face(xp.Current()));
+        }
+
+        // The triangulation of a face only is read, so the faces can be processed
+        // independently. The mapped result keeps the order of the input sequence.
+        return QtConcurrent::blockingMapped<std::vector<Part::TopoShape::Domain>>(faces,
+                                                                                  &toDomain);
+    }
+
     Mesh::MeshObject* create(const std::vector<Part::TopoShape::Domain>& domains) const
     {
         std::vector<Base::Vector3d> points;
@@ -210,6 +237,16 @@ public:
         }
         return meshdata;
     }
+
+private:
+    static Part::TopoShape::Domain toDomain(const TopoDS_Face& face)
+    {
+        // TopoShape::getDomains() adds exactly one domain for a face, which is empty if the
+        // face cannot be meshed
+        std::vector<Part::TopoShape::Domain> domains;
+        Part::TopoShape(face).getDomains(domains);
+        return domains.empty() ? Part::TopoShape::Domain() : std::move(domains.front());
+    }
 };
 }  // namespace MeshPart
 
@@ -225,11 +262,12 @@ Mesh::MeshObject* Mesher::createStandard() const
 {
     if (!shape.IsNull()) {
         BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection, parallel);
     }
 
-    std::vector<Part::TopoShape::Domain> domains;
-    Part::TopoShape(shape).getDomains(domains);
+    // The vertices of the domains are welded in face order, so the resulting mesh doesn't
+    // depend on the order in which the faces have been processed
+    std::vector<Part::TopoShape::Domain> domains = BrepMesh::getDomains(shape, parallel);
 
     BrepMesh brepmesh(this->segments, this->colors);
     return brepmesh.create(domains);
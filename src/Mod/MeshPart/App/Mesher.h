@@ -147,6 +147,15 @@ public:
     {
         colors = c;
     }
+    /// Tessellate and convert the faces in parallel (Standard method only)
+    void setParallel(bool s)
+    {
+        parallel = s;
+    }
+    bool isParallel() const
+    {
+        return parallel;
+    }
     //@}
 
 #if defined(HAVE_NETGEN)
@@ -229,6 +238,7 @@ private:
     bool relative {false};
     bool regular {false};
     bool segments {false};
+    bool parallel {true};
 #if defined(HAVE_NETGEN)
     int fineness {5};
     double growthRate {0};
@@ -114,6 +114,7 @@
 #include "PointPy.h"
 #include "PrimitiveFeature.h"
 #include "RectangularTrimmedSurfacePy.h"
+#include "ShapePool.h"
 #include "SpherePy.h"
 #include "SurfaceOfExtrusionPy.h"
 #include "SurfaceOfRevolutionPy.h"
@@ -572,6 +573,7 @@ PyMOD_INIT_FUNC(Part)
 
     OCAF::ImportExportSettings::initialize();
     Part::MeasureClient::initialize();
+    Part::ShapePool::initialize();
 
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
         .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
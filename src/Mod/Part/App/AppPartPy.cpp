@@ -87,6 +87,7 @@
 #include "BSplineSurfacePy.h"
 #include "edgecluster.h"
 #include "FaceMaker.h"
+#include "GeometryCheck.h"
 #include "GeometryCurvePy.h"
 #include "GeometryPy.h"
 #include "ImportIges.h"
@@ -607,6 +608,25 @@ public:
         add_varargs_method("clearShapeCache",&Module::clearShapeCache,
             "clearShapeCache() -- Clears internal shape cache"
         );
+        add_varargs_method("getShapeCacheStats",&Module::getShapeCacheStats,
+            "getShapeCacheStats(reset=False) -> dict\n"
+            "Returns the number of hits, misses and entries of the internal shape cache\n"
+            "that is used by getShape(). If reset is True the counters are reset afterwards."
+        );
+        add_keyword_method("checkGeometry",&Module::checkGeometry,
+            "checkGeometry(shapes,runBopCheck=False,parallel=True,callback=None) -> list\n"
+            "Check the geometry of a shape or a list of shapes\n\n"
+            "The shapes are split at their compounds and the parts are checked in several threads.\n"
+            "For each part a dict with the keys 'Index' (index of the input shape), 'Part' (index\n"
+            "of the part), 'Shape', 'Valid' and 'Issues' is created. 'Issues' is a list of tuples\n"
+            "(sub-shape, message, check) where check is either 'BRepCheck' or 'BOPCheck'.\n\n"
+            "* runBopCheck: also run the BOP check on the input shapes whose parts have no\n"
+            "               BRepCheck errors. The dict of the BOP check of a shape follows the\n"
+            "               dicts of its parts and its 'Part' is -1.\n"
+            "* parallel: check the parts in several threads\n"
+            "* callback: called with the dict of a part as soon as it is checked. If it returns\n"
+            "            False the check is cancelled."
+        );
         add_keyword_method("getShape",&Module::getShape,
             "getShape(obj,subname=None,mat=None,needSubElement=False,transform=True,retType=0):\n"
             "Obtain the TopoShape of a given object with SubName reference\n\n"
@@ -2334,6 +2354,89 @@ private:
         return Py::Object();
     }
 
+    Py::Object getShapeCacheStats(const Py::Tuple &args) {
+        PyObject *reset = Py_False;
+        if (!PyArg_ParseTuple(args.ptr(), "|O!", &PyBool_Type, &reset))
+            throw Py::Exception();
+        auto stats = Part::Feature::getShapeCacheStats();
+        if (Base::asBoolean(reset))
+            Part::Feature::resetShapeCacheStats();
+        Py::Dict dict;
+        dict.setItem("Hits", Py::Long(static_cast<unsigned long>(stats.hits)));
+        dict.setItem("Misses", Py::Long(static_cast<unsigned long>(stats.misses)));
+        dict.setItem("Entries", Py::Long(static_cast<unsigned long>(stats.entries)));
+        return dict;
+    }
+
+    Py::Object checkGeometry(const Py::Tuple& args, const Py::Dict &kwds)
+    {
+        PyObject *pcObj;
+        PyObject *runBopCheck = Py_False;
+        PyObject *parallel = Py_True;
+        PyObject *callback = Py_None;
+        static const std::array<const char *, 5> kwd_list{"shapes", "runBopCheck", "parallel",
+                                                          "callback", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O|O!O!O", kwd_list,
+                                                 &pcObj,
+                                                 &PyBool_Type, &runBopCheck,
+                                                 &PyBool_Type, &parallel,
+                                                 &callback)) {
+            throw Py::Exception();
+        }
+
+        if (callback != Py_None && !PyCallable_Check(callback)) {
+            throw Py::TypeError("callback must be callable");
+        }
+
+        class PyGeometryCheck : public GeometryCheck
+        {
+        public:
+            explicit PyGeometryCheck(PyObject* callback) : callback(callback) {}
+            Py::List results;
+
+        protected:
+            void onResult(const Result& result) override
+            {
+                Py::List issues;
+                for (const auto& it : result.issues()) {
+                    issues.append(Py::TupleN(shape2pyshape(it.shape),
+                                             Py::String(it.message),
+                                             Py::String(it.bopCheck ? "BOPCheck" : "BRepCheck")));
+                }
+
+                Py::Dict dict;
+                dict.setItem("Index", Py::Long(static_cast<long>(result.owner)));
+                dict.setItem("Part", Py::Long(result.bopCheck ? -1L : static_cast<long>(result.index)));
+                dict.setItem("Shape", shape2pyshape(result.shape));
+                dict.setItem("Valid", Py::Boolean(result.isValid()));
+                dict.setItem("Issues", issues);
+                results.append(dict);
+
+                if (callback != Py_None) {
+                    Py::Callable func(callback);
+                    Py::Object ret = func.apply(Py::TupleN(dict));
+                    if (ret.ptr() == Py_False) {
+                        cancel();
+                    }
+                }
+            }
+
+        private:
+            PyObject* callback;
+        };
+
+        PyGeometryCheck check(callback);
+        GeometryCheck::Options options;
+        options.runBopCheck = Base::asBoolean(runBopCheck);
+        options.parallel = Base::asBoolean(parallel);
+        check.setOptions(options);
+        for (const auto& shape : getPyShapes(pcObj)) {
+            check.addShape(shape.getShape());
+        }
+        check.perform();
+        return check.results;
+    }
+
     Py::Object splitSubname(const Py::Tuple& args) {
         const char *subname;
         if (!PyArg_ParseTuple(args.ptr(), "s",&subname))
@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <numeric>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRepBndLib.hxx>
+# include <Precision.hxx>
+# include <TColStd_ListOfInteger.hxx>
+# include <TopExp.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <Base/Exception.h>
+#include <Base/Parallel.h>
+
+#include "ClusteredFuse.h"
+#include "FCBRepAlgoAPI_Fuse.h"
+#include "FuzzyHelper.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+int findRoot(std::vector<int>& parents, int index)
+{
+    while (parents[index] != index) {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+// Groups the shapes of the sorted indices whose boxes overlap directly or through other boxes
+std::vector<std::vector<int>> findClusters(const std::vector<Bnd_Box>& boxes,
+                                           const std::vector<int>& group)
+{
+    int count = static_cast<int>(group.size());
+
+    // Sweep along the x axis and only test the boxes whose x ranges overlap
+    std::vector<int> order;
+    for (int i = 0; i < count; i++) {
+        if (!boxes[group[i]].IsVoid()) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&boxes, &group](int a, int b) {
+        return boxes[group[a]].CornerMin().X() < boxes[group[b]].CornerMin().X();
+    });
+
+    std::vector<int> parents(group.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (std::size_t i = 0; i < order.size(); i++) {
+        const Bnd_Box& box = boxes[group[order[i]]];
+        double xmax = box.CornerMax().X();
+        for (std::size_t j = i + 1; j < order.size(); j++) {
+            const Bnd_Box& other = boxes[group[order[j]]];
+            if (other.CornerMin().X() > xmax) {
+                break;
+            }
+            if (!box.IsOut(other)) {
+                int a = findRoot(parents, order[i]);
+                int b = findRoot(parents, order[j]);
+                if (a != b) {
+                    parents[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+    }
+
+    // The root of a cluster is its smallest index, so the clusters are created in order
+    std::vector<std::vector<int>> clusters;
+    std::vector<int> clusterOfRoot(group.size(), -1);
+    for (int i = 0; i < count; i++) {
+        int root = findRoot(parents, i);
+        if (clusterOfRoot[root] < 0) {
+            clusterOfRoot[root] = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[clusterOfRoot[root]].push_back(group[i]);
+    }
+    return clusters;
+}
+
+// Splits the group at the median of the box centers along the longest side of its bounding box
+std::vector<std::vector<int>> splitGroup(const std::vector<Bnd_Box>& boxes,
+                                         const std::vector<int>& group)
+{
+    Bnd_Box bounds;
+    for (int i : group) {
+        bounds.Add(boxes[i]);
+    }
+    gp_XYZ size = bounds.CornerMax().XYZ() - bounds.CornerMin().XYZ();
+    int axis = 1;
+    if (size.Y() > size.Coord(axis)) {
+        axis = 2;
+    }
+    if (size.Z() > size.Coord(axis)) {
+        axis = 3;
+    }
+
+    auto center = [&boxes, axis](int i) {
+        return boxes[i].CornerMin().Coord(axis) + boxes[i].CornerMax().Coord(axis);
+    };
+    std::vector<int> order(group);
+    std::stable_sort(order.begin(), order.end(), [&center](int a, int b) {
+        return center(a) < center(b);
+    });
+
+    auto half = order.begin() + static_cast<std::ptrdiff_t>(order.size() / 2);
+    std::vector<std::vector<int>> parts;
+    parts.emplace_back(order.begin(), half);
+    parts.emplace_back(half, order.end());
+    for (auto& part : parts) {
+        std::sort(part.begin(), part.end());
+    }
+    return parts;
+}
+
+// Like the result of a boolean operation the compound doesn't contain nested compounds
+void addToCompound(const BRep_Builder& builder, TopoDS_Compound& comp, const TopoDS_Shape& shape)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        builder.Add(comp, shape);
+        return;
+    }
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        addToCompound(builder, comp, it.Value());
+    }
+}
+
+// Adds the shapes to the result of the operation if they aren't deleted, or their
+// modifications otherwise
+void addModified(FCBRepAlgoAPI_Fuse& mk,
+                 const TopTools_ListOfShape& shapes,
+                 TopTools_MapOfShape& found,
+                 TopTools_ListOfShape& result)
+{
+    for (TopTools_ListOfShape::Iterator it(shapes); it.More(); it.Next()) {
+        const TopoDS_Shape& shape = it.Value();
+        const TopTools_ListOfShape& modified = mk.Modified(shape);
+        if (modified.IsEmpty()) {
+            if (!mk.IsDeleted(shape) && found.Add(shape)) {
+                result.Append(shape);
+            }
+            continue;
+        }
+        for (TopTools_ListOfShape::Iterator jt(modified); jt.More(); jt.Next()) {
+            if (found.Add(jt.Value())) {
+                result.Append(jt.Value());
+            }
+        }
+    }
+}
+
+}  // namespace
+
+ClusteredFuse::ClusteredFuse(const std::vector<TopoDS_Shape>& shapes, double fuzzyValue)
+    : shapes(shapes)
+    , boxes(shapes.size())
+    , inputNodes(shapes.size(), -1)
+    , fuzzyValue(fuzzyValue)
+{
+    int threshold = getThreshold();
+    maxArguments = threshold > 0 ? static_cast<std::size_t>(threshold) : shapes.size();
+    maxArguments = std::max<std::size_t>(maxArguments, 2);
+
+    Bnd_Box bounds;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (!shapes[i].IsNull()) {
+            BRepBndLib::Add(shapes[i], boxes[i]);
+        }
+        bounds.Add(boxes[i]);
+    }
+    if (fuzzyValue < 0.0) {
+        this->fuzzyValue = bounds.IsVoid() ? 0.0
+            : FuzzyHelper::getBooleanFuzzy() * std::sqrt(bounds.SquareExtent())
+                * Precision::Confusion();
+    }
+    for (auto& box : boxes) {
+        if (!box.IsVoid()) {
+            box.Enlarge(this->fuzzyValue + Precision::Confusion());
+        }
+    }
+
+    if (!shapes.empty()) {
+        std::vector<int> group(shapes.size());
+        std::iota(group.begin(), group.end(), 0);
+        addNode(group, 0);
+    }
+
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shapes[i], subShapes);
+        for (int j = 1; j <= subShapes.Extent(); j++) {
+            if (!inputMap.IsBound(subShapes(j))) {
+                inputMap.Bind(subShapes(j), TColStd_ListOfInteger());
+            }
+            inputMap.ChangeFind(subShapes(j)).Append(static_cast<int>(i));
+        }
+    }
+}
+
+ClusteredFuse::~ClusteredFuse() = default;
+
+std::vector<std::vector<int>> ClusteredFuse::makeClusters(const std::vector<TopoDS_Shape>& shapes,
+                                                          double gap)
+{
+    std::vector<Bnd_Box> boxes(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (!shapes[i].IsNull()) {
+            BRepBndLib::Add(shapes[i], boxes[i]);
+        }
+        if (!boxes[i].IsVoid()) {
+            boxes[i].Enlarge(gap);
+        }
+    }
+
+    std::vector<int> group(shapes.size());
+    std::iota(group.begin(), group.end(), 0);
+    return findClusters(boxes, group);
+}
+
+int ClusteredFuse::getThreshold()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+    return static_cast<int>(hGrp->GetInt("ClusteredFuseThreshold", 0));
+}
+
+int ClusteredFuse::addNode(const std::vector<int>& group, int depth)
+{
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    nodes[index].depth = depth;
+    if (group.size() == 1) {
+        nodes[index].input = group.front();
+        inputNodes[group.front()] = index;
+        return index;
+    }
+
+    std::vector<std::vector<int>> parts = findClusters(boxes, group);
+    if (parts.size() == 1) {
+        nodes[index].fuse = true;
+        if (group.size() > maxArguments) {
+            parts = splitGroup(boxes, group);
+        }
+        else {
+            parts.clear();
+            for (int i : group) {
+                parts.push_back({i});
+            }
+        }
+    }
+
+    // The vector may grow while adding the children, so the node is only accessed by index
+    for (const auto& part : parts) {
+        int child = addNode(part, depth + 1);
+        nodes[child].parent = index;
+        nodes[index].children.push_back(child);
+    }
+    return index;
+}
+
+void ClusteredFuse::buildNode(int index, bool runParallel)
+{
+    Node& node = nodes[index];
+    node.maker.reset();
+    node.result.Nullify();
+    if (node.children.empty()) {
+        node.result = shapes[node.input];
+        return;
+    }
+
+    if (!node.fuse) {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (int child : node.children) {
+            addToCompound(builder, comp, nodes[child].result);
+        }
+        node.result = comp;
+        return;
+    }
+
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    for (int child : node.children) {
+        if (shapeArguments.IsEmpty()) {
+            shapeArguments.Append(nodes[child].result);
+        }
+        else {
+            shapeTools.Append(nodes[child].result);
+        }
+    }
+    auto mk = std::make_unique<FCBRepAlgoAPI_Fuse>();
+    mk->SetArguments(shapeArguments);
+    mk->SetTools(shapeTools);
+    if (fuzzyValue > 0.0) {
+        mk->SetFuzzyValue(fuzzyValue);
+    }
+    mk->SetRunParallel(runParallel);
+    mk->Build();
+    if (mk->IsDone()) {
+        node.result = mk->Shape();
+    }
+    node.maker = std::move(mk);
+}
+
+void ClusteredFuse::build()
+{
+    result.Nullify();
+    int maxDepth = 0;
+    for (const auto& node : nodes) {
+        maxDepth = std::max(maxDepth, node.depth);
+    }
+
+    // The children of a node are one level deeper, so the levels are built bottom-up with all
+    // nodes of a level at the same time. The boolean operations don't modify their arguments,
+    // so this works even if the shapes share geometry.
+    for (int depth = maxDepth; depth >= 0; depth--) {
+        std::vector<int> level;
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            if (nodes[i].depth == depth) {
+                level.push_back(static_cast<int>(i));
+            }
+        }
+
+        // A single operation can use the threads itself
+        bool runParallel = level.size() == 1;
+        Base::runConcurrently(level.size(), [&](std::size_t i) {
+            buildNode(level[i], runParallel);
+        });
+
+        for (int i : level) {
+            if (!nodes[i].children.empty() && nodes[i].result.IsNull()) {
+                FC_THROWM(Base::CADKernelError,
+                          "Fusion of " << nodes[i].children.size() << " shapes failed");
+            }
+        }
+    }
+
+    if (!nodes.empty()) {
+        result = nodes.front().result;
+    }
+}
+
+const TopoDS_Shape& ClusteredFuse::shape() const
+{
+    return result;
+}
+
+void ClusteredFuse::trace(const TopoDS_Shape& s,
+                          int input,
+                          TopTools_ListOfShape& modified,
+                          TopTools_ListOfShape& generated) const
+{
+    modified.Append(s);
+    for (int index = nodes[inputNodes[input]].parent; index >= 0; index = nodes[index].parent) {
+        FCBRepAlgoAPI_Fuse* mk = nodes[index].maker.get();
+        if (!mk) {
+            continue;
+        }
+
+        // Shapes generated by a lower operation may be modified by this one
+        TopTools_ListOfShape nextModified, nextGenerated;
+        TopTools_MapOfShape found;
+        addModified(*mk, modified, found, nextModified);
+        found.Clear();
+        addModified(*mk, generated, found, nextGenerated);
+        for (TopTools_ListOfShape::Iterator it(modified); it.More(); it.Next()) {
+            for (TopTools_ListOfShape::Iterator jt(mk->Generated(it.Value())); jt.More();
+                 jt.Next()) {
+                if (found.Add(jt.Value())) {
+                    nextGenerated.Append(jt.Value());
+                }
+            }
+        }
+        modified = nextModified;
+        generated = nextGenerated;
+    }
+}
+
+const std::vector<TopoDS_Shape>& ClusteredFuse::modified(const TopoDS_Shape& s) const
+{
+    _res.clear();
+    const TColStd_ListOfInteger* inputs = inputMap.Seek(s);
+    if (!inputs || result.IsNull()) {
+        return _res;
+    }
+
+    TopTools_MapOfShape found;
+    for (TColStd_ListOfInteger::Iterator it(*inputs); it.More(); it.Next()) {
+        TopTools_ListOfShape modified, generated;
+        trace(s, it.Value(), modified, generated);
+        for (TopTools_ListOfShape::Iterator jt(modified); jt.More(); jt.Next()) {
+            if (found.Add(jt.Value())) {
+                _res.push_back(jt.Value());
+            }
+        }
+    }
+
+    // An unchanged shape is reported as not modified
+    if (_res.size() == 1 && _res.front().IsSame(s)) {
+        _res.clear();
+    }
+    return _res;
+}
+
+const std::vector<TopoDS_Shape>& ClusteredFuse::generated(const TopoDS_Shape& s) const
+{
+    _res.clear();
+    const TColStd_ListOfInteger* inputs = inputMap.Seek(s);
+    if (!inputs || result.IsNull()) {
+        return _res;
+    }
+
+    TopTools_MapOfShape found;
+    for (TColStd_ListOfInteger::Iterator it(*inputs); it.More(); it.Next()) {
+        TopTools_ListOfShape modified, generated;
+        trace(s, it.Value(), modified, generated);
+        for (TopTools_ListOfShape::Iterator jt(generated); jt.More(); jt.Next()) {
+            if (found.Add(jt.Value())) {
+                _res.push_back(jt.Value());
+            }
+        }
+    }
+    return _res;
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef PART_CLUSTEREDFUSE_H
+#define PART_CLUSTEREDFUSE_H
+
+#include <memory>
+#include <vector>
+
+#include <Bnd_Box.hxx>
+#include <TopTools_DataMapOfShapeListOfInteger.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+#include "TopoShape.h"
+
+
+class FCBRepAlgoAPI_Fuse;
+
+namespace Part
+{
+
+/** The ClusteredFuse class fuses many shapes at once.
+ * Instead of passing all shapes to a single boolean operation the shapes are fused bottom-up
+ * in a tree of operations:
+ * \li Shapes are grouped into clusters of shapes whose bounding boxes overlap directly or
+ * through other shapes of the cluster. Shapes of different clusters can't touch, so the results
+ * of the clusters are only combined into a compound.
+ * \li A cluster with more shapes than getThreshold() is split in two halves along the longest
+ * side of its bounding box. The halves are fused separately, which may split them into
+ * clusters again, and then their results are fused.
+ * \li Any other cluster is fused in a single operation.
+ *
+ * All operations on the same level of the tree run concurrently. A cluster that is fused in
+ * a single operation gets the same element names as if all shapes were fused at once.
+ *
+ * The class is a TopoShape::Mapper that maps the sub-shapes of the input shapes to the final
+ * shape, so the element map can be built from the input shapes as for a single operation.
+ */
+class PartExport ClusteredFuse: public TopoShape::Mapper
+{
+public:
+    /** \a fuzzyValue is passed to the boolean operations. If it's negative, the value is
+     * computed from the bounding box of all shapes as FCBRepAlgoAPI_BooleanOperation does.
+     */
+    ClusteredFuse(const std::vector<TopoDS_Shape>& shapes, double fuzzyValue);
+    ~ClusteredFuse() override;
+
+    /** Returns the indices of the shapes grouped into clusters. Two shapes are in the same
+     * cluster if their bounding boxes, enlarged by \a gap, overlap directly or through other
+     * shapes. The indices of a cluster are sorted and the clusters are sorted by their
+     * first index.
+     */
+    static std::vector<std::vector<int>> makeClusters(const std::vector<TopoDS_Shape>& shapes,
+                                                      double gap);
+
+    /** The minimum number of shapes for which TopoShape::makeElementBoolean() and MultiFuse
+     * fuse in clusters, and the maximum number of shapes passed to a single operation of a
+     * ClusteredFuse. It's the parameter ClusteredFuseThreshold of Mod/Part/Boolean. The
+     * default is zero, which disables the clustering, because a bottom-up fuse can name the
+     * elements differently than a single operation.
+     */
+    static int getThreshold();
+
+    /** Fuses the shapes.
+     * Raises Base::CADKernelError if one of the operations fails.
+     */
+    void build();
+    const TopoDS_Shape& shape() const;
+
+    const std::vector<TopoDS_Shape>& modified(const TopoDS_Shape& s) const override;
+    const std::vector<TopoDS_Shape>& generated(const TopoDS_Shape& s) const override;
+
+private:
+    int addNode(const std::vector<int>& group, int depth);
+    void buildNode(int index, bool runParallel);
+    void trace(const TopoDS_Shape& s,
+               int input,
+               TopTools_ListOfShape& modified,
+               TopTools_ListOfShape& generated) const;
+
+private:
+    /** A node of the tree of operations. A node without children is an input shape, a
+     * node without a maker combines the results of its children into a compound.
+     */
+    struct Node
+    {
+        int input {-1};
+        int parent {-1};
+        int depth {0};
+        std::vector<int> children;
+        bool fuse {false};
+        std::unique_ptr<FCBRepAlgoAPI_Fuse> maker;
+        TopoDS_Shape result;
+    };
+    std::vector<TopoDS_Shape> shapes;
+    std::vector<Bnd_Box> boxes;
+    std::vector<Node> nodes;
+    std::vector<int> inputNodes;
+    TopoDS_Shape result;
+    double fuzzyValue;
+    std::size_t maxArguments;
+    /// The input shapes that contain a sub-shape
+    TopTools_DataMapOfShapeListOfInteger inputMap;
+};
+
+}  // namespace Part
+
+#endif  // PART_CLUSTEREDFUSE_H
@@ -23,7 +23,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <algorithm>
+# include <memory>
+# include <thread>
+# include <Bnd_Box.hxx>
 # include <BRepAdaptor_Surface.hxx>
+# include <BRepBndLib.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
@@ -43,12 +47,46 @@
 # include <TopoDS_Wire.hxx>
 #endif
 
+#include <Base/Parallel.h>
+
 #include "CrossSection.h"
 #include "TopoShapeOpCode.h"
 
 
 using namespace Part;
 
+namespace {
+
+Bnd_Box getBoundingBox(const TopoDS_Shape& shape)
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    box.Enlarge(Precision::Confusion());
+    return box;
+}
+
+// Checks whether the plane may intersect the box
+bool mayIntersect(const gp_Pln& plane, const Bnd_Box& box)
+{
+    if (box.IsVoid()) {
+        return true;
+    }
+
+    double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    double pa {}, pb {}, pc {}, pd {};
+    plane.Coefficients(pa, pb, pc, pd);
+
+    // the extreme values of the plane equation are taken at the corners of the box
+    double minValue = pd + std::min(pa * xMin, pa * xMax) + std::min(pb * yMin, pb * yMax)
+        + std::min(pc * zMin, pc * zMax);
+    double maxValue = pd + std::max(pa * xMin, pa * xMax) + std::max(pb * yMin, pb * yMax)
+        + std::max(pc * zMin, pc * zMax);
+    return minValue <= Precision::Confusion() && maxValue >= -Precision::Confusion();
+}
+
+}  // namespace
+
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
 {
@@ -56,21 +94,44 @@ CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
 
 std::list<TopoDS_Wire> CrossSection::slice(double d) const
 {
-    std::list<TopoDS_Wire> wires;
+    return slices(std::vector<double>{d}).front();
+}
+
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
+    std::vector<std::pair<TopoDS_Shape, Bnd_Box>> solids;
+    std::vector<std::pair<TopoDS_Shape, Bnd_Box>> nonSolids;
     TopExp_Explorer xp;
     for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceSolid(d, xp.Current(), wires);
+        solids.emplace_back(xp.Current(), getBoundingBox(xp.Current()));
     }
     for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+        nonSolids.emplace_back(xp.Current(), getBoundingBox(xp.Current()));
     }
     for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+        nonSolids.emplace_back(xp.Current(), getBoundingBox(xp.Current()));
     }
 
-    return removeDuplicates(wires);
+    std::vector<std::list<TopoDS_Wire>> result(d.size());
+    Base::runConcurrently(d.size(), [&](std::size_t index) {
+        gp_Pln slicePlane(a, b, c, -d[index]);
+        std::list<TopoDS_Wire> wires;
+        for (const auto& it : solids) {
+            if (mayIntersect(slicePlane, it.second)) {
+                sliceSolid(d[index], it.first, wires);
+            }
+        }
+        for (const auto& it : nonSolids) {
+            if (mayIntersect(slicePlane, it.second)) {
+                sliceNonSolid(d[index], it.first, wires);
+            }
+        }
+        result[index] = removeDuplicates(wires);
+    });
+
+    return result;
 }
 
 std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wire>& wires) const
@@ -225,26 +286,75 @@ TopoCrossSection::TopoCrossSection(double a, double b, double c, const TopoShape
 {
 }
 
+// The boolean operation of one slice plane with one sub-shape
+struct TopoCrossSection::Operation
+{
+    int idx {0};
+    double d {0.0};
+    const TopoShape* shape {nullptr};
+    bool solid {false};
+    std::unique_ptr<BRepBuilderAPI_MakeFace> mkFace;
+    std::unique_ptr<BRepPrimAPI_MakeHalfSpace> mkSolid;
+    std::unique_ptr<FCBRepAlgoAPI_Cut> mkCut;
+    std::unique_ptr<FCBRepAlgoAPI_Section> mkSection;
+};
+
 void TopoCrossSection::slice(int idx, double d, std::vector<TopoShape>& wires) const
+{
+    slices(idx, std::vector<double>{d}, wires);
+}
+
+void TopoCrossSection::slices(int idx,
+                              const std::vector<double>& distances,
+                              std::vector<TopoShape>& wires) const
 {
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
-    bool found = false;
-    for (auto& s : shape.getSubTopoShapes(TopAbs_SOLID)) {
-        sliceSolid(idx, d, s, wires);
-        found = true;
-    }
-    if (!found) {
-        for (auto& s : shape.getSubTopoShapes(TopAbs_SHELL)) {
-            sliceNonSolid(idx, d, s, wires);
-            found = true;
+    bool solid = true;
+    std::vector<TopoShape> subShapes = shape.getSubTopoShapes(TopAbs_SOLID);
+    if (subShapes.empty()) {
+        solid = false;
+        subShapes = shape.getSubTopoShapes(TopAbs_SHELL);
+        if (subShapes.empty()) {
+            subShapes = shape.getSubTopoShapes(TopAbs_FACE);
         }
-        if (!found) {
-            for (auto& s : shape.getSubTopoShapes(TopAbs_FACE)) {
-                sliceNonSolid(idx, d, s, wires);
+    }
+
+    std::vector<Bnd_Box> boxes;
+    boxes.reserve(subShapes.size());
+    for (const auto& it : subShapes) {
+        boxes.push_back(getBoundingBox(it.getShape()));
+    }
+
+    std::vector<Operation> operations;
+    for (std::size_t i = 0; i < distances.size(); i++) {
+        gp_Pln slicePlane(a, b, c, -distances[i]);
+        for (std::size_t j = 0; j < subShapes.size(); j++) {
+            if (mayIntersect(slicePlane, boxes[j])) {
+                operations.emplace_back();
+                auto& operation = operations.back();
+                operation.idx = idx + static_cast<int>(i);
+                operation.d = distances[i];
+                operation.shape = &subShapes[j];
+                operation.solid = solid;
             }
         }
     }
+
+    // The boolean operations only use OCC and run concurrently. The element maps are created
+    // in this thread because the string hasher isn't thread-safe. The operations are done in
+    // batches to limit the number of boolean results kept in memory.
+    const std::size_t batchSize = 4 * std::max(1U, std::thread::hardware_concurrency());
+    for (std::size_t batch = 0; batch < operations.size(); batch += batchSize) {
+        const std::size_t count = std::min(batchSize, operations.size() - batch);
+        Base::runConcurrently(count, [this, &operations, batch](std::size_t index) {
+            prepare(operations[batch + index]);
+        });
+        for (std::size_t index = batch; index < batch + count; index++) {
+            makeWires(operations[index], wires);
+            operations[index] = Operation();
+        }
+    }
 }
 
 TopoShape TopoCrossSection::slice(int idx, double d) const
@@ -257,46 +367,53 @@ TopoShape TopoCrossSection::slice(int idx, double d) const
         TopoShape::SingleShapeCompoundCreationPolicy::returnShape);
 }
 
-void TopoCrossSection::sliceNonSolid(int idx,
-                                     double d,
-                                     const TopoShape& shape,
-                                     std::vector<TopoShape>& wires) const
+void TopoCrossSection::prepare(Operation& operation) const
 {
-    FCBRepAlgoAPI_Section cs(shape.getShape(), gp_Pln(a, b, c, -d));
-    if (cs.IsDone()) {
-        std::string prefix(op);
-        prefix += Data::indexSuffix(idx);
-        auto res = TopoShape()
-                       .makeElementShape(cs, shape, prefix.c_str())
-                       .makeElementWires()
-                       .getSubTopoShapes(TopAbs_WIRE);
-        wires.insert(wires.end(), res.begin(), res.end());
+    if (!operation.solid) {
+        operation.mkSection = std::make_unique<FCBRepAlgoAPI_Section>(operation.shape->getShape(),
+                                                                      gp_Pln(a, b, c, -operation.d));
+        return;
     }
-}
 
-void TopoCrossSection::sliceSolid(int idx,
-                                  double d,
-                                  const TopoShape& shape,
-                                  std::vector<TopoShape>& wires) const
-{
-    gp_Pln slicePlane(a, b, c, -d);
-    BRepBuilderAPI_MakeFace mkFace(slicePlane);
-    TopoShape face(idx);
-    face.setShape(mkFace.Face());
+    gp_Pln slicePlane(a, b, c, -operation.d);
+    operation.mkFace = std::make_unique<BRepBuilderAPI_MakeFace>(slicePlane);
 
     // Make sure to choose a point that does not lie on the plane (fixes #0001228)
     gp_Vec tempVector(a, b, c);
     tempVector.Normalize();  // just in case.
-    tempVector *= (d + 1.0);
+    tempVector *= (operation.d + 1.0);
     gp_Pnt refPoint(0.0, 0.0, 0.0);
     refPoint.Translate(tempVector);
 
-    BRepPrimAPI_MakeHalfSpace mkSolid(TopoDS::Face(face.getShape()), refPoint);
-    TopoShape solid(idx);
+    operation.mkSolid = std::make_unique<BRepPrimAPI_MakeHalfSpace>(operation.mkFace->Face(), refPoint);
+    operation.mkCut = std::make_unique<FCBRepAlgoAPI_Cut>(operation.shape->getShape(),
+                                                          operation.mkSolid->Solid());
+}
+
+void TopoCrossSection::makeWires(Operation& operation, std::vector<TopoShape>& wires) const
+{
+    const TopoShape& shape = *operation.shape;
     std::string prefix(op);
-    prefix += Data::indexSuffix(idx);
-    solid.makeElementShape(mkSolid, face, prefix.c_str());
-    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
+    prefix += Data::indexSuffix(operation.idx);
+
+    if (!operation.solid) {
+        FCBRepAlgoAPI_Section& cs = *operation.mkSection;
+        if (cs.IsDone()) {
+            auto res = TopoShape()
+                           .makeElementShape(cs, shape, prefix.c_str())
+                           .makeElementWires()
+                           .getSubTopoShapes(TopAbs_WIRE);
+            wires.insert(wires.end(), res.begin(), res.end());
+        }
+        return;
+    }
+
+    gp_Pln slicePlane(a, b, c, -operation.d);
+    TopoShape face(operation.idx);
+    face.setShape(operation.mkFace->Face());
+    TopoShape solid(operation.idx);
+    solid.makeElementShape(*operation.mkSolid, face, prefix.c_str());
+    FCBRepAlgoAPI_Cut& mkCut = *operation.mkCut;
 
     if (mkCut.IsDone()) {
         TopoShape res(shape.Tag, shape.Hasher);
@@ -24,6 +24,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <Mod/Part/PartGlobal.h>
 #include "TopoShape.h"
@@ -39,6 +40,10 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Computes the slices at all distances \a d concurrently. Parts of the shape whose
+     * bounding box isn't touched by a slice plane are skipped. The result has the order of \a d.
+     */
+    std::vector<std::list<TopoDS_Wire>> slices(const std::vector<double>& d) const;
 
 private:
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
@@ -59,10 +64,17 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /** Computes the slices at all \a distances and adds their wires to \a wires in the order
+     * of \a distances. The slice at distances[i] uses the index \a idx + i.
+     * The boolean operations run concurrently, the element maps are created afterwards in the
+     * calling thread.
+     */
+    void slices(int idx, const std::vector<double>& distances, std::vector<TopoShape>& wires) const;
 
 private:
-    void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
-    void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    struct Operation;
+    void prepare(Operation& operation) const;
+    void makeWires(Operation& operation, std::vector<TopoShape>& wires) const;
 
 private:
     double a, b, c;
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <Mod/Part/App/FCBRepAlgoAPI_Fuse.h>
 # include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
@@ -30,6 +31,7 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 #endif
 
+#include "ClusteredFuse.h"
 #include "FeaturePartFuse.h"
 #include "TopoShape.h"
 #include "modelRefine.h"
@@ -77,11 +79,15 @@ MultiFuse::MultiFuse()
     ADD_PROPERTY_TYPE(Refine,(0),"Boolean",(App::PropertyType)(App::Prop_None),"Refine shape (clean up redundant edges) after this boolean operation");
 
     this->Refine.setValue(getRefineModelParameter());
+
+    ADD_PROPERTY_TYPE(CompoundDisjoint,(false),"Boolean",(App::PropertyType)(App::Prop_None),
+        "Fuse groups of shapes that don't overlap separately and combine them into a compound,\n"
+        "even if the ClusteredFuseThreshold parameter is not set or there are fewer shapes");
 }
 
 short MultiFuse::mustExecute() const
 {
-    if (Shapes.isTouched())
+    if (Shapes.isTouched() || CompoundDisjoint.isTouched())
         return 1;
     return 0;
 }
@@ -115,35 +121,53 @@ App::DocumentObjectExecReturn *MultiFuse::execute()
     if (shapes.size() >= 2) {
         try {
             std::vector<ShapeHistory> history;
-            FCBRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments, shapeTools;
-            const TopoShape& shape = shapes.front();
-            if (shape.isNull()) {
-                throw Base::RuntimeError("Input shape is null");
-            }
-            shapeArguments.Append(shape.getShape());
-
-            for (auto it2 = shapes.begin() + 1; it2 != shapes.end(); ++it2) {
-                if (it2->isNull()) {
+            std::vector<TopoDS_Shape> args;
+            for (const auto& it2 : shapes) {
+                if (it2.isNull()) {
                     throw Base::RuntimeError("Input shape is null");
                 }
-                shapeTools.Append(it2->getShape());
+                args.push_back(it2.getShape());
             }
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.setAutoFuzzy();
-            mkFuse.Build();
-
-            if (!mkFuse.IsDone()) {
-                throw Base::RuntimeError("MultiFusion failed");
+            // With many shapes fuse the groups of shapes that don't overlap separately
+            std::unique_ptr<ClusteredFuse> mkClusters;
+            int threshold = ClusteredFuse::getThreshold();
+            if (CompoundDisjoint.getValue()
+                || (threshold > 0 && args.size() >= static_cast<std::size_t>(threshold))) {
+                mkClusters = std::make_unique<ClusteredFuse>(args, -1.0);
             }
 
             TopoShape res(0);
-            res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
-            for (const auto& it2 : shapes) {
-                history.push_back(
-                    buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+            if (mkClusters) {
+                mkClusters->build();
+                res = res.makeShapeWithElementMap(mkClusters->shape(), *mkClusters, shapes, OpCodes::Fuse);
+                for (const auto& it2 : shapes) {
+                    history.push_back(
+                        buildHistory(*mkClusters, TopAbs_FACE, res.getShape(), it2.getShape()));
+                }
+            }
+            else {
+                FCBRepAlgoAPI_Fuse mkFuse;
+                TopTools_ListOfShape shapeArguments, shapeTools;
+                shapeArguments.Append(args.front());
+                for (auto it2 = args.begin() + 1; it2 != args.end(); ++it2) {
+                    shapeTools.Append(*it2);
+                }
+
+                mkFuse.SetArguments(shapeArguments);
+                mkFuse.SetTools(shapeTools);
+                mkFuse.setAutoFuzzy();
+                mkFuse.Build();
+
+                if (!mkFuse.IsDone()) {
+                    throw Base::RuntimeError("MultiFusion failed");
+                }
+
+                res = res.makeShapeWithElementMap(mkFuse.Shape(), MapperMaker(mkFuse), shapes, OpCodes::Fuse);
+                for (const auto& it2 : shapes) {
+                    history.push_back(
+                        buildHistory(mkFuse, TopAbs_FACE, res.getShape(), it2.getShape()));
+                }
             }
             if (res.isNull()) {
                 throw Base::RuntimeError("Resulting shape is null");
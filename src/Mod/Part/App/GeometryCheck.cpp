@@ -0,0 +1,501 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <chrono>
+# include <condition_variable>
+# include <future>
+# include <mutex>
+# include <set>
+# include <thread>
+# include <BOPAlgo_ArgumentAnalyzer.hxx>
+# include <BOPAlgo_ListOfCheckResult.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepCheck_Analyzer.hxx>
+# include <BRepCheck_ListIteratorOfListOfStatus.hxx>
+# include <BRepCheck_Result.hxx>
+# include <Message_ProgressIndicator.hxx>
+# include <Standard_Failure.hxx>
+# include <Standard_Version.hxx>
+# include <TopExp.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <TopTools_DataMapOfShapeShape.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListIteratorOfListOfShape.hxx>
+#endif
+
+#include "GeometryCheck.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+#if OCC_VERSION_HEX >= 0x070600
+// Aborts BOPAlgo_ArgumentAnalyzer when the check is cancelled
+class CancelIndicator: public Message_ProgressIndicator
+{
+public:
+    explicit CancelIndicator(const std::atomic<bool>& flag)
+        : flag(flag)
+    {}
+    Standard_Boolean UserBreak() override
+    {
+        return flag ? Standard_True : Standard_False;
+    }
+    void Show(const Message_ProgressScope& /*scope*/, const Standard_Boolean /*force*/) override
+    {}
+
+private:
+    const std::atomic<bool>& flag;
+};
+#endif
+
+}  // namespace
+
+bool GeometryCheck::Result::isValid() const
+{
+    if (bopCheck) {
+        return bopFaults.empty();
+    }
+    return analyzer && analyzer->IsValid();
+}
+
+std::vector<GeometryCheck::Issue> GeometryCheck::Result::issues() const
+{
+    std::vector<Issue> list;
+    if (bopCheck) {
+        for (const auto& it : bopFaults) {
+            list.push_back({it.shape, bopStatusToString(it.status), true});
+        }
+        return list;
+    }
+
+    if (!analyzer) {
+        if (!shape.IsNull()) {
+            list.push_back({shape, statusToString(BRepCheck_CheckFail), false});
+        }
+        return list;
+    }
+
+    if (!analyzer->IsValid()) {
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shape, subShapes);
+        for (int i = 1; i <= subShapes.Extent(); ++i) {
+            const TopoDS_Shape& sub = subShapes(i);
+            const Handle(BRepCheck_Result)& res = analyzer->Result(sub);
+            if (res.IsNull()) {
+                continue;
+            }
+
+            // a sub-shape can have the same error in several contexts
+            std::set<BRepCheck_Status> reported;
+            for (res->InitContextIterator(); res->MoreShapeInContext(); res->NextShapeInContext()) {
+                BRepCheck_ListIteratorOfListOfStatus it(res->StatusOnShape());
+                for (; it.More(); it.Next()) {
+                    if (it.Value() != BRepCheck_NoError && reported.insert(it.Value()).second) {
+                        list.push_back({sub, statusToString(it.Value()), false});
+                    }
+                }
+            }
+        }
+    }
+
+    return list;
+}
+
+// ----------------------------------------------------------------------------
+
+GeometryCheck::GeometryCheck() = default;
+
+GeometryCheck::~GeometryCheck() = default;
+
+std::size_t GeometryCheck::addShape(const TopoDS_Shape& shape)
+{
+    std::size_t owner = shapes.size();
+    shapes.push_back(shape);
+    if (!shape.IsNull()) {
+        addParts(owner, shape);
+    }
+    return owner;
+}
+
+std::size_t GeometryCheck::countResults() const
+{
+    std::size_t count = parts.size();
+    if (options.runBopCheck) {
+        for (std::size_t i = 0; i < parts.size(); i++) {
+            if (i + 1 == parts.size() || parts[i + 1].owner != parts[i].owner) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void GeometryCheck::addParts(std::size_t owner, const TopoDS_Shape& shape)
+{
+    if (shape.ShapeType() == TopAbs_COMPOUND) {
+        for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+            addParts(owner, it.Value());
+        }
+        return;
+    }
+
+    Result result;
+    result.owner = owner;
+    result.index = parts.size();
+    result.shape = shape;
+    parts.push_back(result);
+}
+
+void GeometryCheck::cancel()
+{
+    cancelled = true;
+}
+
+bool GeometryCheck::isCancelled() const
+{
+    return cancelled;
+}
+
+void GeometryCheck::onResult(const Result& /*result*/)
+{
+}
+
+void GeometryCheck::onWait()
+{
+}
+
+void GeometryCheck::check(Result& result, bool single) const
+{
+    try {
+        if (result.bopCheck) {
+            bopCheck(result, single);
+            return;
+        }
+
+        // If there is only one part let OCC distribute the sub-shapes over the threads
+#if OCC_VERSION_HEX >= 0x070600
+        result.analyzer = std::make_shared<BRepCheck_Analyzer>(result.shape,
+                                                               Standard_True,
+                                                               single && options.parallel);
+#else
+        (void)single;
+        result.analyzer = std::make_shared<BRepCheck_Analyzer>(result.shape);
+#endif
+    }
+    catch (const Standard_Failure&) {
+        result.analyzer.reset();
+        if (result.bopCheck) {
+            result.bopFaults.push_back({result.shape, BOPAlgo_CheckUnknown});
+        }
+    }
+}
+
+void GeometryCheck::bopCheck(Result& result, bool single) const
+{
+    // BOPAlgo_ArgumentAnalyzer modifies the shape, so work on a copy
+    BRepBuilderAPI_Copy copier(result.shape);
+
+    BOPAlgo_ArgumentAnalyzer BOPCheck;
+    BOPCheck.SetShape1(copier.Shape());
+    BOPCheck.ArgumentTypeMode() = options.argumentTypeMode;
+    BOPCheck.SelfInterMode() = options.selfInterMode;
+    BOPCheck.SmallEdgeMode() = options.smallEdgeMode;
+    BOPCheck.RebuildFaceMode() = options.rebuildFaceMode;
+    BOPCheck.ContinuityMode() = options.continuityMode;
+    BOPCheck.TangentMode() = options.tangentMode;
+    BOPCheck.MergeVertexMode() = options.mergeVertexMode;
+    BOPCheck.MergeEdgeMode() = options.mergeEdgeMode;
+    BOPCheck.CurveOnSurfaceMode() = options.curveOnSurfaceMode;
+    BOPCheck.SetRunParallel(single && options.parallel);
+
+#if OCC_VERSION_HEX >= 0x070600
+    Handle(CancelIndicator) indicator = new CancelIndicator(cancelled);
+    BOPCheck.Perform(indicator->Start());
+#else
+    BOPCheck.Perform();
+#endif
+
+    if (!BOPCheck.HasFaulty()) {
+        return;
+    }
+
+    // map the faulty shapes back to the sub-shapes of the checked shape
+    TopTools_DataMapOfShapeShape original;
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(result.shape, subShapes);
+    for (int i = 1; i <= subShapes.Extent(); ++i) {
+        try {
+            original.Bind(copier.ModifiedShape(subShapes(i)), subShapes(i));
+        }
+        catch (const Standard_Failure&) {
+        }
+    }
+
+    BOPAlgo_ListIteratorOfListOfCheckResult it(BOPCheck.GetCheckResult());
+    for (; it.More(); it.Next()) {
+        const BOPAlgo_CheckResult& current = it.Value();
+        TopTools_ListIteratorOfListOfShape jt(current.GetFaultyShapes1());
+        for (; jt.More(); jt.Next()) {
+            TopoDS_Shape faulty = jt.Value();
+            if (original.IsBound(faulty)) {
+                faulty = original.Find(faulty).Oriented(faulty.Orientation());
+            }
+            result.bopFaults.push_back({faulty, current.GetCheckStatus()});
+        }
+    }
+}
+
+void GeometryCheck::perform()
+{
+    cancelled = false;
+
+    // The BOP check of a shape follows its parts, so that the results stay in order
+    std::vector<Result> bopResults;
+    bopResults.reserve(options.runBopCheck ? shapes.size() : 0);
+    std::vector<Result*> checks;
+    for (std::size_t i = 0; i < parts.size(); i++) {
+        checks.push_back(&parts[i]);
+        std::size_t owner = parts[i].owner;
+        if (options.runBopCheck && (i + 1 == parts.size() || parts[i + 1].owner != owner)) {
+            Result result;
+            result.owner = owner;
+            result.index = i;
+            result.shape = shapes[owner];
+            result.bopCheck = true;
+            bopResults.push_back(result);
+            checks.push_back(&bopResults.back());
+        }
+    }
+
+    // free the memory of the analyzers as soon as a part is reported
+    auto report = [this](Result& result) {
+        onResult(result);
+        result.analyzer.reset();
+        result.bopFaults.clear();
+    };
+
+    // The parts of a shape are the checks right before its BOP check. BOPAlgo_ArgumentAnalyzer
+    // can be really slow, so it only runs if BRepCheck_Analyzer doesn't find anything.
+    std::size_t count = checks.size();
+    std::vector<char> valid(count, 0);
+    auto partsOf = [&](std::size_t index) {
+        std::size_t first = index;
+        while (first > 0 && checks[first - 1]->owner == checks[index]->owner) {
+            first--;
+        }
+        return first;
+    };
+    auto partsValid = [&](std::size_t index) {
+        auto end = valid.begin() + static_cast<std::ptrdiff_t>(index);
+        return std::find(valid.begin() + static_cast<std::ptrdiff_t>(partsOf(index)), end, 0) == end;
+    };
+
+    std::size_t numThreads = std::min<std::size_t>(count, std::max(1U, std::thread::hardware_concurrency()));
+    if (!options.parallel || numThreads < 2) {
+        for (std::size_t index = 0; index < count; index++) {
+            if (isCancelled()) {
+                break;
+            }
+            Result& result = *checks[index];
+            if (result.bopCheck && !partsValid(index)) {
+                continue;
+            }
+            check(result, true);
+            valid[index] = result.isValid() ? 1 : 0;
+            if (isCancelled()) {
+                break;
+            }
+            report(result);
+        }
+        return;
+    }
+
+    // the state of a check: 0 = pending, 1 = checked, 2 = skipped
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<char> done(count, 0);
+    std::atomic<std::size_t> next {0};
+    auto worker = [&]() {
+        try {
+            for (std::size_t index = next++; index < count && !isCancelled(); index = next++) {
+                Result& result = *checks[index];
+                char state = 1;
+                if (result.bopCheck) {
+                    // the parts were handed out before, so they are finished by other workers
+                    auto first = done.begin() + static_cast<std::ptrdiff_t>(partsOf(index));
+                    auto end = done.begin() + static_cast<std::ptrdiff_t>(index);
+                    std::unique_lock<std::mutex> lock(mutex);
+                    while (!isCancelled() && std::find(first, end, 0) != end) {
+                        cond.wait_for(lock, std::chrono::milliseconds(100));
+                    }
+                    if (!partsValid(index)) {
+                        state = 2;
+                    }
+                }
+                if (state == 1) {
+                    check(result, false);
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                valid[index] = state == 1 && result.isValid() ? 1 : 0;
+                done[index] = state;
+                cond.notify_all();
+            }
+        }
+        catch (...) {
+            cancel();
+            cond.notify_all();
+            throw;
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (std::size_t i = 0; i < numThreads; i++) {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+
+    try {
+        for (std::size_t index = 0; index < count; index++) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!done[index] && !isCancelled()) {
+                if (!cond.wait_for(lock, std::chrono::milliseconds(100), [&]() {
+                        return done[index] || isCancelled();
+                    })) {
+                    lock.unlock();
+                    onWait();
+                    lock.lock();
+                }
+            }
+            lock.unlock();
+
+            if (isCancelled()) {
+                break;
+            }
+            if (done[index] == 1) {
+                report(*checks[index]);
+            }
+        }
+    }
+    catch (...) {
+        // don't let the workers continue with the remaining parts
+        cancel();
+        throw;
+    }
+
+    for (auto& task : tasks) {
+        task.get();
+    }
+}
+
+const char* GeometryCheck::statusToString(BRepCheck_Status status)
+{
+    switch (status) {
+        case BRepCheck_NoError:
+            return "No error";
+        case BRepCheck_InvalidPointOnCurve:
+            return "Invalid point on curve";
+        case BRepCheck_InvalidPointOnCurveOnSurface:
+            return "Invalid point on curve on surface";
+        case BRepCheck_InvalidPointOnSurface:
+            return "Invalid point on surface";
+        case BRepCheck_No3DCurve:
+            return "No 3D curve";
+        case BRepCheck_Multiple3DCurve:
+            return "Multiple 3D curve";
+        case BRepCheck_Invalid3DCurve:
+            return "Invalid 3D curve";
+        case BRepCheck_NoCurveOnSurface:
+            return "No curve on surface";
+        case BRepCheck_InvalidCurveOnSurface:
+            return "Invalid curve on surface";
+        case BRepCheck_InvalidCurveOnClosedSurface:
+            return "Invalid curve on closed surface";
+        case BRepCheck_InvalidSameRangeFlag:
+            return "Invalid same-range flag";
+        case BRepCheck_InvalidSameParameterFlag:
+            return "Invalid same-parameter flag";
+        case BRepCheck_InvalidDegeneratedFlag:
+            return "Invalid degenerated flag";
+        case BRepCheck_FreeEdge:
+            return "Free edge";
+        case BRepCheck_InvalidMultiConnexity:
+            return "Invalid multi-connexity";
+        case BRepCheck_InvalidRange:
+            return "Invalid range";
+        case BRepCheck_EmptyWire:
+            return "Empty wire";
+        case BRepCheck_RedundantEdge:
+            return "Redundant edge";
+        case BRepCheck_SelfIntersectingWire:
+            return "Self-intersecting wire";
+        case BRepCheck_NoSurface:
+            return "No surface";
+        case BRepCheck_InvalidWire:
+            return "Invalid wires";
+        case BRepCheck_RedundantWire:
+            return "Redundant wires";
+        case BRepCheck_IntersectingWires:
+            return "Intersecting wires";
+        case BRepCheck_InvalidImbricationOfWires:
+            return "Invalid imbrication of wires";
+        case BRepCheck_EmptyShell:
+            return "Empty shell";
+        case BRepCheck_RedundantFace:
+            return "Redundant face";
+        case BRepCheck_UnorientableShape:
+            return "Unorientable shape";
+        case BRepCheck_NotClosed:
+            return "Not closed";
+        case BRepCheck_NotConnected:
+            return "Not connected";
+        case BRepCheck_SubshapeNotInShape:
+            return "Sub-shape not in shape";
+        case BRepCheck_BadOrientation:
+            return "Bad orientation";
+        case BRepCheck_BadOrientationOfSubshape:
+            return "Bad orientation of sub-shape";
+        case BRepCheck_InvalidToleranceValue:
+            return "Invalid tolerance value";
+        case BRepCheck_CheckFail:
+            return "Check failed";
+        default:
+            return "Undetermined error";
+    }
+}
+
+const char* GeometryCheck::bopStatusToString(BOPAlgo_CheckStatus status)
+{
+    switch (status) {
+        case BOPAlgo_CheckUnknown:
+            return "BOPAlgo CheckUnknown";
+        case BOPAlgo_BadType:
+            return "BOPAlgo BadType";
+        case BOPAlgo_SelfIntersect:
+            return "BOPAlgo SelfIntersect";
+        case BOPAlgo_TooSmallEdge:
+            return "BOPAlgo TooSmallEdge";
+        case BOPAlgo_NonRecoverableFace:
+            return "BOPAlgo NonRecoverableFace";
+        case BOPAlgo_IncompatibilityOfVertex:
+            return "BOPAlgo IncompatibilityOfVertex";
+        case BOPAlgo_IncompatibilityOfEdge:
+            return "BOPAlgo IncompatibilityOfEdge";
+        case BOPAlgo_IncompatibilityOfFace:
+            return "BOPAlgo IncompatibilityOfFace";
+        case BOPAlgo_OperationAborted:
+            return "BOPAlgo OperationAborted";
+        case BOPAlgo_GeomAbs_C0:
+            return "BOPAlgo GeomAbs_C0";
+        case BOPAlgo_InvalidCurveOnSurface:
+            return "BOPAlgo_InvalidCurveOnSurface";
+        case BOPAlgo_NotValid:
+            return "BOPAlgo NotValid";
+        default:
+            return "BOPAlgo CheckUnknown";
+    }
+}
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef PART_GEOMETRYCHECK_H
+#define PART_GEOMETRYCHECK_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <BOPAlgo_CheckStatus.hxx>
+#include <BRepCheck_Status.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+
+class BRepCheck_Analyzer;
+
+namespace Part
+{
+
+/** The GeometryCheck class checks the validity of shapes with BRepCheck_Analyzer and,
+ * optionally, BOPAlgo_ArgumentAnalyzer.
+ * The shapes are split into parts at their compounds, so that each solid, shell, face, etc. that
+ * is not part of a bigger non-compound shape is checked on its own by BRepCheck_Analyzer.
+ * BOPAlgo_ArgumentAnalyzer checks each shape as a whole after its parts, so that it also finds
+ * the intersections between the members of a compound. The checks are distributed over several
+ * threads and the results are passed to onResult() in the thread that runs perform(), in the
+ * order of the parts, as soon as they are available. A check can be cancelled at any time with
+ * cancel().
+ */
+class PartExport GeometryCheck
+{
+public:
+    struct Options
+    {
+        /// Run BOPAlgo_ArgumentAnalyzer on the shapes whose parts are valid according to BRepCheck
+        bool runBopCheck {false};
+        bool argumentTypeMode {true};
+        bool selfInterMode {true};
+        bool smallEdgeMode {true};
+        bool rebuildFaceMode {true};
+        bool continuityMode {true};
+        bool tangentMode {true};
+        bool mergeVertexMode {true};
+        bool mergeEdgeMode {true};
+        bool curveOnSurfaceMode {true};
+        /// Check the parts in several threads
+        bool parallel {true};
+    };
+
+    /// A faulty sub-shape of a part
+    struct Issue
+    {
+        TopoDS_Shape shape;
+        std::string message;
+        /// true if found by BOPAlgo_ArgumentAnalyzer, false if found by BRepCheck_Analyzer
+        bool bopCheck {false};
+    };
+
+    /// A sub-shape that is reported by BOPAlgo_ArgumentAnalyzer
+    struct BopFault
+    {
+        TopoDS_Shape shape;
+        BOPAlgo_CheckStatus status;
+    };
+
+    struct Result
+    {
+        /// The index of the shape passed to addShape()
+        std::size_t owner {0};
+        /// The index of the part, for the BOP check the index of the last part of the shape
+        std::size_t index {0};
+        /// The part, for the BOP check the whole shape passed to addShape()
+        TopoDS_Shape shape;
+        /// true for the result of BOPAlgo_ArgumentAnalyzer, false for a part checked by BRepCheck
+        bool bopCheck {false};
+        /// The analyzer of the part, null if it is not a valid shape for BRepCheck
+        std::shared_ptr<BRepCheck_Analyzer> analyzer;
+        /** The faults found by BOPAlgo_ArgumentAnalyzer. The shapes are the sub-shapes of
+         * \a shape, not of the copy that is analyzed.
+         */
+        std::vector<BopFault> bopFaults;
+
+        bool isValid() const;
+        /// Collects the faulty sub-shapes found by both checks
+        std::vector<Issue> issues() const;
+    };
+
+    GeometryCheck();
+    virtual ~GeometryCheck();
+
+    void setOptions(const Options& opts)
+    {
+        options = opts;
+    }
+    const Options& getOptions() const
+    {
+        return options;
+    }
+
+    /** Adds \a shape to the shapes to check and returns its index. Null shapes are accepted
+     * but don't contribute any parts.
+     */
+    std::size_t addShape(const TopoDS_Shape& shape);
+    /// The number of parts of all shapes added so far
+    std::size_t countParts() const
+    {
+        return parts.size();
+    }
+    /** The maximum number of results passed to onResult() by perform(), i.e. the parts and,
+     * if the BOP check is enabled, the shapes with parts
+     */
+    std::size_t countResults() const;
+
+    /** Checks all parts. The function returns when all parts are reported to onResult() or the
+     * check was cancelled.
+     */
+    void perform();
+    /// Stops the check. It's safe to call this function from any thread.
+    void cancel();
+    bool isCancelled() const;
+
+    static const char* statusToString(BRepCheck_Status status);
+    static const char* bopStatusToString(BOPAlgo_CheckStatus status);
+
+protected:
+    /** Called in the thread that runs perform() for each checked part in the order of the parts.
+     * The analyzer and the results of the BOP check are released afterwards.
+     */
+    virtual void onResult(const Result& result);
+    /** Called regularly in the thread that runs perform() while it waits for the worker
+     * threads, e.g. to process events or to call cancel().
+     */
+    virtual void onWait();
+
+private:
+    void addParts(std::size_t owner, const TopoDS_Shape& shape);
+    void check(Result& result, bool single) const;
+    void bopCheck(Result& result, bool single) const;
+
+private:
+    Options options;
+    std::vector<Result> parts;
+    std::vector<TopoDS_Shape> shapes;
+    std::atomic<bool> cancelled {false};
+};
+
+}  // namespace Part
+
+#endif  // PART_GEOMETRYCHECK_H
@@ -397,6 +397,7 @@
 #include <math_Gauss.hxx>
 #include <math_Matrix.hxx>
 #include <Message_MsgFile.hxx>
+#include <Message_ProgressIndicator.hxx>
 #include <NCollection_List.hxx>
 #include <OSD_OpenFile.hxx>
 #include <Precision.hxx>
@@ -502,6 +503,8 @@
 #include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 #include <TopTools_DataMapOfIntegerListOfShape.hxx>
 #include <TopTools_DataMapOfIntegerShape.hxx>
+#include <TopTools_DataMapOfShapeListOfInteger.hxx>
+#include <TopTools_DataMapOfShapeShape.hxx>
 #include <TopTools_HSequenceOfShape.hxx>
 #include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
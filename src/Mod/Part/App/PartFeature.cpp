@@ -23,6 +23,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <limits>
+# include <map>
+# include <mutex>
+# include <set>
 # include <sstream>
 # include <Bnd_Box.hxx>
 # include <BRepAdaptor_Curve.hxx>
@@ -882,9 +886,173 @@ void Feature::setMaterialAppearance(const App::Material& material)
     }
 }
 
-// Toponaming project March 2024:  This method should be going away when we get to the python layer.
+namespace
+{
+
+/** Caches the results of Feature::getTopoShape() by object, sub-object path and the flags that
+ * affect the result. The shape of an object may depend on any other object, even of another
+ * document, e.g. through links or groups. So a property change, recompute or deletion of an
+ * object removes the entries of the object and of all objects that link to it.
+ */
+class ShapeCache
+{
+public:
+    struct Key
+    {
+        const App::DocumentObject* obj;
+        std::string subname;
+        int flags;
+
+        bool operator<(const Key& other) const
+        {
+            if (obj != other.obj) {
+                return obj < other.obj;
+            }
+            if (flags != other.flags) {
+                return flags < other.flags;
+            }
+            return subname < other.subname;
+        }
+    };
+
+    struct Entry
+    {
+        TopoShape shape;
+        Base::Matrix4D mat;
+        App::DocumentObject* owner {nullptr};
+    };
+
+    bool getShape(const Key& key, Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        init();
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            ++misses;
+            return false;
+        }
+        ++hits;
+        entry = it->second;
+        return true;
+    }
+
+    void setShape(const Key& key, const Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache[key] = entry;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.clear();
+    }
+
+    /// Removes the entries of \a obj and of the objects that depend on it
+    void invalidate(const App::DocumentObject& obj)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cache.empty()) {
+                return;
+            }
+        }
+
+        std::set<App::DocumentObject*> objs = obj.getInListEx(true);
+        std::lock_guard<std::mutex> lock(mutex);
+        erase(&obj);
+        for (auto it : objs) {
+            erase(it);
+        }
+    }
+
+    Feature::ShapeCacheStats getStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return {hits, misses, cache.size()};
+    }
+
+    void resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        hits = 0;
+        misses = 0;
+    }
+
+private:
+    void init()
+    {
+        if (inited) {
+            return;
+        }
+        inited = true;
+        auto& app = App::GetApplication();
+        //NOLINTBEGIN
+        connChangedObject = app.signalChangedObject.connect(
+            std::bind(&ShapeCache::slotChanged, this, sp::_1, sp::_2));
+        connDeletedObject = app.signalDeletedObject.connect(
+            std::bind(&ShapeCache::slotObject, this, sp::_1));
+        connObjectRecomputed = app.signalObjectRecomputed.connect(
+            std::bind(&ShapeCache::slotObject, this, sp::_1));
+        connDeleteDocument = app.signalDeleteDocument.connect(
+            std::bind(&ShapeCache::slotDeleteDocument, this, sp::_1));
+        //NOLINTEND
+    }
+
+    // Must be called with the mutex locked
+    void erase(const App::DocumentObject* obj)
+    {
+        auto it = cache.lower_bound(Key {obj, std::string(), std::numeric_limits<int>::min()});
+        while (it != cache.end() && it->first.obj == obj) {
+            it = cache.erase(it);
+        }
+    }
+
+    void slotChanged(const App::DocumentObject& obj, const App::Property& /*prop*/)
+    {
+        invalidate(obj);
+    }
+
+    void slotObject(const App::DocumentObject& obj)
+    {
+        invalidate(obj);
+    }
+
+    // Closing a document is rare, so all entries are removed instead of looking for the
+    // objects of other documents that link to it
+    void slotDeleteDocument(const App::Document& /*doc*/)
+    {
+        clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::map<Key, Entry> cache;
+    boost::signals2::scoped_connection connChangedObject;
+    boost::signals2::scoped_connection connDeletedObject;
+    boost::signals2::scoped_connection connObjectRecomputed;
+    boost::signals2::scoped_connection connDeleteDocument;
+    std::size_t hits {0};
+    std::size_t misses {0};
+    bool inited {false};
+};
+
+ShapeCache _ShapeCache;
+
+}  // namespace
+
 void Feature::clearShapeCache() {
-//    _ShapeCache.cache.clear();
+    _ShapeCache.clear();
+}
+
+Feature::ShapeCacheStats Feature::getShapeCacheStats()
+{
+    return _ShapeCache.getStats();
+}
+
+void Feature::resetShapeCacheStats()
+{
+    _ShapeCache.resetStats();
 }
 
 static TopoShape _getTopoShape(const App::DocumentObject* obj,
@@ -1298,6 +1466,32 @@ TopoShape Feature::getTopoShape(const App::DocumentObject* obj,
         }
     }
 
+    // Results that depend on a transformation passed in are not cached
+    ShapeCache::Key key {obj,
+                         subname ? subname : "",
+                         (needSubElement ? 1 : 0) | (resolveLink ? 2 : 0) | (transform ? 4 : 0)
+                             | (noElementMap ? 8 : 0)};
+    ShapeCache::Entry entry;
+    bool useCache = !pmat || *pmat == Base::Matrix4D();
+    if (useCache) {
+        if (_ShapeCache.getShape(key, entry)) {
+            if (pmat) {
+                *pmat = entry.mat;
+            }
+            if (powner) {
+                *powner = entry.owner;
+            }
+            return entry.shape;
+        }
+        // Always collect the transformation and the owner for the cache
+        if (!pmat) {
+            pmat = &entry.mat;
+        }
+        if (!powner) {
+            powner = &entry.owner;
+        }
+    }
+
     Base::Matrix4D mat;
     auto shape = _getTopoShape(obj,
                                subname,
@@ -1344,6 +1538,12 @@ TopoShape Feature::getTopoShape(const App::DocumentObject* obj,
         }
     }
 
+    if (useCache) {
+        entry.shape = shape;
+        entry.mat = *pmat;
+        entry.owner = *powner;
+        _ShapeCache.setShape(key, entry);
+    }
     return shape;
 }
 
@@ -1637,6 +1837,44 @@ ShapeHistory Feature::buildHistory(BRepBuilderAPI_MakeShape& mkShape, TopAbs_Sha
     return history;
 }
 
+ShapeHistory Feature::buildHistory(const TopoShape::Mapper& mapper, TopAbs_ShapeEnum type,
+                                   const TopoDS_Shape& newS, const TopoDS_Shape& oldS)
+{
+    ShapeHistory history;
+    history.type = type;
+
+    TopTools_IndexedMapOfShape newM, oldM;
+    TopExp::MapShapes(newS, type, newM);
+    TopExp::MapShapes(oldS, type, oldM);
+
+    for (int i=1; i<=oldM.Extent(); i++) {
+        // The mapper returns a reference to a buffer that is reused by the next call
+        std::vector<TopoDS_Shape> changed = mapper.modified(oldM(i));
+        const auto& generated = mapper.generated(oldM(i));
+        changed.insert(changed.end(), generated.begin(), generated.end());
+
+        for (const auto& shape : changed) {
+            int j = newM.FindIndex(shape);
+            if (j > 0) {
+                history.shapeMap[i-1].push_back(j-1);
+            }
+        }
+
+        if (changed.empty()) {
+            // The object is either unchanged or deleted
+            int j = newM.FindIndex(oldM(i));
+            if (j > 0) {
+                history.shapeMap[i-1].push_back(j-1);
+            }
+            else {
+                history.shapeMap[i-1] = std::vector<int>();
+            }
+        }
+    }
+
+    return history;
+}
+
 ShapeHistory Feature::joinHistory(const ShapeHistory& oldH, const ShapeHistory& newH)
 {
     ShapeHistory join;
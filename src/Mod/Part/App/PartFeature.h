@@ -139,8 +139,21 @@ public:
             App::DocumentObject **owner=nullptr, bool resolveLink=true, bool transform=true,
             bool noElementMap=false);
 
+    /** Clears the cache of getTopoShape(). The cache is cleared automatically on any change
+     * of a document object.
+     */
     static void clearShapeCache();
 
+    /// Statistics of the cache of getTopoShape() for tuning
+    struct ShapeCacheStats
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t entries;
+    };
+    static ShapeCacheStats getShapeCacheStats();
+    static void resetShapeCacheStats();
+
     static App::DocumentObject *getShapeOwner(const App::DocumentObject *obj, const char *subname=nullptr);
 
     static bool hasShapeOwner(const App::DocumentObject *obj, const char *subname=nullptr) {
@@ -194,6 +207,9 @@ protected:
      */
     ShapeHistory buildHistory(BRepBuilderAPI_MakeShape&, TopAbs_ShapeEnum type,
         const TopoDS_Shape& newS, const TopoDS_Shape& oldS);
+    /// Build a history of changes from a shape mapper, e.g. a ClusteredFuse
+    ShapeHistory buildHistory(const TopoShape::Mapper&, TopAbs_ShapeEnum type,
+        const TopoDS_Shape& newS, const TopoDS_Shape& oldS);
     ShapeHistory joinHistory(const ShapeHistory&, const ShapeHistory&);
 private:
     struct ElementCache;
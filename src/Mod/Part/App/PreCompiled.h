@@ -46,15 +46,23 @@
 
 // STL
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fcntl.h>
 #include <fstream>
+#include <future>
 #include <list>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Qt
@@ -49,6 +49,7 @@
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "PropertyTopoShape.h"
+#include "ShapePool.h"
 #include "TopoShapePy.h"
 #include "PartFeature.h"
 
@@ -280,7 +281,15 @@ void PropertyPartShape::Save (Base::Writer &writer) const
 
     bool binary = writer.getMode("BinaryBrep");
     bool toXML = writer.isForceXML();
-    if(!toXML) {
+    ShapePool* pool = nullptr;
+    if(owner && !_Shape.isNull())
+        pool = ShapePool::getSavePool(owner->getDocument(), writer);
+    if(pool) {
+        // The shapes of the document are written together into one file, so that the
+        // geometry shared by several objects is only written once
+        writer.Stream() << " ShapePool=\"" << ShapePool::getFileName(binary)
+                        << "\" PoolIndex=\"" << pool->addShape(_Shape.getShape()) << "\"/>\n";
+    } else if(!toXML) {
         writer.Stream() << " file=\""
                         << writer.addFile(getFileName(binary?".bin":".brp").c_str(), this)
                         << "\"/>\n";
@@ -331,7 +340,15 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 
     TopoShape shape;
 
-    if (reader.hasAttribute("file")) {
+    _PoolIndex = -1;
+    if (reader.hasAttribute("ShapePool")) {
+        // The shape is taken from the pool in afterRestore()
+        _PoolIndex = static_cast<int>(reader.getAttributeAsInteger("PoolIndex", "-1"));
+        if (owner && _PoolIndex >= 0) {
+            ShapePool::getRestorePool(owner->getDocument(), reader.getAttribute("ShapePool"));
+        }
+    }
+    else if (reader.hasAttribute("file")) {
         std::string file = reader.getAttribute("file");
         if (!file.empty()) {
             // initiate a file read
@@ -406,6 +423,27 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
 
 void PropertyPartShape::afterRestore()
 {
+    if (_PoolIndex >= 0) {
+        auto owner = Base::freecad_dynamic_cast<App::DocumentObject>(getContainer());
+        const ShapePool* pool = owner ? ShapePool::findRestorePool(owner->getDocument()) : nullptr;
+        TopoDS_Shape shape;
+        if (pool) {
+            shape = pool->getShape(_PoolIndex);
+        }
+        _PoolIndex = -1;
+        if (shape.IsNull()) {
+            FC_WARN("Missing shared geometry of " << getFullName());
+            if (owner) {
+                owner->getDocument()->addRecomputeObject(owner);
+            }
+        }
+        else {
+            aboutToSetValue();
+            _Shape.setShape(shape, false);
+            hasSetValue();
+        }
+    }
+
     if (_Shape.isRestoreFailed()) {
         // this cause GeoFeature::updateElementReference() to call
         // PropertyLinkBase::updateElementReferences() with reverse = true, in
@@ -116,6 +116,8 @@ private:
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    /// The index of the shape in the ShapePool of the restored document
+    int _PoolIndex = -1;
 };
 
 struct PartExport ShapeHistory {
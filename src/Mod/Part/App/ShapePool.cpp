@@ -0,0 +1,428 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <istream>
+# include <map>
+# include <memory>
+# include <ostream>
+# include <sstream>
+# include <streambuf>
+# include <BinTools.hxx>
+# include <BinTools_ShapeSet.hxx>
+# include <BRepTools_ShapeSet.hxx>
+# include <Standard_Failure.hxx>
+# include <TopLoc_Location.hxx>
+#endif
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
+
+#include "ShapePool.h"
+
+
+using namespace Part;
+
+namespace
+{
+
+// See TopTools_FormatVersion and BinTools_FormatVersion of OCCT 7.6
+constexpr int BRepFormatVersion = 1;
+constexpr int BinaryFormatVersion = 3;
+
+// Computes a 64-bit FNV-1a hash of all bytes written to the stream
+class HashStreamBuf: public std::streambuf
+{
+public:
+    uint64_t hash() const
+    {
+        return value;
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            add(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+    std::streamsize xsputn(const char* str, std::streamsize num) override
+    {
+        for (std::streamsize i = 0; i < num; i++) {
+            add(str[i]);
+        }
+        return num;
+    }
+
+private:
+    void add(char ch)
+    {
+        value ^= static_cast<unsigned char>(ch);
+        value *= 1099511628211ULL;
+    }
+
+private:
+    uint64_t value {14695981039346656037ULL};
+};
+
+uint64_t hashGeometry(const TopoDS_Shape& shape)
+{
+    HashStreamBuf buf;
+    std::ostream str(&buf);
+    BinTools::Write(shape, str);
+    return buf.hash();
+}
+
+std::string writeGeometry(const TopoDS_Shape& shape)
+{
+    std::ostringstream str;
+    BinTools::Write(shape, str);
+    return str.str();
+}
+
+struct DocumentPools
+{
+    /// Set while the document is saved to a project file
+    bool saving {false};
+    std::unique_ptr<ShapePool> savePool;
+    /// The pool that has been added to the writer and is written with its files
+    std::unique_ptr<ShapePool> writePool;
+    std::unique_ptr<ShapePool> restorePool;
+    std::string restoreFile;
+    bool restoreFileAdded {false};
+    std::vector<boost::signals2::scoped_connection> connections;
+
+    void releaseRestorePool()
+    {
+        restorePool.reset();
+        restoreFile.clear();
+        restoreFileAdded = false;
+    }
+};
+
+class ShapePools
+{
+public:
+    static ShapePools& instance()
+    {
+        static ShapePools pools;
+        return pools;
+    }
+
+    DocumentPools* find(const App::Document* doc)
+    {
+        auto it = documents.find(doc);
+        return it != documents.end() ? &it->second : nullptr;
+    }
+
+    DocumentPools& get(App::Document* doc)
+    {
+        DocumentPools& pools = documents[doc];
+        if (pools.connections.empty()) {
+            connect(doc, pools);
+        }
+        return pools;
+    }
+
+private:
+    ShapePools()
+    {
+        //NOLINTBEGIN
+        auto& app = App::GetApplication();
+        app.signalStartSaveDocument.connect(
+            [this](const App::Document& doc, const std::string&) {
+                DocumentPools& pools = documents[&doc];
+                pools.saving = true;
+                pools.savePool.reset();
+            });
+        app.signalFinishSaveDocument.connect(
+            [this](const App::Document& doc, const std::string&) {
+                if (DocumentPools* pools = find(&doc)) {
+                    pools->saving = false;
+                    pools->savePool.reset();
+                    pools->writePool.reset();
+                }
+            });
+        app.signalStartRestoreDocument.connect([this](const App::Document& doc) {
+            if (DocumentPools* pools = find(&doc)) {
+                pools->releaseRestorePool();
+            }
+        });
+        app.signalFinishRestoreDocument.connect([this](const App::Document& doc) {
+            if (DocumentPools* pools = find(&doc)) {
+                pools->releaseRestorePool();
+            }
+        });
+        app.signalDeleteDocument.connect([this](const App::Document& doc) {
+            documents.erase(&doc);
+        });
+        //NOLINTEND
+    }
+
+    // The slots are connected in front of the others, so the file of the pool follows the
+    // files of the objects but precedes the files of the view providers
+    static void connect(App::Document* doc, DocumentPools& pools)
+    {
+        //NOLINTBEGIN
+        pools.connections.emplace_back(doc->signalSaveDocument.connect(
+            [&pools](Base::Writer& writer) {
+                addSaveFile(pools, writer);
+            },
+            boost::signals2::at_front));
+        pools.connections.emplace_back(doc->signalRestoreDocument.connect(
+            [&pools](Base::XMLReader& reader) {
+                addRestoreFile(pools, reader);
+            },
+            boost::signals2::at_front));
+        pools.connections.emplace_back(doc->signalImportObjects.connect(
+            [&pools](const std::vector<App::DocumentObject*>&, Base::XMLReader& reader) {
+                addRestoreFile(pools, reader);
+            },
+            boost::signals2::at_front));
+        pools.connections.emplace_back(doc->signalFinishImportObjects.connect(
+            [&pools](const std::vector<App::DocumentObject*>&) {
+                pools.releaseRestorePool();
+            }));
+        //NOLINTEND
+    }
+
+    static void addSaveFile(DocumentPools& pools, Base::Writer& writer)
+    {
+        pools.saving = false;
+        if (!pools.savePool) {
+            return;
+        }
+        const char* name = ShapePool::getFileName(writer.getMode("BinaryBrep"));
+        if (writer.addFile(name, pools.savePool.get()) != name) {
+            Base::Console().Error("The file name of the shared geometry is already in use\n");
+        }
+        pools.writePool = std::move(pools.savePool);
+    }
+
+    static void addRestoreFile(DocumentPools& pools, Base::XMLReader& reader)
+    {
+        if (pools.restorePool && !pools.restoreFileAdded) {
+            pools.restoreFileAdded = true;
+            reader.addFile(pools.restoreFile.c_str(), pools.restorePool.get());
+        }
+    }
+
+private:
+    std::map<const App::Document*, DocumentPools> documents;
+};
+
+}  // namespace
+
+void ShapePool::initialize()
+{
+    ShapePools::instance();
+}
+
+bool ShapePool::isEnabled()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+        ->GetBool("ShareGeometry", false);
+}
+
+const char* ShapePool::getFileName(bool binary)
+{
+    return binary ? "ShapePool.bin" : "ShapePool.brp";
+}
+
+ShapePool* ShapePool::getSavePool(App::Document* doc, const Base::Writer& writer)
+{
+    // Only the project file gets a pool. The recovery files are written by other writers and
+    // only write the files of changed objects.
+    if (!doc || writer.isForceXML() || !dynamic_cast<const Base::ZipWriter*>(&writer)
+        || !isEnabled()) {
+        return nullptr;
+    }
+    DocumentPools* found = ShapePools::instance().find(doc);
+    if (!found || !found->saving) {
+        return nullptr;
+    }
+    DocumentPools& pools = ShapePools::instance().get(doc);
+    if (!pools.savePool) {
+        pools.savePool = std::make_unique<ShapePool>();
+    }
+    return pools.savePool.get();
+}
+
+ShapePool& ShapePool::getRestorePool(App::Document* doc, const std::string& fileName)
+{
+    DocumentPools& pools = ShapePools::instance().get(doc);
+    if (!pools.restorePool) {
+        pools.restorePool = std::make_unique<ShapePool>();
+        pools.restoreFile = fileName;
+    }
+    return *pools.restorePool;
+}
+
+const ShapePool* ShapePool::findRestorePool(const App::Document* doc)
+{
+    DocumentPools* pools = ShapePools::instance().find(doc);
+    return pools ? pools->restorePool.get() : nullptr;
+}
+
+int ShapePool::addShape(const TopoDS_Shape& shape)
+{
+    if (shape.IsNull()) {
+        shapes.push_back(shape);
+        return static_cast<int>(shapes.size()) - 1;
+    }
+    // Copies of a shape are replaced by the first one, placed and oriented like the copy
+    TopoDS_Shape base = shape.Located(TopLoc_Location()).Oriented(TopAbs_FORWARD);
+    if (!bases.IsBound(base)) {
+        // Only the hashes are kept, shapes with the same hash are compared in full
+        uint64_t hash = hashGeometry(base);
+        auto range = geometries.equal_range(hash);
+        auto found = range.second;
+        if (range.first != range.second) {
+            std::string geometry = writeGeometry(base);
+            for (found = range.first; found != range.second; ++found) {
+                if (writeGeometry(found->second) == geometry) {
+                    break;
+                }
+            }
+        }
+        if (found == range.second) {
+            found = geometries.emplace(hash, base);
+        }
+        bases.Bind(base, found->second);
+    }
+    shapes.push_back(bases.Find(base).Located(shape.Location()).Oriented(shape.Orientation()));
+    return static_cast<int>(shapes.size()) - 1;
+}
+
+int ShapePool::countShapes() const
+{
+    return static_cast<int>(shapes.size());
+}
+
+TopoDS_Shape ShapePool::getShape(int index) const
+{
+    if (index < 0 || index >= countShapes()) {
+        return {};
+    }
+    return shapes[index];
+}
+
+void ShapePool::write(std::ostream& out, bool binary) const
+{
+    if (binary) {
+        // Like TopoShape::exportBinary() but with several shapes
+        BinTools_ShapeSet shapeSet;
+        shapeSet.SetFormatNb(BinaryFormatVersion);
+        std::vector<Standard_Integer> shapeIds;
+        for (const auto& shape : shapes) {
+            shapeIds.push_back(shape.IsNull() ? -1 : shapeSet.Add(shape));
+        }
+        shapeSet.Write(out);
+        BinTools::PutInteger(out, countShapes());
+        for (std::size_t i = 0; i < shapes.size(); i++) {
+            const TopoDS_Shape& shape = shapes[i];
+            if (shape.IsNull()) {
+                BinTools::PutInteger(out, -1);
+                BinTools::PutInteger(out, -1);
+                BinTools::PutInteger(out, -1);
+                continue;
+            }
+            BinTools::PutInteger(out, shapeIds[i]);
+            BinTools::PutInteger(out, shapeSet.Locations().Index(shape.Location()));
+            BinTools::PutInteger(out, static_cast<int>(shape.Orientation()));
+        }
+    }
+    else {
+        BRepTools_ShapeSet shapeSet(Standard_False);
+        shapeSet.SetFormatNb(BRepFormatVersion);
+        for (const auto& shape : shapes) {
+            shapeSet.Add(shape);
+        }
+        shapeSet.Write(out);
+        out << "\nShapePool " << countShapes() << '\n';
+        for (const auto& shape : shapes) {
+            shapeSet.Write(shape, out);
+            out << '\n';
+        }
+    }
+}
+
+void ShapePool::read(std::istream& in, bool binary)
+{
+    shapes.clear();
+    try {
+        if (binary) {
+            BinTools_ShapeSet shapeSet;
+            shapeSet.Read(in);
+            Standard_Integer count = 0;
+            BinTools::GetInteger(in, count);
+            for (Standard_Integer i = 0; i < count; i++) {
+                Standard_Integer shapeId = 0, locId = 0, orient = 0;
+                BinTools::GetInteger(in, shapeId);
+                BinTools::GetInteger(in, locId);
+                BinTools::GetInteger(in, orient);
+                TopoDS_Shape shape;
+                if (shapeId > 0 && shapeId <= shapeSet.NbShapes()) {
+                    shape = shapeSet.Shape(shapeId);
+                    shape.Location(shapeSet.Locations().Location(locId));
+                    shape.Orientation(static_cast<TopAbs_Orientation>(orient));
+                }
+                shapes.push_back(shape);
+            }
+        }
+        else {
+            BRepTools_ShapeSet shapeSet;
+            shapeSet.Read(in);
+            std::string marker;
+            int count = 0;
+            if (!(in >> marker >> count) || marker != "ShapePool") {
+                throw Base::CADKernelError("Invalid shape pool");
+            }
+            for (int i = 0; i < count; i++) {
+                TopoDS_Shape shape;
+                shapeSet.Read(shape, in);
+                shapes.push_back(shape);
+            }
+        }
+    }
+    catch (Standard_Failure& e) {
+        shapes.clear();
+        throw Base::CADKernelError(e.GetMessageString());
+    }
+}
+
+unsigned int ShapePool::getMemSize() const
+{
+    return 0;
+}
+
+void ShapePool::Save(Base::Writer& /*writer*/) const
+{}
+
+void ShapePool::Restore(Base::XMLReader& /*reader*/)
+{}
+
+void ShapePool::SaveDocFile(Base::Writer& writer) const
+{
+    write(writer.Stream(), writer.getMode("BinaryBrep"));
+}
+
+void ShapePool::RestoreDocFile(Base::Reader& reader)
+{
+    Base::FileInfo file(reader.getFileName());
+    try {
+        read(reader, file.hasExtension("bin"));
+    }
+    catch (const Base::Exception& e) {
+        e.ReportException();
+    }
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef PART_SHAPEPOOL_H
+#define PART_SHAPEPOOL_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <TopoDS_Shape.hxx>
+#include <TopTools_DataMapOfShapeShape.hxx>
+
+#include <Base/Persistence.h>
+#include <Mod/Part/PartGlobal.h>
+
+
+namespace App
+{
+class Document;
+}
+
+namespace Part
+{
+
+/** The ShapePool class collects the shapes of a document to write them into a single file.
+ * The shapes are written as one shape set, so sub-shapes and geometries that are shared by
+ * several shapes are only written once and are shared again after restoring. Identical copies
+ * of a shape that only differ in their location or orientation are written once as well.
+ *
+ * PropertyPartShape uses a pool if the parameter ShareGeometry of Mod/Part/General is set and
+ * the document is saved to a project file. The pool is a file of the document, not of one of
+ * its properties: It is added to the writer after the files of all objects and before the
+ * files of the view providers, and the same is done on restore. Therefore a pooled shape can
+ * be restored even if only some objects of the document are loaded. Other writers, like the
+ * one of the recovery files, get a separate file for each shape as before.
+ */
+class PartExport ShapePool: public Base::Persistence
+{
+public:
+    /// Connects to the signals of the application, called on loading the module
+    static void initialize();
+    /// Returns true if the parameter to share the geometry of the shapes is set
+    static bool isEnabled();
+    /// Returns the name of the file of the pool
+    static const char* getFileName(bool binary);
+
+    /** Returns the pool to save the shapes of \a doc with \a writer, or null if the shapes
+     * are to be saved separately. The pool is added to \a writer when the document emits
+     * signalSaveDocument.
+     */
+    static ShapePool* getSavePool(App::Document* doc, const Base::Writer& writer);
+    /** Returns the pool to restore the shapes of \a doc from the file \a fileName. The file is
+     * added to the reader when the document emits signalRestoreDocument or
+     * signalImportObjects. The pool is released when the restore or import has finished.
+     */
+    static ShapePool& getRestorePool(App::Document* doc, const std::string& fileName);
+    /// Returns the pool to restore the shapes of \a doc or null if there is none
+    static const ShapePool* findRestorePool(const App::Document* doc);
+
+    /// Adds a shape to the pool and returns its index
+    int addShape(const TopoDS_Shape& shape);
+    int countShapes() const;
+    /// Returns the shape at \a index or a null shape if there is none
+    TopoDS_Shape getShape(int index) const;
+
+    /// Writes all shapes in the text BRep or the binary format
+    void write(std::ostream& out, bool binary) const;
+    /// Reads all shapes. Raises Base::CADKernelError on failure.
+    void read(std::istream& in, bool binary);
+
+    /** @name I/O of the pool */
+    //@{
+    unsigned int getMemSize() const override;
+    /// The pool has no XML data
+    void Save(Base::Writer& writer) const override;
+    void Restore(Base::XMLReader& reader) override;
+    void SaveDocFile(Base::Writer& writer) const override;
+    void RestoreDocFile(Base::Reader& reader) override;
+    //@}
+
+private:
+    std::vector<TopoDS_Shape> shapes;
+    /// Maps the added shapes, at the origin and in forward orientation, to their first copy
+    TopTools_DataMapOfShapeShape bases;
+    /// The first added shape for each geometry by the hash of its serialized form
+    std::unordered_multimap<uint64_t, TopoDS_Shape> geometries;
+};
+
+}  // namespace Part
+
+#endif  // PART_SHAPEPOOL_H
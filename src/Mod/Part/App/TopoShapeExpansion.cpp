@@ -88,6 +88,7 @@
 #endif
 
 #include "modelRefine.h"
+#include "ClusteredFuse.h"
 #include "CrossSection.h"
 #include "TopoShape.h"
 #include "TopoShapeOpCode.h"
@@ -3908,10 +3909,7 @@ TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(1, distances, wires);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
@@ -5688,6 +5686,27 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
         return *this;
     }
 
+    int clusterThreshold = ClusteredFuse::getThreshold();
+    if (strcmp(maker, Part::OpCodes::Fuse) == 0 && clusterThreshold > 0
+        && inputs.size() >= static_cast<std::size_t>(clusterThreshold)) {
+        // A single operation with many shapes is slow and needs a lot of memory, so groups of
+        // shapes that don't overlap are fused separately and large groups are fused bottom-up
+        std::vector<TopoDS_Shape> args;
+        for (const auto& shape : inputs) {
+            if (shape.isNull()) {
+                FC_THROWM(NullShapeException, "Null input shape");
+            }
+            args.push_back(shape.getShape());
+        }
+        ClusteredFuse mkFuse(args, tolerance);
+        mkFuse.build();
+        makeShapeWithElementMap(mkFuse.shape(), mkFuse, inputs, op);
+        if (buildShell) {
+            makeElementShell();
+        }
+        return *this;
+    }
+
     std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
     if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
         mk.reset(new FCBRepAlgoAPI_Fuse);
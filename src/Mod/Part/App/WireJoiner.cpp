@@ -51,6 +51,7 @@
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
+# include <TopTools_MapOfShape.hxx>
 #endif
 
 #include <BRepTools_History.hxx>
@@ -59,11 +60,13 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <deque>
+#include <thread>
 #include <boost_geometry.hpp>
 #include <utility>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/Parallel.h>
 #include <Base/Tools.h>
 #include <Base/Sequencer.h>
 #include <Base/Parameter.h>
@@ -117,6 +120,7 @@ public:
     bool doMergeEdge = true;
     bool doOutline = false;
     bool doTightBound = true;
+    bool doParallel = true;
 
     std::string catchObject;
     int catchIteration {};
@@ -1000,7 +1004,21 @@ public:
         }
     };
 
-    void checkSelfIntersection(const EdgeInfo &info, std::set<IntersectInfo> &params) const
+    // The intersections found for one edge in the order they were found. They are merged into
+    // the parameters of the edge in splitEdges().
+    using IntersectList = std::vector<IntersectInfo>;
+
+    // The intersections of an edge with itself and with the edges that follow it in the list
+    struct EdgeIntersections {
+        EdgeInfo* info {};
+        std::vector<EdgeInfo*> others;
+        IntersectList self;
+        std::vector<std::pair<IntersectList, IntersectList>> pairs;
+    };
+
+    void checkSelfIntersection(const EdgeInfo &info,
+                               const TopoDS_Edge &edge,
+                               IntersectList &params) const
     {
         // Early return if checking for self intersection (only for non linear spline curves)
         if (info.type <= GeomAbs_Parabola || info.isLinear) {
@@ -1010,7 +1028,7 @@ public:
         TColgp_SequenceOfPnt points3d;
         TColStd_SequenceOfReal errors;
         TopoDS_Wire wire;
-        BRepBuilderAPI_MakeWire mkWire(info.edge);
+        BRepBuilderAPI_MakeWire mkWire(edge);
         if (!mkWire.IsDone()) {
             return;
         }
@@ -1035,28 +1053,31 @@ public:
 
         assert(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            params.emplace(points2d(i).ParamOnFirst(), points3d(i), info.edge);
-            params.emplace(points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnFirst(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
     // This method was originally part of WireJoinerP::checkIntersection(), split to reduce
     // cognitive complexity
     bool checkIntersectionPlanar(const EdgeInfo& info,
+                                 const TopoDS_Edge& edge1,
                                  const EdgeInfo& other,
-                                 std::set<IntersectInfo>& params1,
-                                 std::set<IntersectInfo>& params2)
+                                 const TopoDS_Edge& edge2,
+                                 IntersectList& params1,
+                                 IntersectList& params2) const
     {
         gp_Pln pln;
-        bool planar = TopoShape(info.edge).findPlane(pln);
+        bool planar = TopoShape(edge1).findPlane(pln);
         if (!planar) {
+            BRep_Builder compBuilder;
             TopoDS_Compound comp;
-            builder.MakeCompound(comp);
-            builder.Add(comp, info.edge);
-            builder.Add(comp, other.edge);
+            compBuilder.MakeCompound(comp);
+            compBuilder.Add(comp, edge1);
+            compBuilder.Add(comp, edge2);
             planar = TopoShape(comp).findPlane(pln);
             if (!planar) {
-                BRepExtrema_DistShapeShape extss(info.edge, other.edge);
+                BRepExtrema_DistShapeShape extss(edge1, edge2);
                 extss.Perform();
                 if (extss.IsDone() && extss.NbSolution() > 0) {
                     if (!extss.IsDone() || extss.NbSolution() <= 0 || extss.Value() >= myTol) {
@@ -1069,11 +1090,11 @@ public:
                     auto s2 = extss.SupportOnShape2(i);
                     if (s1.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS1(i, par);
-                        pushIntersection(params1, par, extss.PointOnShape1(i), other.edge);
+                        params1.emplace_back(par, extss.PointOnShape1(i), other.edge);
                     }
                     if (s2.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS2(i, par);
-                        pushIntersection(params2, par, extss.PointOnShape2(i), info.edge);
+                        params2.emplace_back(par, extss.PointOnShape2(i), info.edge);
                     }
                 }
                 return false;
@@ -1112,12 +1133,14 @@ public:
     // This method was originally part of WireJoinerP::checkIntersection(), split to reduce
     // cognitive complexity
     static bool checkIntersectionMakeWire(const EdgeInfo& info,
+                                          const TopoDS_Edge& edge1,
                                           const EdgeInfo& other,
+                                          const TopoDS_Edge& edge2,
                                           int& idx,
                                           TopoDS_Wire& wire)
     {
-        BRepBuilderAPI_MakeWire mkWire(info.edge);
-        mkWire.Add(other.edge);
+        BRepBuilderAPI_MakeWire mkWire(edge1);
+        mkWire.Add(edge2);
         if (mkWire.IsDone()) {
             idx = 2;
         }
@@ -1130,7 +1153,7 @@ public:
             }
 
             mkWire.Add(mkEdge.Edge());
-            mkWire.Add(other.edge);
+            mkWire.Add(edge2);
         }
 
         if (!checkIntersectionWireDone(mkWire)) {
@@ -1167,11 +1190,13 @@ public:
     }
 
     void checkIntersection(const EdgeInfo &info,
+                           const TopoDS_Edge &edge1,
                            const EdgeInfo &other,
-                           std::set<IntersectInfo> &params1,
-                           std::set<IntersectInfo> &params2)
+                           const TopoDS_Edge &edge2,
+                           IntersectList &params1,
+                           IntersectList &params2) const
     {
-        if(!checkIntersectionPlanar(info, other, params1, params2)){
+        if(!checkIntersectionPlanar(info, edge1, other, edge2, params1, params2)){
             return;
         }
 
@@ -1187,7 +1212,7 @@ public:
         TopoDS_Wire wire;
         int idx = 0;
 
-        if (!checkIntersectionMakeWire(info, other, idx, wire)){
+        if (!checkIntersectionMakeWire(info, edge1, other, edge2, idx, wire)){
             return;
         }
 
@@ -1205,8 +1230,54 @@ public:
 
         assert(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            pushIntersection(params1, points2d(i).ParamOnFirst(), points3d(i), other.edge);
-            pushIntersection(params2, points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params1.emplace_back(points2d(i).ParamOnFirst(), points3d(i), other.edge);
+            params2.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
+        }
+    }
+
+    // Runs the intersection checks of a chunk of entries.
+    // Building the temporary wires of the checks can change the tolerances of the vertices.
+    // The checks therefore run on a copy of the edges of the chunk, so the original edges are
+    // only read and the result doesn't depend on the threads that run the chunks. All edges
+    // of the chunk are copied at once to keep their shared vertices. The original edges are
+    // recorded as intersecting shapes.
+    void checkIntersections(std::vector<EdgeIntersections>::iterator begin,
+                            std::vector<EdgeIntersections>::iterator end) const
+    {
+        BRep_Builder compBuilder;
+        TopoDS_Compound comp;
+        compBuilder.MakeCompound(comp);
+        TopTools_MapOfShape added;
+        auto addEdge = [&](const TopoDS_Edge& edge) {
+            if (added.Add(edge)) {
+                compBuilder.Add(comp, edge);
+            }
+        };
+        for (auto it = begin; it != end; ++it) {
+            addEdge(it->info->edge);
+            for (const auto* other : it->others) {
+                addEdge(other->edge);
+            }
+        }
+        BRepBuilderAPI_Copy copy(comp, Standard_False);
+        auto copyOf = [&copy](const TopoDS_Edge& edge) {
+            return TopoDS::Edge(copy.ModifiedShape(edge));
+        };
+
+        for (auto it = begin; it != end; ++it) {
+            auto& entry = *it;
+            TopoDS_Edge edge = copyOf(entry.info->edge);
+            checkSelfIntersection(*entry.info, edge, entry.self);
+            entry.pairs.resize(entry.others.size());
+            for (std::size_t i = 0; i < entry.others.size(); ++i) {
+                const auto* other = entry.others[i];
+                checkIntersection(*entry.info,
+                                  edge,
+                                  *other,
+                                  copyOf(other->edge),
+                                  entry.pairs[i].first,
+                                  entry.pairs[i].second);
+            }
         }
     }
 
@@ -1305,20 +1376,68 @@ public:
         std::unique_ptr<Base::SequencerLauncher> seq(
                 new Base::SequencerLauncher("Splitting edges", edges.size()));
 
+        std::vector<EdgeIntersections> candidates;
+        candidates.reserve(edges.size());
         idx = 0;
         for (auto& info : edges) {
-            seq->next(true);
             ++idx;
-            auto &params = intersects[&info];
-            checkSelfIntersection(info, params);
-
+            candidates.emplace_back();
+            auto& entry = candidates.back();
+            entry.info = &info;
             for (auto vit=boxMap.qbegin(bgi::intersects(info.box)); vit!=boxMap.qend(); ++vit) {
-                const auto &other = *(*vit);
+                auto &other = *(*vit);
                 if (other.iteration <= idx) {
                     // means the edge is before us, and we've already checked intersection
                     continue;
                 }
-                checkIntersection(info, other, params, intersects[&other]);
+                entry.others.push_back(&other);
+            }
+        }
+
+        // The candidate pairs are checked in chunks, concurrently in batches, so that the
+        // progress can be reported. The serial path uses the same chunks, so it gets the same
+        // result. The results are merged in the original order because pushIntersection() skips
+        // points close to those that were added before.
+        const std::size_t numThreads = std::max(1U, std::thread::hardware_concurrency());
+        const std::size_t chunkSize = 64;
+        const std::size_t batchSize = chunkSize * numThreads;
+        for (std::size_t batch = 0; batch < candidates.size(); batch += batchSize) {
+            const std::size_t last = std::min(batch + batchSize, candidates.size());
+            auto batchBegin = candidates.begin() + batch;
+            auto batchEnd = candidates.begin() + last;
+            const std::size_t numChunks = (last - batch + chunkSize - 1) / chunkSize;
+            auto checkChunk = [&](std::size_t chunk) {
+                auto chunkBegin = batchBegin + chunk * chunkSize;
+                auto chunkEnd = batchBegin + std::min((chunk + 1) * chunkSize, last - batch);
+                checkIntersections(chunkBegin, chunkEnd);
+            };
+            if (!doParallel || numChunks == 1) {
+                for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+                    checkChunk(chunk);
+                }
+            }
+            else {
+                Base::runConcurrently(numChunks, checkChunk);
+            }
+
+            for (auto it = batchBegin; it != batchEnd; ++it) {
+                seq->next(true);
+                auto &params = intersects[it->info];
+                for (const auto& param : it->self) {
+                    params.insert(param);
+                }
+                for (std::size_t i = 0; i < it->others.size(); ++i) {
+                    auto &otherParams = intersects[it->others[i]];
+                    for (const auto& param : it->pairs[i].first) {
+                        pushIntersection(params, param.param, param.point, param.intersectShape);
+                    }
+                    for (const auto& param : it->pairs[i].second) {
+                        pushIntersection(otherParams, param.param, param.point, param.intersectShape);
+                    }
+                }
+                // release the results as soon as they are merged
+                it->self.clear();
+                it->pairs.clear();
             }
         }
 
@@ -3112,6 +3231,14 @@ void WireJoiner::setSplitEdges(bool enable)
     }
 }
 
+void WireJoiner::setParallel(bool enable)
+{
+    if (enable != pimpl->doParallel) {
+        NotDone();
+        pimpl->doParallel = enable;
+    }
+}
+
 void WireJoiner::setMergeEdges(bool enable)
 {
     if (enable != pimpl->doSplitEdge) {
@@ -43,6 +43,8 @@ public:
     void setTightBound(bool enable=true);
     void setSplitEdges(bool enable=true);
     void setMergeEdges(bool enable=true);
+    /// Checks the edge intersections with several threads, the result is the same
+    void setParallel(bool enable=true);
     void setTolerance(double tolerance, double atol=0.0);
 
     bool getOpenWires(TopoShape &shape, const char *op="", bool noOriginal=true);
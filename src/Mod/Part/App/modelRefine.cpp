@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <iterator>
+# include <set>
 # include <Bnd_Box.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -63,11 +64,13 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
 # include <TopTools_ListOfShape.hxx>
 #endif // _PreComp_
 
 #include <Base/Console.h>
+#include <Base/Parallel.h>
 
 #include "modelRefine.h"
 
@@ -85,33 +88,46 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //An edge that is used an even number of times is shared by two faces of the group (or is
+    //a seam edge) and is dropped. The others are returned in the order in which they were last
+    //added, i.e. the order of a list where each pair of occurrences cancels out.
+    TopTools_IndexedMapOfShape edgeMap;
+    std::vector<int> counts;
+    std::vector<std::size_t> positions;
+    EdgeVectorType lastEdges;
+    std::size_t position(0);
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
-        EdgeVectorType faceEdges;
-        EdgeVectorType::iterator faceEdgesIt;
-        getFaceEdges(*faceIt, faceEdges);
-        for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
+        TopExp_Explorer it;
+        for (it.Init(*faceIt, TopAbs_EDGE); it.More(); it.Next(), ++position)
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            std::size_t index = edgeMap.Add(it.Current()) - 1;
+            if (index == counts.size())
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
+                counts.push_back(0);
+                positions.push_back(0);
+                lastEdges.emplace_back();
+            }
+            if (++counts[index] % 2 == 1)
+            {
+                positions[index] = position;
+                lastEdges[index] = TopoDS::Edge(it.Current());
             }
-            if (!foundSignal)
-                edges.push_back(*faceEdgesIt);
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    std::vector<std::pair<std::size_t, std::size_t>> order;
+    for (std::size_t index = 0; index < counts.size(); ++index)
+    {
+        if (counts[index] % 2 == 1)
+            order.emplace_back(positions[index], index);
+    }
+    std::sort(order.begin(), order.end());
+
+    edgesOut.reserve(edgesOut.size() + order.size());
+    for (const auto& it : order)
+        edgesOut.push_back(lastEdges[it.second]);
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -257,24 +273,60 @@ void FaceEqualitySplitter::split(const FaceVectorType &faces, FaceTypedBase *obj
 {
     std::vector<FaceVectorType> tempVector;
     tempVector.reserve(faces.size());
+    //the groups are indexed by the equality key of their first face, so that a face is only
+    //compared with the groups it can be equal to. As before it's added to the first matching
+    //group in the order the groups were created.
+    std::multimap<double, std::size_t> keyedGroups;
+    std::vector<std::size_t> unkeyedGroups;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
-        bool foundMatch(false);
-        std::vector<FaceVectorType>::iterator tempIt;
-        for (tempIt = tempVector.begin(); tempIt != tempVector.end(); ++tempIt)
+        std::size_t match(tempVector.size());
+        double key(0.0);
+        double tolerance(0.0);
+        bool hasKey = object->equalityKey(*faceIt, key, tolerance);
+        if (hasKey)
         {
-            if (object->isEqual((*tempIt).front(), *faceIt))
+            auto keyIt = keyedGroups.lower_bound(key - tolerance);
+            for (; keyIt != keyedGroups.end() && keyIt->first <= key + tolerance; ++keyIt)
             {
-                (*tempIt).push_back(*faceIt);
-                foundMatch = true;
-                break;
+                if (keyIt->second < match && object->isEqual(tempVector[keyIt->second].front(), *faceIt))
+                    match = keyIt->second;
+            }
+            for (std::size_t index : unkeyedGroups)
+            {
+                if (index >= match)
+                    break;
+                if (object->isEqual(tempVector[index].front(), *faceIt))
+                {
+                    match = index;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t index = 0; index < tempVector.size(); ++index)
+            {
+                if (object->isEqual(tempVector[index].front(), *faceIt))
+                {
+                    match = index;
+                    break;
+                }
             }
         }
-        if (!foundMatch)
+
+        if (match < tempVector.size())
         {
+            tempVector[match].push_back(*faceIt);
+        }
+        else
+        {
+            if (hasKey)
+                keyedGroups.emplace(key, tempVector.size());
+            else
+                unkeyedGroups.push_back(tempVector.size());
             FaceVectorType another;
-            another.reserve(faces.size());
             another.push_back(*faceIt);
             tempVector.push_back(another);
         }
@@ -297,20 +349,46 @@ GeomAbs_SurfaceType FaceTypedBase::getFaceType(const TopoDS_Face &faceIn)
     return surfaceTest.GetType();
 }
 
+bool FaceTypedBase::equalityKey(const TopoDS_Face &, double &, double &) const
+{
+    return false;
+}
+
 void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<EdgeVectorType> &boundariesOut) const
 {
     EdgeVectorType bEdges;
     boundaryEdges(facesIn, bEdges);
 
-    std::list<TopoDS_Edge> edges;
-    std::copy(bEdges.begin(), bEdges.end(), back_inserter(edges));
-    while(!edges.empty())
+    //the remaining edges starting at a vertex, sorted by their position in bEdges. The next edge
+    //of a boundary is the first remaining one that starts where the previous edge ends.
+    TopTools_IndexedMapOfShape vertexMap;
+    std::vector<std::set<std::size_t>> startingEdges;
+    std::vector<int> firstVertices;
+    firstVertices.reserve(bEdges.size());
+    for (std::size_t index = 0; index < bEdges.size(); ++index)
+    {
+        int vertexIndex = vertexMap.Add(TopExp::FirstVertex(bEdges[index], Standard_True));
+        if (vertexIndex > static_cast<int>(startingEdges.size()))
+            startingEdges.resize(vertexIndex);
+        startingEdges[vertexIndex - 1].insert(index);
+        firstVertices.push_back(vertexIndex);
+    }
+
+    std::vector<bool> used(bEdges.size(), false);
+    auto useEdge = [&](std::size_t index) {
+        used[index] = true;
+        startingEdges[firstVertices[index] - 1].erase(index);
+    };
+
+    for (std::size_t front = 0; front < bEdges.size(); ++front)
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(edges.front(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(edges.front(), Standard_True);
+        if (used[front])
+            continue;
+        TopoDS_Vertex destination = TopExp::FirstVertex(bEdges[front], Standard_True);
+        TopoDS_Vertex lastVertex = TopExp::LastVertex(bEdges[front], Standard_True);
         EdgeVectorType boundary;
-        boundary.push_back(edges.front());
-        edges.pop_front();
+        boundary.push_back(bEdges[front]);
+        useEdge(front);
         //single edge closed check.
         if (destination.IsSame(lastVertex))
         {
@@ -319,24 +397,20 @@ void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<Edg
         }
 
         bool closedSignal(false);
-        std::list<TopoDS_Edge>::iterator it;
-        for (it = edges.begin(); it != edges.end();)
+        for (;;)
         {
-            TopoDS_Vertex currentVertex = TopExp::FirstVertex(*it, Standard_True);
-            if (lastVertex.IsSame(currentVertex))
+            int vertexIndex = vertexMap.FindIndex(lastVertex);
+            if (vertexIndex == 0 || startingEdges[vertexIndex - 1].empty())
+                break;
+            std::size_t next = *startingEdges[vertexIndex - 1].begin();
+            boundary.push_back(bEdges[next]);
+            lastVertex = TopExp::LastVertex(bEdges[next], Standard_True);
+            useEdge(next);
+            if (lastVertex.IsSame(destination))
             {
-                boundary.push_back(*it);
-                lastVertex = TopExp::LastVertex(*it, Standard_True);
-                edges.erase(it);
-                it = edges.begin();
-                if (lastVertex.IsSame(destination))
-                {
-                    closedSignal = true;
-                    break;
-                }
-                continue;
+                closedSignal = true;
+                break;
             }
-            ++it;
         }
         if (closedSignal)
             boundariesOut.push_back(boundary);
@@ -386,6 +460,22 @@ GeomAbs_SurfaceType FaceTypedPlane::getType() const
     return GeomAbs_Plane;
 }
 
+bool FaceTypedPlane::equalityKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_Plane) planeSurface = getGeomPlane(face);
+    if (planeSurface.IsNull())
+        return false;
+
+    //the distance of the origin to two equal planes differs by the distance tolerance plus
+    //the angular tolerance of isEqual() multiplied with the distance of the plane location
+    gp_Pln plane(planeSurface->Pln());
+    gp_Pnt origin(0.0, 0.0, 0.0);
+    double distance = plane.Location().Distance(origin);
+    key = plane.Distance(origin);
+    tolerance = 2.0 * Precision::Confusion() * (1.0 + distance);
+    return true;
+}
+
 TopoDS_Face FaceTypedPlane::buildFace(const FaceVectorType &faces) const
 {
     std::vector<TopoDS_Wire> wires;
@@ -482,6 +572,17 @@ GeomAbs_SurfaceType FaceTypedCylinder::getType() const
     return GeomAbs_Cylinder;
 }
 
+bool FaceTypedCylinder::equalityKey(const TopoDS_Face &face, double &key, double &tolerance) const
+{
+    Handle(Geom_CylindricalSurface) surface = getGeomCylinder(face);
+    if (surface.IsNull())
+        return false;
+
+    key = surface->Radius();
+    tolerance = 2.0 * Precision::Confusion();
+    return true;
+}
+
 // Auxiliary method
 const TopoDS_Face fixFace(const TopoDS_Face& f) {
     static TopoDS_Face dummy;
@@ -1050,11 +1151,19 @@ bool FaceUniter::process()
 
     ModelRefine::FaceAdjacencySplitter adjacencySplitter(workShell);
 
+    //the faces of the different types are grouped concurrently as this only reads the shell.
+    //Building the new faces is done sequentially because it updates the tolerances of the
+    //edges and vertices that are shared with the rest of the shell.
+    std::vector<ModelRefine::FaceEqualitySplitter> equalitySplitters(typeObjects.size());
+    Base::runConcurrently(typeObjects.size(), [&](std::size_t index) {
+        FaceTypedBase* typeObject = typeObjects[index];
+        equalitySplitters[index].split(splitter.getTypedFaceVector(typeObject->getType()), typeObject);
+    });
+
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
     {
-        ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
-        ModelRefine::FaceEqualitySplitter equalitySplitter;
-        equalitySplitter.split(typedFaces, *typeIt);
+        const ModelRefine::FaceEqualitySplitter& equalitySplitter =
+            equalitySplitters[typeIt - typeObjects.begin()];
         for (std::size_t indexEquality(0); indexEquality < equalitySplitter.getGroupCount(); ++indexEquality)
         {
             adjacencySplitter.split(equalitySplitter.getGroup(indexEquality));
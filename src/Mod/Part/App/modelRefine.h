@@ -63,6 +63,10 @@ namespace ModelRefine
         virtual bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const = 0;
         virtual GeomAbs_SurfaceType getType() const = 0;
         virtual TopoDS_Face buildFace(const FaceVectorType &faces) const = 0;
+        // Computes a value that differs by less than tolerance for all faces that are equal
+        // according to isEqual(). It's used to avoid comparing all faces with each other.
+        // Returns false if the type has no such value.
+        virtual bool equalityKey(const TopoDS_Face &face, double &key, double &tolerance) const;
 
         static GeomAbs_SurfaceType getFaceType(const TopoDS_Face &faceIn);
 
@@ -79,6 +83,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool equalityKey(const TopoDS_Face &face, double &key, double &tolerance) const override;
         friend FaceTypedPlane& getPlaneObject();
     };
     FaceTypedPlane& getPlaneObject();
@@ -91,6 +96,7 @@ namespace ModelRefine
         bool isEqual(const TopoDS_Face &faceOne, const TopoDS_Face &faceTwo) const override;
         GeomAbs_SurfaceType getType() const override;
         TopoDS_Face buildFace(const FaceVectorType &faces) const override;
+        bool equalityKey(const TopoDS_Face &face, double &key, double &tolerance) const override;
         friend FaceTypedCylinder& getCylinderObject();
 
     protected:
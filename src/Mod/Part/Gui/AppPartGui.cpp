@@ -44,6 +44,7 @@
 #include "SoBrepFaceSet.h"
 #include "SoBrepPointSet.h"
 #include "SoFCShapeObject.h"
+#include "TessellationCache.h"
 #include "ViewProvider.h"
 #include "ViewProvider2DObject.h"
 #include "ViewProviderAttachExtension.h"
@@ -172,6 +173,7 @@ PyMOD_INIT_FUNC(PartGui)
     PartGui::ViewProviderPlane                      ::init();
     PartGui::ViewProviderPoint                      ::init();
     PartGui::ViewProviderLCS                        ::init();
+    PartGui::PropertyTessellation                   ::init();
     PartGui::ViewProviderPartExt                    ::init();
     PartGui::ViewProviderPart                       ::init();
     PartGui::ViewProviderPrimitive                  ::init();
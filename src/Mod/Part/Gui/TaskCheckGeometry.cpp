@@ -25,18 +25,14 @@
 # include <QCheckBox>
 # include <QCoreApplication>
 # include <QHeaderView>
+# include <QProgressDialog>
 # include <QPushButton>
 # include <QScrollBar>
 # include <QTextEdit>
 # include <QTextStream>
-# include <QThread>
 # include <QTreeView>
-# include <Standard_Version.hxx>
 # include <Bnd_Box.hxx>
-# include <BOPAlgo_ArgumentAnalyzer.hxx>
-# include <BOPAlgo_ListOfCheckResult.hxx>
 # include <BRepBndLib.hxx>
-# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <BRepCheck_ListIteratorOfListOfStatus.hxx>
 # include <BRepCheck_Result.hxx>
@@ -410,6 +406,40 @@ void TaskCheckGeometryResults::setupInterface()
     this->setLayout(layout);
 }
 
+namespace {
+// Passes the results to the task panel and keeps the GUI responsive while the check runs
+class GuiGeometryCheck: public Part::GeometryCheck
+{
+public:
+    using Handler = std::function<void(const Result&)>;
+    GuiGeometryCheck(const Handler& handler, QProgressDialog* progress)
+        : handler(handler)
+        , progress(progress)
+    {}
+
+protected:
+    void onResult(const Result& result) override
+    {
+        handler(result);
+        progress->setValue(progress->value() + 1);
+        if (progress->wasCanceled()) {
+            cancel();
+        }
+    }
+    void onWait() override
+    {
+        QCoreApplication::processEvents();
+        if (progress->wasCanceled()) {
+            cancel();
+        }
+    }
+
+private:
+    Handler handler;
+    QProgressDialog* progress;
+};
+} // namespace
+
 void TaskCheckGeometryResults::goCheck()
 {
     Gui::WaitCursor wc;
@@ -420,25 +450,94 @@ void TaskCheckGeometryResults::goCheck()
     reportViewStrings.clear();
     reportViewStrings << QLatin1String("\n");
 
-    std::string scopeName {tr("Boolean operation check...").toStdString()};
-#if OCC_VERSION_HEX < 0x070500
-    Handle(Message_ProgressIndicator) theProgress = new BOPProgressIndicator(tr("Check geometry"),
-                                                                             Gui::getMainWindow());
-    theProgress->NewScope(scopeName.c_str());
-    theProgress->Show();
-#else
-    Handle(Message_ProgressIndicator) theProgress = new BOPProgressIndicator(tr("Check geometry"),
-                                                                             Gui::getMainWindow());
-    Message_ProgressRange theRange(theProgress->Start());
-    Message_ProgressScope theScope(theRange,
-                                   TCollection_AsciiString(scopeName.c_str()),
-                                   selection.size());
-    theScope.Show();
-#endif // 0x070500
+    ParameterGrp::handle group = App::GetApplication().GetUserParameter().
+    GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod")->GetGroup("Part")->GetGroup("CheckGeometry");
+    bool runSignal = group->GetBool("RunBOPCheck", false);
+    group->SetBool("RunBOPCheck", runSignal);
+
+    //BOPAlgo_ArgumentAnalyzer can be really slow!
+    //so it's only run on the shapes whose parts seem valid to BRepCheck_Analyzer
+    //and when the option is set.
+    Part::GeometryCheck::Options options;
+    options.runBopCheck = runSignal;
+    options.parallel = !group->GetBool("RunBOPCheckSingleThreaded", false);
+    options.argumentTypeMode = group->GetBool("ArgumentTypeMode", true);
+    options.selfInterMode = group->GetBool("SelfInterMode", true);
+    options.smallEdgeMode = group->GetBool("SmallEdgeMode", true);
+    options.rebuildFaceMode = group->GetBool("RebuildFaceMode", true);
+    options.continuityMode = group->GetBool("ContinuityMode", true);
+    options.tangentMode = group->GetBool("TangentMode", true);
+    options.mergeVertexMode = group->GetBool("MergeVertexMode", true);
+    options.mergeEdgeMode = group->GetBool("MergeEdgeMode", true);
+    options.curveOnSurfaceMode = group->GetBool("CurveOnSurfaceMode", true);
+
+    // the entries of the checked objects in the order they are added to the check
+    struct CheckedObject {
+        ResultEntry *entry;
+        bool invalid;
+    };
+    std::vector<CheckedObject> objects;
+
+    QProgressDialog progress(Gui::getMainWindow());
+    progress.setWindowTitle(tr("Check geometry"));
+    progress.setWindowModality(Qt::WindowModal);
+
+    std::size_t finished = 0;
+    auto finishObjects = [&](std::size_t last) {
+        for (; finished < last; finished++) {
+            CheckedObject &object = objects[finished];
+            if (!object.invalid) {
+                object.entry->error = tr("No errors");
+                reportViewStrings.append(object.entry->name + QLatin1String(" | ")
+                                         + object.entry->type + QLatin1String(" | ") + object.entry->error);
+            }
+            checkedCount++;
+            checkedMap.Clear();
+        }
+    };
+
+    GuiGeometryCheck geometryCheck([&](const Part::GeometryCheck::Result &result) {
+        finishObjects(result.owner);
+        if (result.isValid())
+            return;
+
+        CheckedObject &object = objects[result.owner];
+        ResultEntry *entry = object.entry;
+        if (!object.invalid) {
+            object.invalid = true;
+            invalidShapes++;
+            entry->error = tr("Invalid");
+            reportViewStrings.append(entry->name + QLatin1String(" | ")
+                                     + entry->type + QLatin1String(" | ") + entry->error);
+            goSetupResultBoundingBox(entry);
+        }
+
+        currentSeparator = entry->viewProviderRoot;
+        if (result.bopCheck) {
+            goBOPSingleCheck(result, entry);
+        }
+        else if (!result.analyzer) {
+            ResultEntry *failed = new ResultEntry();
+            failed->parent = entry;
+            failed->shape = result.shape;
+            failed->buildEntryName();
+            failed->type = shapeEnumToString(result.shape.ShapeType());
+            failed->error = checkStatusToString(BRepCheck_CheckFail);
+            reportViewStrings.append(failed->name + QLatin1String(" | ")
+                                     + failed->type + QLatin1String(" | ") + failed->error);
+            failed->viewProviderRoot = currentSeparator;
+            failed->viewProviderRoot->ref();
+            dispatchError(failed, BRepCheck_CheckFail);
+            entry->children.push_back(failed);
+        }
+        else {
+            recursiveCheck(*result.analyzer, result.shape, entry);
+        }
+    }, &progress);
+    geometryCheck.setOptions(options);
 
     for(const auto &sel :  selection) {
         selectedCount++;
-        int localInvalidShapeCount(0);
         QString baseName;
         QTextStream baseStream(&baseName);
         baseStream << sel.DocName;
@@ -476,77 +575,36 @@ void TaskCheckGeometryResults::goCheck()
             continue;
         }
 
-        checkedCount++;
-        checkedMap.Clear();
-
         buildShapeContent(sel.pObject, baseName, shape);
 
-        BRepCheck_Analyzer shapeCheck(shape);
-        if (!shapeCheck.IsValid())
-        {
-            invalidShapes++;
-            localInvalidShapeCount++;
-            ResultEntry *entry = new ResultEntry();
-            entry->parent = theRoot;
-            entry->shape = shape;
-            entry->name = baseName;
-            entry->type = shapeEnumToString(shape.ShapeType());
-            entry->error = tr("Invalid");
-            reportViewStrings.append(entry->name + QLatin1String(" | ")
-                                     + entry->type + QLatin1String(" | ") + entry->error);
-            entry->viewProviderRoot = currentSeparator;
-            entry->viewProviderRoot->ref();
-            goSetupResultBoundingBox(entry);
-            theRoot->children.push_back(entry);
-            recursiveCheck(shapeCheck, shape, entry);
-            continue; //don't run BOPAlgo_ArgumentAnalyzer if BRepCheck_Analyzer finds something.
-        }
-        else
-        {
-          //BOPAlgo_ArgumentAnalyzer can be really slow!
-          //so only run it when the shape seems valid to BRepCheck_Analyzer And
-          //when the option is set.
-
-          ParameterGrp::handle group = App::GetApplication().GetUserParameter().
-          GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod")->GetGroup("Part")->GetGroup("CheckGeometry");
-          bool runSignal = group->GetBool("RunBOPCheck", false);
-          group->SetBool("RunBOPCheck", runSignal);
-          if (runSignal) {
-            std::string label = tr("Checking").toStdString() + " ";
-            label += sel.pObject->Label.getStrValue();
-            label += "...";
-#if OCC_VERSION_HEX < 0x070500
-            theProgress->NewScope(label.c_str());
-            localInvalidShapeCount += goBOPSingleCheck(shape, theRoot, baseName, theProgress);
-            invalidShapes += localInvalidShapeCount;
-            theProgress->EndScope();
-            if (theProgress->UserBreak())
-              break;
-#else
-            Message_ProgressScope theInnerScope(theScope.Next(), TCollection_AsciiString(label.c_str()), 1);
-            theInnerScope.Show();
-            localInvalidShapeCount += goBOPSingleCheck(shape, theRoot, baseName, theInnerScope);
-            invalidShapes += localInvalidShapeCount;
-            theInnerScope.Close();
-            if (theScope.UserBreak())
-              break;
-#endif
-          }
-        }
-        // create an entry for shapes without errors
-        if (localInvalidShapeCount == 0) {
-            ResultEntry *entry = new ResultEntry();
-            entry->parent = theRoot;
-            entry->name = baseName;
-            entry->type = shapeEnumToString(shape.ShapeType());
-            entry->error = tr("No errors");
-            reportViewStrings.append(entry->name + QLatin1String(" | ")
-                                     + entry->type + QLatin1String(" | ") + entry->error);
-            entry->viewProviderRoot = currentSeparator;
-            entry->viewProviderRoot->ref();
-            theRoot->children.push_back(entry);
+        ResultEntry *entry = new ResultEntry();
+        entry->parent = theRoot;
+        entry->shape = shape;
+        entry->name = baseName;
+        entry->type = shapeEnumToString(shape.ShapeType());
+        entry->viewProviderRoot = currentSeparator;
+        entry->viewProviderRoot->ref();
+        theRoot->children.push_back(entry);
+
+        objects.push_back({entry, false});
+        geometryCheck.addShape(shape);
+    }
+
+    progress.setLabelText(tr("Checking") + QLatin1String("..."));
+    progress.setRange(0, static_cast<int>(geometryCheck.countResults()));
+    progress.setValue(0);
+    geometryCheck.perform();
+    if (!geometryCheck.isCancelled()) {
+        finishObjects(objects.size());
+    }
+
+    // the objects that aren't completely checked
+    for (std::size_t i = finished; i < objects.size(); i++) {
+        if (!objects[i].invalid) {
+            objects[i].entry->error = tr("Skipped");
         }
     }
+
     model->setResults(theRoot);
     treeView->expandAll();
     treeView->header()->resizeSections(QHeaderView::ResizeToContents);
@@ -704,113 +762,29 @@ QString TaskCheckGeometryResults::getShapeContentString()
   return QString::fromStdString(shapeContentString);
 }
 
-#if OCC_VERSION_HEX < 0x070500
-int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, ResultEntry *theRoot, const QString &baseName,
-                                               const Handle(Message_ProgressIndicator)& theProgress)
-#else
-int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, ResultEntry *theRoot, const QString &baseName,
-                                               const Message_ProgressScope& theScope)
-#endif
+void TaskCheckGeometryResults::goBOPSingleCheck(const Part::GeometryCheck::Result &result, ResultEntry *parent)
 {
     ParameterGrp::handle group = App::GetApplication().GetUserParameter().
     GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod")->GetGroup("Part")->GetGroup("CheckGeometry");
-    bool runSingleThreaded = group->GetBool("RunBOPCheckSingleThreaded", false);
     bool logErrors = group->GetBool("LogErrors", true);
-    bool argumentTypeMode = group->GetBool("ArgumentTypeMode", true);
-    bool selfInterMode = group->GetBool("SelfInterMode", true);
-    bool smallEdgeMode = group->GetBool("SmallEdgeMode", true);
-    bool rebuildFaceMode = group->GetBool("RebuildFaceMode", true);
-    bool continuityMode = group->GetBool("ContinuityMode", true);
-    bool tangentMode = group->GetBool("TangentMode", true);
-    bool mergeVertexMode = group->GetBool("MergeVertexMode", true);
-    bool mergeEdgeMode = group->GetBool("MergeEdgeMode", true);
-    bool curveOnSurfaceMode = group->GetBool("CurveOnSurfaceMode", true);
 
   //Reference use: src/BOPTest/BOPTest_CheckCommands.cxx
 
-  //I don't why we need to make a copy, but it doesn't work without it.
-  //BRepAlgoAPI_Check also makes a copy of the shape.
-
-  //didn't use BRepAlgoAPI_Check because it calls BRepCheck_Analyzer itself and
-  //doesn't give us access to it. so I didn't want to run BRepCheck_Analyzer twice to get invalid results.
-
-  //BOPAlgo_ArgumentAnalyzer can check 2 objects with respect to a boolean op.
-  //this is left for another time.
-  TopoDS_Shape BOPCopy = BRepBuilderAPI_Copy(shapeIn).Shape();
-  BOPAlgo_ArgumentAnalyzer BOPCheck;
-
-#if OCC_VERSION_HEX < 0x070500
-  BOPCheck.SetProgressIndicator(theProgress);
-#elif OCC_VERSION_HEX < 0x070600
-  BOPCheck.SetProgressIndicator(theScope);
-#else
-  Q_UNUSED(theScope)
-#endif // 0x070500
-
-
-  BOPCheck.SetShape1(BOPCopy);
-  //all settings are false by default. so only turn on what we want.
-  BOPCheck.ArgumentTypeMode() = argumentTypeMode;
-  BOPCheck.SelfInterMode() = selfInterMode;
-  BOPCheck.SmallEdgeMode() = smallEdgeMode;
-  BOPCheck.RebuildFaceMode() = rebuildFaceMode;
-  BOPCheck.ContinuityMode() = continuityMode;
-
-  BOPCheck.SetParallelMode(!runSingleThreaded); //this doesn't help for speed right now(occt 6.9.1).
-  BOPCheck.SetRunParallel(!runSingleThreaded); //performance boost, use all available cores
-  BOPCheck.TangentMode() = tangentMode; //these 4 new tests add about 5% processing time.
-  BOPCheck.MergeVertexMode() = mergeVertexMode;
-  BOPCheck.MergeEdgeMode() = mergeEdgeMode;
-  BOPCheck.CurveOnSurfaceMode() = curveOnSurfaceMode;
-
-#ifdef FC_DEBUG
-  Base::TimeElapsed start_time;
-#endif
-
-  BOPCheck.Perform();
-
-#ifdef FC_DEBUG
-  float bopAlgoTime = Base::TimeElapsed::diffTimeF(start_time, Base::TimeElapsed());
-  std::cout << std::endl << "BopAlgo check time is: " << bopAlgoTime << std::endl << std::endl;
-#endif
-
-  if (!BOPCheck.HasFaulty())
-      return 0;
-
-  ResultEntry *entry = new ResultEntry();
-  entry->parent = theRoot;
-  entry->shape = BOPCopy; //this will cause a problem, with existing entry. i.e. entry is true.
-  entry->name = baseName;
-  entry->type = shapeEnumToString(shapeIn.ShapeType());
-  entry->error = QObject::tr("Invalid");
-  reportViewStrings.append(entry->name + QLatin1String(" | ")
-                           + entry->type + QLatin1String(" | ") + entry->error);
-  entry->viewProviderRoot = currentSeparator;
-  entry->viewProviderRoot->ref();
-  goSetupResultBoundingBox(entry);
-  theRoot->children.push_back(entry);
-
-  const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.GetCheckResult();
-  BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
-  for (; BOPResultsIt.More(); BOPResultsIt.Next())
+  //Part::GeometryCheck runs BOPAlgo_ArgumentAnalyzer on a copy of the whole shape
+  //and maps the faulty shapes back to the sub-shapes of the shape.
+  for (const auto &fault : result.bopFaults)
   {
-    const BOPAlgo_CheckResult &current = BOPResultsIt.Value();
-    const TopTools_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
-    TopTools_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
-
-    for (;faultyShapes1It.More(); faultyShapes1It.Next())
-    {
-      const TopoDS_Shape &faultyShape = faultyShapes1It.Value();
+      const TopoDS_Shape &faultyShape = fault.shape;
       ResultEntry *faultyEntry = new ResultEntry();
-      faultyEntry->parent = entry;
+      faultyEntry->parent = parent;
       faultyEntry->shape = faultyShape;
       faultyEntry->buildEntryName();
       faultyEntry->type = shapeEnumToString(faultyShape.ShapeType());
-      faultyEntry->error = getBOPCheckString(current.GetCheckStatus());
+      faultyEntry->error = getBOPCheckString(fault.status);
       reportViewStrings.append(QLatin1String("  ") + faultyEntry->name
                                + QLatin1String(" | ") + faultyEntry->error);
       faultyEntry->viewProviderRoot = currentSeparator;
-      entry->viewProviderRoot->ref();
+      faultyEntry->viewProviderRoot->ref();
       goSetupResultBoundingBox(faultyEntry);
 
       if (faultyShape.ShapeType() == TopAbs_FACE)
@@ -825,7 +799,7 @@ int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, Resu
       {
         goSetupResultTypedSelection(faultyEntry, faultyShape, TopAbs_VERTEX);
       }
-      entry->children.push_back(faultyEntry);
+      parent->children.push_back(faultyEntry);
 
       /*log BOPCheck errors to report view*/
       if (logErrors){
@@ -835,9 +809,7 @@ int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, Resu
                     << faultyEntry->error.toStdString().c_str()
                     << std::endl;
       }
-    }
   }
-  return 1;
 }
 
 
@@ -1425,94 +1397,4 @@ TaskCheckGeometryDialog::~TaskCheckGeometryDialog()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-BOPProgressIndicator::BOPProgressIndicator (const QString& title, QWidget* parent)
-{
-    steps = 0;
-    canceled = false;
-
-    myProgress = new QProgressDialog(parent);
-    myProgress->setWindowTitle(title);
-    myProgress->setAttribute(Qt::WA_DeleteOnClose);
-}
-
-BOPProgressIndicator::~BOPProgressIndicator ()
-{
-    myProgress->close();
-}
-
-#if OCC_VERSION_HEX < 0x070500
-Standard_Boolean BOPProgressIndicator::Show (const Standard_Boolean theForce)
-{
-    if (theForce) {
-        steps = 0;
-        canceled = false;
-
-        time.start();
-        myProgress->show();
-
-        myProgress->setRange(0, 0);
-        myProgress->setValue(0);
-    }
-    else {
-        Handle(TCollection_HAsciiString) aName = GetScope(1).GetName(); //current step
-        if (!aName.IsNull())
-            myProgress->setLabelText (QString::fromUtf8(aName->ToCString()));
-    }
-
-    return Standard_True;
-}
-#else
-void BOPProgressIndicator::Show (const Message_ProgressScope& theScope,
-                                 const Standard_Boolean isForce)
-{
-    Standard_CString aName = theScope.Name(); //current step
-    myProgress->setLabelText (QString::fromUtf8(aName));
-
-    if (isForce) {
-        myProgress->show();
-    }
-
-    QCoreApplication::processEvents();
-}
-
-void BOPProgressIndicator::Reset()
-{
-    steps = 0;
-    canceled = false;
-
-    time.start();
-
-    myProgress->setRange(0, 0);
-    myProgress->setValue(0);
-}
-#endif
-
-Standard_Boolean BOPProgressIndicator::UserBreak()
-{
-    QThread *currentThread = QThread::currentThread();
-    if (currentThread == myProgress->thread()) {
-        // this is needed to check the status outside BOPAlgo_ArgumentAnalyzer
-        //
-        // Hint: We must make sure to do this only when calling from the GUI
-        // thread because when calling it from a worker thread the thrown
-        // exception isn't handled anywhere and thus std::terminate is called
-        if (canceled)
-            return Standard_True;
-
-        // it suffices to update only every second
-        // to avoid to unnecessarily process events
-        steps++;
-        myProgress->setValue(steps);
-        if (time.elapsed() > 1000) {
-            time.restart();
-            QCoreApplication::processEvents();
-
-            canceled = myProgress->wasCanceled();
-            return canceled;
-        }
-    }
-
-    return Standard_False;
-}
-
 #include "moc_TaskCheckGeometry.cpp"
@@ -26,15 +26,12 @@
 #include <functional>
 #include <tuple>
 #include <QAbstractItemModel>
-#include <QElapsedTimer>
-#include <QProgressDialog>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepCheck_Status.hxx>
-#include <Message_ProgressIndicator.hxx>
-#include <Standard_Version.hxx>
 #include <TopTools_MapOfShape.hxx>
 #include <Gui/TaskView/TaskDialog.h>
 #include <Gui/TaskView/TaskView.h>
+#include <Mod/Part/App/GeometryCheck.h>
 
 
 class SoSeparator;
@@ -123,13 +120,7 @@ private:
     void dispatchError(ResultEntry *entry, const BRepCheck_Status &stat);
     bool split(QString &input, QString &doc, QString &object, QString &sub);
     void setupFunctionMap();
-#if OCC_VERSION_HEX < 0x070500
-    int goBOPSingleCheck(const TopoDS_Shape &shapeIn, ResultEntry *theRoot, const QString &baseName,
-                         const Handle(Message_ProgressIndicator)& theProgress);
-#else
-    int goBOPSingleCheck(const TopoDS_Shape &shapeIn, ResultEntry *theRoot, const QString &baseName,
-                         const Message_ProgressScope& theScope);
-#endif
+    void goBOPSingleCheck(const Part::GeometryCheck::Result &result, ResultEntry *parent);
     void buildShapeContent(App::DocumentObject *pObject, const QString &baseName, const TopoDS_Shape &shape);
     ResultModel *model;
     QTreeView *treeView;
@@ -200,28 +191,6 @@ private:
     QPushButton *settingsBtn;
     QPushButton *resultsBtn;
 };
-
-class BOPProgressIndicator : public Message_ProgressIndicator
-{
-public:
-    BOPProgressIndicator (const QString &title, QWidget* parent);
-    ~BOPProgressIndicator () override;
-
-#if OCC_VERSION_HEX < 0x070500
-    Standard_Boolean Show (const Standard_Boolean theForce = Standard_True) override;
-#else
-    void Show (const Message_ProgressScope& theScope,
-                       const Standard_Boolean isForce) override;
-    void Reset() override;
-#endif
-    Standard_Boolean UserBreak() override;
-
-private:
-    int steps;
-    bool canceled;
-    QElapsedTimer time;
-    QProgressDialog* myProgress;
-};
 }
 
 #endif // TASKCHECKGEOMETRY_H
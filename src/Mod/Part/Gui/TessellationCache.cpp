@@ -0,0 +1,354 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <ostream>
+# include <streambuf>
+
+# include <BinTools.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <Standard_Version.hxx>
+# include <TopLoc_Location.hxx>
+# include <TopoDS_Shape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <Base/Parameter.h>
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "TessellationCache.h"
+
+
+using namespace PartGui;
+
+namespace
+{
+
+// Computes a 64-bit FNV-1a hash of all bytes written to the stream
+class HashStreamBuf: public std::streambuf
+{
+public:
+    uint64_t hash() const
+    {
+        return value;
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            add(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+    std::streamsize xsputn(const char* str, std::streamsize num) override
+    {
+        for (std::streamsize i = 0; i < num; i++) {
+            add(str[i]);
+        }
+        return num;
+    }
+
+private:
+    void add(char ch)
+    {
+        value ^= static_cast<unsigned char>(ch);
+        value *= 1099511628211ULL;
+    }
+
+private:
+    uint64_t value {14695981039346656037ULL};
+};
+
+// Hashes the binary representation of a shape without its triangulation. The hash identifies
+// the geometry of a shape across sessions.
+uint64_t hashShape(const TopoDS_Shape& shape)
+{
+    HashStreamBuf buf;
+    std::ostream str(&buf);
+#if OCC_VERSION_HEX >= 0x070600
+    BinTools::Write(shape, str, Standard_False, Standard_False, BinTools_FormatVersion_CURRENT);
+#else
+    // The triangulation that is added by meshing the shape must not change the hash
+    BinTools::Write(BRepBuilderAPI_Copy(shape, Standard_True, Standard_False).Shape(), str);
+#endif
+    // 0 is reserved for the null key
+    return std::max<uint64_t>(buf.hash(), 1);
+}
+
+void hashCombine(std::size_t& seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template<typename T>
+void writeValues(Base::OutputStream& str, const std::vector<T>& values)
+{
+    str << static_cast<uint32_t>(values.size());
+    for (const auto& it : values) {
+        str << it;
+    }
+}
+
+template<typename T>
+void readValues(Base::InputStream& str, std::vector<T>& values)
+{
+    uint32_t uCt = 0;
+    str >> uCt;
+    values.resize(uCt);
+    for (auto& it : values) {
+        str >> it;
+    }
+}
+
+void writeValues(Base::OutputStream& str, const std::vector<SbVec3f>& values)
+{
+    str << static_cast<uint32_t>(values.size());
+    for (const auto& it : values) {
+        str << it[0] << it[1] << it[2];
+    }
+}
+
+void readValues(Base::InputStream& str, std::vector<SbVec3f>& values)
+{
+    uint32_t uCt = 0;
+    str >> uCt;
+    values.resize(uCt);
+    for (auto& it : values) {
+        float x {}, y {}, z {};
+        str >> x >> y >> z;
+        it.setValue(x, y, z);
+    }
+}
+
+}  // namespace
+
+std::size_t TessellationData::getMemSize() const
+{
+    return sizeof(TessellationData)
+        + (points.size() + normals.size()) * sizeof(SbVec3f)
+        + (faceIndex.size() + partIndex.size() + lineIndex.size()) * sizeof(int32_t);
+}
+
+// ----------------------------------------------------------------------------
+
+bool TessellationKey::operator==(const TessellationKey& other) const
+{
+    return geometryHash == other.geometryHash && hasSameParameters(other);
+}
+
+bool TessellationKey::hasSameParameters(const TessellationKey& other) const
+{
+    return deflection == other.deflection && angularDeflection == other.angularDeflection
+        && normalsFromUV == other.normalsFromUV;
+}
+
+std::size_t TessellationKey::hash() const
+{
+    std::size_t seed = std::hash<uint64_t>()(geometryHash);
+    hashCombine(seed, std::hash<double>()(deflection));
+    hashCombine(seed, std::hash<double>()(angularDeflection));
+    hashCombine(seed, std::hash<bool>()(normalsFromUV));
+    return seed;
+}
+
+TessellationKey TessellationKey::create(const TopoDS_Shape& shape,
+                                        double deflection,
+                                        double angularDeflection,
+                                        bool normalsFromUV)
+{
+    TessellationKey key;
+    if (!shape.IsNull()) {
+        key.geometryHash = hashShape(shape.Located(TopLoc_Location()));
+    }
+    key.deflection = deflection;
+    key.angularDeflection = angularDeflection;
+    key.normalsFromUV = normalsFromUV;
+    return key;
+}
+
+// ----------------------------------------------------------------------------
+
+TessellationCache::TessellationCache()
+{
+    ParameterGrp::handle hGrp =
+        App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part");
+    long size = hGrp->GetInt("TessellationCacheSize", 256);
+    maxSize = static_cast<std::size_t>(std::max<long>(size, 0)) * 1024 * 1024;
+}
+
+TessellationCache& TessellationCache::instance()
+{
+    static TessellationCache cache;
+    return cache;
+}
+
+std::shared_ptr<const TessellationData> TessellationCache::find(const TessellationKey& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return {};
+    }
+
+    // move to the front as most recently used entry
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void TessellationCache::insert(const TessellationKey& key,
+                               const std::shared_ptr<const TessellationData>& data)
+{
+    if (key.isNull() || !data) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        memSize -= it->second->second->getMemSize();
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    entries.emplace_front(key, data);
+    index.emplace(key, entries.begin());
+    memSize += data->getMemSize();
+    shrink();
+}
+
+void TessellationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    memSize = 0;
+}
+
+void TessellationCache::shrink()
+{
+    while (!entries.empty() && memSize > maxSize) {
+        memSize -= entries.back().second->getMemSize();
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+TYPESYSTEM_SOURCE(PartGui::PropertyTessellation, App::Property)
+
+PropertyTessellation::PropertyTessellation() = default;
+
+PropertyTessellation::~PropertyTessellation() = default;
+
+void PropertyTessellation::setValue(const TessellationKey& key,
+                                    const std::shared_ptr<const TessellationData>& data)
+{
+    this->key = key;
+    this->data = data;
+}
+
+void PropertyTessellation::Save(Base::Writer& writer) const
+{
+    bool hasFile = !writer.isForceXML() && data && !key.isNull();
+    writer.Stream() << writer.ind() << "<Tessellation file=\""
+                    << (hasFile ? writer.addFile(getName(), this) : "") << "\"/>" << std::endl;
+}
+
+void PropertyTessellation::Restore(Base::XMLReader& reader)
+{
+    reader.readElement("Tessellation");
+    std::string file(reader.getAttribute("file"));
+
+    if (!file.empty()) {
+        // initiate a file read
+        reader.addFile(file.c_str(), this);
+    }
+}
+
+void PropertyTessellation::SaveDocFile(Base::Writer& writer) const
+{
+    Base::OutputStream str(writer.Stream());
+    uint32_t version = 2;
+    str << version;
+    str << key.geometryHash << key.deflection << key.angularDeflection
+        << key.normalsFromUV;
+    str << data->vertexIndex;
+    writeValues(str, data->points);
+    writeValues(str, data->normals);
+    writeValues(str, data->faceIndex);
+    writeValues(str, data->partIndex);
+    writeValues(str, data->lineIndex);
+}
+
+void PropertyTessellation::RestoreDocFile(Base::Reader& reader)
+{
+    Base::InputStream str(reader);
+    uint32_t version = 0;
+    str >> version;
+    if (version != 2) {
+        return;
+    }
+
+    TessellationKey restored;
+    str >> restored.geometryHash >> restored.deflection >> restored.angularDeflection
+        >> restored.normalsFromUV;
+
+    auto tessellation = std::make_shared<TessellationData>();
+    str >> tessellation->vertexIndex;
+    readValues(str, tessellation->points);
+    readValues(str, tessellation->normals);
+    readValues(str, tessellation->faceIndex);
+    readValues(str, tessellation->partIndex);
+    readValues(str, tessellation->lineIndex);
+
+    // The view provider checks it against its shape once the shape is displayed
+    restoredKey = restored;
+    restoredData = tessellation;
+}
+
+std::shared_ptr<const TessellationData>
+PropertyTessellation::takeRestoredTessellation(const TessellationKey& key)
+{
+    std::shared_ptr<const TessellationData> tessellation;
+    std::swap(tessellation, restoredData);
+    if (!tessellation || key.isNull() || !(key == restoredKey)) {
+        return {};
+    }
+
+    return tessellation;
+}
+
+App::Property* PropertyTessellation::Copy() const
+{
+    auto prop = new PropertyTessellation();
+    prop->key = key;
+    prop->data = data;
+    return prop;
+}
+
+void PropertyTessellation::Paste(const App::Property& from)
+{
+    const auto& prop = dynamic_cast<const PropertyTessellation&>(from);
+    setValue(prop.key, prop.data);
+}
+
+bool PropertyTessellation::isSame(const App::Property& other) const
+{
+    if (&other == this) {
+        return true;
+    }
+    return getTypeId() == other.getTypeId()
+        && key == static_cast<const PropertyTessellation&>(other).key;
+}
+
+unsigned int PropertyTessellation::getMemSize() const
+{
+    // the data is shared with the cache
+    return sizeof(PropertyTessellation);
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef PARTGUI_TESSELLATIONCACHE_H
+#define PARTGUI_TESSELLATIONCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Inventor/SbVec3f.h>
+
+#include <App/Property.h>
+#include <Mod/Part/PartGlobal.h>
+
+
+class TopoDS_Shape;
+
+namespace PartGui
+{
+
+/** The Coin representation of a shape as it is created by ViewProviderPartExt.
+ * The arrays are the values of the coordinate, normal, face set and line set nodes.
+ */
+struct PartGuiExport TessellationData
+{
+    std::vector<SbVec3f> points;
+    std::vector<SbVec3f> normals;
+    std::vector<int32_t> faceIndex;
+    std::vector<int32_t> partIndex;
+    std::vector<int32_t> lineIndex;
+    /// The index of the first point that belongs to a vertex of the shape
+    int32_t vertexIndex {0};
+
+    std::size_t getMemSize() const;
+};
+
+/** Identifies a tessellation by the geometry of a shape and the meshing parameters.
+ * The geometry is identified by a hash of the binary representation of the shape, so equal
+ * shapes share a key even if they have been created separately or read from a project file,
+ * and the key doesn't keep the shape alive.
+ */
+struct PartGuiExport TessellationKey
+{
+    /// The hash of the geometry, 0 for a null key
+    uint64_t geometryHash {0};
+    double deflection {0.0};
+    double angularDeflection {0.0};
+    bool normalsFromUV {false};
+
+    bool isNull() const
+    {
+        return geometryHash == 0;
+    }
+    bool operator==(const TessellationKey& other) const;
+    /// Returns true if the meshing parameters are equal, regardless of the geometry
+    bool hasSameParameters(const TessellationKey& other) const;
+    std::size_t hash() const;
+
+    /** Computes the key for \a shape. The location of the shape is ignored because it's
+     * applied by the transformation node of the view provider.
+     */
+    static TessellationKey
+    create(const TopoDS_Shape& shape, double deflection, double angularDeflection, bool normalsFromUV);
+};
+
+}  // namespace PartGui
+
+namespace std
+{
+
+template<>
+struct hash<PartGui::TessellationKey>
+{
+    using argument_type = PartGui::TessellationKey;
+    using result_type = std::size_t;
+    inline result_type operator()(argument_type const& key) const
+    {
+        return key.hash();
+    }
+};
+}  // namespace std
+
+namespace PartGui
+{
+
+/** The TessellationCache class keeps the tessellations of recently displayed shapes.
+ * When a feature is recomputed without changing its geometry, or a shape is displayed by
+ * several view providers, the tessellation is taken from the cache instead of meshing the
+ * shape again. The least recently used entries are removed when the memory limit, set with
+ * the parameter TessellationCacheSize in MB, is exceeded. A value of 0 disables the cache.
+ */
+class PartGuiExport TessellationCache
+{
+public:
+    static TessellationCache& instance();
+
+    std::shared_ptr<const TessellationData> find(const TessellationKey& key);
+    void insert(const TessellationKey& key, const std::shared_ptr<const TessellationData>& data);
+    void clear();
+
+private:
+    TessellationCache();
+    void shrink();
+
+private:
+    using Entry = std::pair<TessellationKey, std::shared_ptr<const TessellationData>>;
+    std::mutex mutex;
+    /// The most recently used entry comes first
+    std::list<Entry> entries;
+    std::unordered_map<TessellationKey, std::list<Entry>::iterator> index;
+    std::size_t memSize {0};
+    std::size_t maxSize {0};
+};
+
+/** The PropertyTessellation class holds the tessellation that is currently displayed by
+ * a view provider. If the parameter SaveTessellation is enabled it is written to the project
+ * file together with a hash of the binary representation of the shape. When the project is
+ * loaded again the tessellation is used if the hash of the displayed shape matches, so that
+ * the shapes don't need to be meshed again.
+ */
+class PartGuiExport PropertyTessellation: public App::Property
+{
+    TYPESYSTEM_HEADER_WITH_OVERRIDE();
+
+public:
+    PropertyTessellation();
+    ~PropertyTessellation() override;
+
+    /** Sets the tessellation. Because the property only caches data that can be re-created
+     * from the shape at any time, no change notification is sent.
+     */
+    void setValue(const TessellationKey& key, const std::shared_ptr<const TessellationData>& data);
+    const TessellationKey& getKey() const
+    {
+        return key;
+    }
+    const std::shared_ptr<const TessellationData>& getTessellation() const
+    {
+        return data;
+    }
+    /** Returns the tessellation read from the project file if it has been created for the
+     * geometry and the meshing parameters of \a key, or null otherwise. The restored
+     * tessellation is released in any case.
+     */
+    std::shared_ptr<const TessellationData> takeRestoredTessellation(const TessellationKey& key);
+
+    void Save(Base::Writer& writer) const override;
+    void Restore(Base::XMLReader& reader) override;
+
+    void SaveDocFile(Base::Writer& writer) const override;
+    void RestoreDocFile(Base::Reader& reader) override;
+
+    Property* Copy() const override;
+    void Paste(const Property& from) override;
+    bool isSame(const Property& other) const override;
+    unsigned int getMemSize() const override;
+
+private:
+    TessellationKey key;
+    std::shared_ptr<const TessellationData> data;
+
+    // The tessellation read from the project file, it's not displayed yet
+    TessellationKey restoredKey;
+    std::shared_ptr<const TessellationData> restoredData;
+};
+
+}  // namespace PartGui
+
+#endif  // PARTGUI_TESSELLATIONCACHE_H
@@ -50,7 +50,10 @@
 
 # include <QAction>
 # include <QMenu>
+# include <QtConcurrentMap>
+# include <numeric>
 # include <sstream>
+# include <unordered_map>
 
 # include <Inventor/SoPickedPoint.h>
 # include <Inventor/details/SoFaceDetail.h>
@@ -108,6 +111,87 @@ long toPercent(float value)
 {
     return std::lround(100.0 * value);
 }
+
+template<typename Field, typename T>
+void setFieldValues(Field& field, const std::vector<T>& values)
+{
+    field.setNum(static_cast<int>(values.size()));
+    std::copy(values.begin(), values.end(), field.startEditing());
+    field.finishEditing();
+}
+
+bool useParallelTessellation()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part")
+        ->GetBool("ParallelTessellation", true);
+}
+
+int findRoot(std::vector<int>& parents, int index)
+{
+    while (parents[index] != index) {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+// Keeps the view providers of a document being restored. Their visuals are updated
+// together when the restore has finished.
+class PendingVisuals
+{
+public:
+    static PendingVisuals& instance()
+    {
+        static PendingVisuals visuals;
+        return visuals;
+    }
+
+    void add(const App::Document* doc, ViewProviderPartExt* view)
+    {
+        views[doc].push_back(view);
+    }
+
+    void remove(ViewProviderPartExt* view)
+    {
+        for (auto& it : views) {
+            auto& list = it.second;
+            list.erase(std::remove(list.begin(), list.end(), view), list.end());
+        }
+    }
+
+private:
+    PendingVisuals()
+    {
+        //NOLINTBEGIN
+        App::GetApplication().signalFinishRestoreDocument.connect(
+            [this](const App::Document& doc) {
+                update(doc);
+            });
+        App::GetApplication().signalPendingReloadDocument.connect(
+            [this](const App::Document& doc) {
+                update(doc);
+            });
+        App::GetApplication().signalDeleteDocument.connect([this](const App::Document& doc) {
+            views.erase(&doc);
+        });
+        //NOLINTEND
+    }
+
+    void update(const App::Document& doc)
+    {
+        auto it = views.find(&doc);
+        if (it != views.end()) {
+            std::vector<ViewProviderPartExt*> list;
+            list.swap(it->second);
+            views.erase(it);
+            ViewProviderPartExt::updateVisuals(list);
+        }
+    }
+
+private:
+    std::map<const App::Document*, std::vector<ViewProviderPartExt*>> views;
+};
 }
 
 PROPERTY_SOURCE(PartGui::ViewProviderPartExt, Gui::ViewProviderGeometryObject)
@@ -197,6 +281,8 @@ ViewProviderPartExt::ViewProviderPartExt()
     Lighting.setEnums(LightingEnums);
     ADD_PROPERTY_TYPE(DrawStyle,((long int)0), osgroup, App::Prop_None, "Defines the style of the edges in the 3D view.");
     DrawStyle.setEnums(DrawStyleEnums);
+    ADD_PROPERTY_TYPE(Tessellation,(TessellationKey(), nullptr), osgroup, App::Prop_Hidden,
+            "The tessellation of the displayed shape.");
 
     coords = new SoCoordinate3();
     coords->ref();
@@ -256,6 +342,7 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    PendingVisuals::instance().remove(this);
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -287,13 +374,13 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     // to freeze the GUI
     // https://forum.freecad.org/viewtopic.php?f=3&t=24912&p=195613
     if (prop == &Deviation) {
-        if(isUpdateForced()||Visibility.getValue())
+        if(!isRestoring() && (isUpdateForced()||Visibility.getValue()))
             updateVisual();
         else
             VisualTouched = true;
     }
     if (prop == &AngularDeflection) {
-        if(isUpdateForced()||Visibility.getValue())
+        if(!isRestoring() && (isUpdateForced()||Visibility.getValue()))
             updateVisual();
         else
             VisualTouched = true;
@@ -388,7 +475,8 @@ void ViewProviderPartExt::onChanged(const App::Property* prop)
     }
     else {
         // if the object was invisible and has been changed, recreate the visual
-        if (prop == &Visibility && (isUpdateForced() || Visibility.getValue()) && VisualTouched) {
+        if (prop == &Visibility && !isRestoring() && (isUpdateForced() || Visibility.getValue())
+            && VisualTouched) {
             updateVisual();
             // updateVisual() may not be triggered by any change (e.g.
             // triggered by an external object through forceUpdate()). And
@@ -835,6 +923,7 @@ bool ViewProviderPartExt::loadParameter()
     float deviation = hGrp->GetFloat("MeshDeviation",0.2);
     float angularDeflection = hGrp->GetFloat("MeshAngularDeflection",28.65);
     NormalsFromUV = hGrp->GetBool("NormalsFromUVNodes", NormalsFromUV);
+    Tessellation.setStatus(App::Property::PropNoPersist, !hGrp->GetBool("SaveTessellation", false));
 
     if (Deviation.getValue() != deviation) {
         Deviation.setValue(deviation);
@@ -857,8 +946,9 @@ void ViewProviderPartExt::updateData(const App::Property* prop)
 {
     const char *propName = prop->getName();
     if (propName && (strcmp(propName, "Shape") == 0 || strstr(propName, "Touched"))) {
-        // calculate the visual only if visible
-        if (isUpdateForced() || Visibility.getValue())
+        // calculate the visual only if visible and, while restoring, not before
+        // the stored tessellation has been read
+        if (!isRestoring() && (isUpdateForced() || Visibility.getValue()))
             updateVisual();
         else
             VisualTouched = true;
@@ -880,6 +970,18 @@ void ViewProviderPartExt::startRestoring()
 
 void ViewProviderPartExt::finishRestoring()
 {
+    if (VisualTouched && (isUpdateForced() || Visibility.getValue())) {
+        // While a document is loaded the shapes of all objects are meshed together
+        App::Document* doc = getObject() ? getObject()->getDocument() : nullptr;
+        if (doc && doc->testStatus(App::Document::Restoring)
+            && !doc->testStatus(App::Document::Importing) && useParallelTessellation()) {
+            PendingVisuals::instance().add(doc, this);
+        }
+        else {
+            updateVisual();
+        }
+    }
+
     // The ShapeAppearance property is restored after DiffuseColor
     // and currently sets a single color.
     // In case DiffuseColor has defined multiple colors they will
@@ -935,6 +1037,11 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
 }
 
 void ViewProviderPartExt::updateVisual()
+{
+    updateVisual(Part::Feature::getShape(getObject()), TessellationKey());
+}
+
+void ViewProviderPartExt::updateVisual(const TopoDS_Shape& cShape, TessellationKey key)
 {
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
@@ -951,7 +1058,6 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
 
-    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
     if (cShape.IsNull()) {
         coords  ->point      .setNum(0);
         norm    ->vector     .setNum(0);
@@ -959,382 +1065,534 @@ void ViewProviderPartExt::updateVisual()
         faceset ->partIndex  .setNum(0);
         lineset ->coordIndex .setNum(0);
         nodeset ->startIndex .setValue(0);
+        Tessellation.setValue(TessellationKey(), nullptr);
         VisualTouched = false;
         return;
     }
 
     // time measurement and book keeping
     Base::TimeElapsed start_time;
-    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
-    std::set<int> faceEdges;
+    std::shared_ptr<const TessellationData> data;
 
     try {
-        // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * Deviation.getValue();
-
-        // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
-        // should be displayed.
-        if (deflection < gp::Resolution()) {
-            deflection = Precision::Confusion();
+        if (key.isNull()) {
+            key = createTessellationKey(cShape);
         }
 
-        // For very big objects the computed deflection can become very high and thus leads to a useless
-        // tessellation. To avoid this the upper limit is set to 20.0
-        // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
-        //deflection = std::min(deflection, 20.0);
+        // An unchanged shape doesn't need to be meshed again
+        if (Tessellation.getKey() == key) {
+            data = Tessellation.getTessellation();
+        }
+        if (!data) {
+            data = TessellationCache::instance().find(key);
+        }
+        if (!data) {
+            data = Tessellation.takeRestoredTessellation(key);
+            if (!data) {
+                data = createTessellation(cShape, key.deflection, key.angularDeflection);
+            }
+            TessellationCache::instance().insert(key, data);
+        }
 
-        // create or use the mesh on the data structure
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+        applyTessellation(*data);
+        Tessellation.setValue(key, data);
+    }
+    catch (const Standard_Failure& e) {
+        FC_ERR("Cannot compute Inventor representation for the shape of "
+               << pcObject->getFullName() << ": " << e.GetMessageString());
+    }
+    catch (...) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+    }
 
-#if OCC_VERSION_HEX >= 0x070500
-        IMeshTools_Parameters meshParams;
-        meshParams.Deflection = deflection;
-        meshParams.Relative = Standard_False;
-        meshParams.Angle = AngDeflectionRads;
-        meshParams.InParallel = Standard_True;
-        meshParams.AllowQualityDecrease = Standard_True;
-
-        BRepMesh_IncrementalMesh(cShape, meshParams);
-#else
-        BRepMesh_IncrementalMesh(cShape, deflection, Standard_False, AngDeflectionRads, Standard_True);
-#endif
+#   ifdef FC_DEBUG
+        // printing some information
+        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeElapsed::diffTimeF(start_time,Base::TimeElapsed()));
+        if (data) {
+            Base::Console().Log("Shape tria info: Faces:%d Nodes:%d Triangles:%d IdxVec:%d\n",
+                                int(data->partIndex.size()), int(data->points.size()),
+                                int(data->faceIndex.size() / 4), int(data->lineIndex.size()));
+        }
+#   endif
+    VisualTouched = false;
 
-        // We must reset the location here because the transformation data
-        // are set in the placement property
-        TopLoc_Location aLoc;
-        cShape.Location(aLoc);
-
-        // count triangles and nodes in the mesh
-        TopTools_IndexedMapOfShape faceMap;
-        TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
-        for (int i=1; i <= faceMap.Extent(); i++) {
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
-            }
-            // Note: we must also count empty faces
-            if (!mesh.IsNull()) {
-                numTriangles += mesh->NbTriangles();
-                numNodes     += mesh->NbNodes();
-                numNorms     += mesh->NbNodes();
-            }
+    // The material has to be checked again
+    setHighlightedFaces(ShapeAppearance.getValues());
+    setHighlightedEdges(LineColorArray.getValues());
+    setHighlightedPoints(PointColorArray.getValue());
+}
 
-            TopExp_Explorer xp;
-            for (xp.Init(faceMap(i),TopAbs_EDGE);xp.More();xp.Next()) {
-                faceEdges.insert(Part::ShapeMapHasher{}(xp.Current()));
+TessellationKey ViewProviderPartExt::createTessellationKey(const TopoDS_Shape& cShape) const
+{
+    // calculating the deflection value
+    Bnd_Box bounds;
+    BRepBndLib::Add(cShape, bounds);
+    bounds.SetGap(0.0);
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * Deviation.getValue();
+
+    // Since OCCT 7.6 a value of equal 0 is not allowed any more, this can happen if a single vertex
+    // should be displayed.
+    if (deflection < gp::Resolution()) {
+        deflection = Precision::Confusion();
+    }
+
+    // For very big objects the computed deflection can become very high and thus leads to a useless
+    // tessellation. To avoid this the upper limit is set to 20.0
+    // See also forum: https://forum.freecad.org/viewtopic.php?t=77521
+    //deflection = std::min(deflection, 20.0);
+
+    // create or use the mesh on the data structure
+    Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+
+    return TessellationKey::create(cShape, deflection, AngDeflectionRads, NormalsFromUV);
+}
+
+void ViewProviderPartExt::updateVisuals(const std::vector<ViewProviderPartExt*>& views)
+{
+    struct Job
+    {
+        ViewProviderPartExt* view;
+        TopoDS_Shape shape;
+        TessellationKey key;
+        std::shared_ptr<const TessellationData> data;
+    };
+
+    std::vector<Job> jobs;
+    for (auto view : views) {
+        if (view->VisualTouched && (view->isUpdateForced() || view->Visibility.getValue())) {
+            jobs.push_back({view, Part::Feature::getShape(view->getObject()), {}, nullptr});
+        }
+    }
+
+    // Computing the keys and checking a tessellation that has been read from the project file
+    // only reads the shapes. If it fails updateVisual() reports the error.
+    QtConcurrent::blockingMap(jobs, [](Job& job) {
+        try {
+            if (!job.shape.IsNull()) {
+                job.key = job.view->createTessellationKey(job.shape);
+                job.data = job.view->Tessellation.takeRestoredTessellation(job.key);
             }
-            numFaces++;
+        }
+        catch (...) {
+            job.key = TessellationKey();
+            job.data = nullptr;
+        }
+    });
+
+    // Look for the tessellations that already exist and mesh shapes of equal geometry only once.
+    // Shapes that share a face or an edge are meshed in the same task because the mesher stores
+    // the triangulation in the sub-shapes.
+    std::vector<int> parents(jobs.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    std::vector<int> sources(jobs.size(), -1);
+    std::unordered_map<TessellationKey, int> keys;
+    std::unordered_map<const TopoDS_TShape*, int> subShapes;
+    for (int i = 0; i < static_cast<int>(jobs.size()); i++) {
+        Job& job = jobs[i];
+        if (job.key.isNull()) {
+            continue;
+        }
+        if (job.data) {
+            // the tessellation read from the project file matches the shape
+            TessellationCache::instance().insert(job.key, job.data);
+            continue;
+        }
+        if (job.view->Tessellation.getKey() == job.key) {
+            job.data = job.view->Tessellation.getTessellation();
+        }
+        if (!job.data) {
+            job.data = TessellationCache::instance().find(job.key);
+        }
+        if (job.data) {
+            continue;
+        }
+        auto source = keys.emplace(job.key, i);
+        if (!source.second) {
+            sources[i] = source.first->second;
+            continue;
         }
 
-        // get an indexed map of edges
-        TopTools_IndexedMapOfShape edgeMap;
-        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
-
-         // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
-        std::map<int, std::vector<int32_t> > lineSetMap;
-        std::set<int>          edgeIdxSet;
-        std::vector<int32_t>   edgeVector;
-
-        // count and index the edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            edgeIdxSet.insert(i);
-            numEdges++;
-
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-            // returns a valid object is wrong. This e.g. happens for ruled
-            // surfaces which gets created by two edges or wires.
-            // So, we have to store the hashes of the edges associated to a face.
-            // If the hash of a given edge is not in this list we know it's really
-            // a free edge.
-            int hash = Part::ShapeMapHasher{}(aEdge);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    int nbNodesInEdge = aPoly->NbNodes();
-                    numNodes += nbNodesInEdge;
-                }
+        TopTools_IndexedMapOfShape map;
+        TopExp::MapShapes(job.shape, TopAbs_FACE, map);
+        TopExp::MapShapes(job.shape, TopAbs_EDGE, map);
+        for (int k = 1; k <= map.Extent(); k++) {
+            auto res = subShapes.emplace(map(k).TShape().get(), i);
+            int a = findRoot(parents, i);
+            int b = findRoot(parents, res.first->second);
+            if (a != b) {
+                parents[std::max(a, b)] = std::min(a, b);
             }
         }
+    }
 
-        // handling of the vertices
-        TopTools_IndexedMapOfShape vertexMap;
-        TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
-        numNodes += vertexMap.Extent();
-
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
-
-        int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
-        for (int i=1; i <= faceMap.Extent(); i++, ii++) {
-            TopLoc_Location aLoc;
-            const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
-            // get the mesh of the shape
-            Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
-            if (mesh.IsNull()) {
-                mesh = Part::Tools::triangulationOfFace(actFace);
+    std::map<int, std::vector<int>> groups;
+    for (int i = 0; i < static_cast<int>(jobs.size()); i++) {
+        if (!jobs[i].key.isNull() && !jobs[i].data && sources[i] < 0) {
+            groups[findRoot(parents, i)].push_back(i);
+        }
+    }
+    std::vector<std::vector<int>> tasks;
+    for (auto& it : groups) {
+        tasks.push_back(std::move(it.second));
+    }
+
+    QtConcurrent::blockingMap(tasks, [&jobs](const std::vector<int>& task) {
+        for (int index : task) {
+            Job& job = jobs[index];
+            try {
+                job.data = job.view->createTessellation(job.shape,
+                                                        job.key.deflection,
+                                                        job.key.angularDeflection);
             }
-            if (mesh.IsNull()) {
-                parts[ii] = 0;
-                continue;
+            catch (...) {
+                // updateVisual() tries it again and reports the error
+                job.data = nullptr;
             }
+        }
+    });
 
-            // getting the transformation of the shape/face
-            gp_Trsf myTransf;
-            Standard_Boolean identity = true;
-            if (!aLoc.IsIdentity()) {
-                identity = false;
-                myTransf = aLoc.Transformation();
-            }
+    for (const auto& task : tasks) {
+        for (int index : task) {
+            TessellationCache::instance().insert(jobs[index].key, jobs[index].data);
+        }
+    }
 
-            // getting size of node and triangle array of this face
-            int nbNodesInFace = mesh->NbNodes();
-            int nbTriInFace   = mesh->NbTriangles();
-            // check orientation
-            TopAbs_Orientation orient = actFace.Orientation();
+    // Passing the arrays to the Coin nodes must be done in the GUI thread
+    for (std::size_t i = 0; i < jobs.size(); i++) {
+        Job& job = jobs[i];
+        if (sources[i] >= 0) {
+            job.data = jobs[sources[i]].data;
+        }
+        if (job.data) {
+            job.view->Tessellation.setValue(job.key, job.data);
+        }
+        job.view->updateVisual(job.shape, job.key);
+    }
+}
 
+std::shared_ptr<TessellationData> ViewProviderPartExt::createTessellation(TopoDS_Shape cShape,
+                                                                         double deflection,
+                                                                         double AngDeflectionRads) const
+{
+    int numTriangles=0,numNodes=0,numNorms=0,numFaces=0;
+    std::set<int> faceEdges;
 
-            // cycling through the poly mesh
-#if OCC_VERSION_HEX < 0x070600
-            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-            TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
+#if OCC_VERSION_HEX >= 0x070500
+    IMeshTools_Parameters meshParams;
+    meshParams.Deflection = deflection;
+    meshParams.Relative = Standard_False;
+    meshParams.Angle = AngDeflectionRads;
+    meshParams.InParallel = Standard_True;
+    meshParams.AllowQualityDecrease = Standard_True;
+
+    BRepMesh_IncrementalMesh(cShape, meshParams);
 #else
-            int numNodes =  mesh->NbNodes();
-            TColgp_Array1OfDir Normals (1, numNodes);
+    BRepMesh_IncrementalMesh(cShape, deflection, Standard_False, AngDeflectionRads, Standard_True);
 #endif
-            if (NormalsFromUV)
-                Part::Tools::getPointNormals(actFace, mesh, Normals);
 
-            for (int g=1;g<=nbTriInFace;g++) {
-                // Get the triangle
-                Standard_Integer N1,N2,N3;
+    // We must reset the location here because the transformation data
+    // are set in the placement property
+    TopLoc_Location aLoc;
+    cShape.Location(aLoc);
+
+    // count triangles and nodes in the mesh
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
+    for (int i=1; i <= faceMap.Extent(); i++) {
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
+        }
+        // Note: we must also count empty faces
+        if (!mesh.IsNull()) {
+            numTriangles += mesh->NbTriangles();
+            numNodes     += mesh->NbNodes();
+            numNorms     += mesh->NbNodes();
+        }
+
+        TopExp_Explorer xp;
+        for (xp.Init(faceMap(i),TopAbs_EDGE);xp.More();xp.Next()) {
+            faceEdges.insert(Part::ShapeMapHasher{}(xp.Current()));
+        }
+        numFaces++;
+    }
+
+    // get an indexed map of edges
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
+
+     // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
+    std::map<int, std::vector<int32_t> > lineSetMap;
+    std::set<int>          edgeIdxSet;
+    std::vector<int32_t>   edgeVector;
+
+    // count and index the edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        edgeIdxSet.insert(i);
+
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+        // returns a valid object is wrong. This e.g. happens for ruled
+        // surfaces which gets created by two edges or wires.
+        // So, we have to store the hashes of the edges associated to a face.
+        // If the hash of a given edge is not in this list we know it's really
+        // a free edge.
+        int hash = Part::ShapeMapHasher{}(aEdge);
+        if (faceEdges.find(hash) == faceEdges.end()) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                int nbNodesInEdge = aPoly->NbNodes();
+                numNodes += nbNodesInEdge;
+            }
+        }
+    }
+
+    // handling of the vertices
+    TopTools_IndexedMapOfShape vertexMap;
+    TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
+    numNodes += vertexMap.Extent();
+
+    // create memory for the nodes and indexes and preset the normal vector with null vector
+    auto data = std::make_shared<TessellationData>();
+    data->points.resize(numNodes);
+    data->normals.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+    data->faceIndex.resize(numTriangles*4);
+    data->partIndex.resize(numFaces);
+    // get the raw memory for fast fill up
+    SbVec3f* verts = data->points.data();
+    SbVec3f* norms = data->normals.data();
+    int32_t* index = data->faceIndex.data();
+    int32_t* parts = data->partIndex.data();
+
+    int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
+    for (int i=1; i <= faceMap.Extent(); i++, ii++) {
+        TopLoc_Location aLoc;
+        const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
+        // get the mesh of the shape
+        Handle (Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace,aLoc);
+        if (mesh.IsNull()) {
+            mesh = Part::Tools::triangulationOfFace(actFace);
+        }
+        if (mesh.IsNull()) {
+            parts[ii] = 0;
+            continue;
+        }
+
+        // getting the transformation of the shape/face
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!aLoc.IsIdentity()) {
+            identity = false;
+            myTransf = aLoc.Transformation();
+        }
+
+        // getting size of node and triangle array of this face
+        int nbNodesInFace = mesh->NbNodes();
+        int nbTriInFace   = mesh->NbTriangles();
+        // check orientation
+        TopAbs_Orientation orient = actFace.Orientation();
+
+
+        // cycling through the poly mesh
 #if OCC_VERSION_HEX < 0x070600
-                Triangles(g).Get(N1,N2,N3);
+        const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
+        const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
+        TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
 #else
-                mesh->Triangle(g).Get(N1,N2,N3);
+        int numNodes =  mesh->NbNodes();
+        TColgp_Array1OfDir Normals (1, numNodes);
 #endif
+        if (NormalsFromUV)
+            Part::Tools::getPointNormals(actFace, mesh, Normals);
 
-                // change orientation of the triangle if the face is reversed
-                if ( orient != TopAbs_FORWARD ) {
-                    Standard_Integer tmp = N1;
-                    N1 = N2;
-                    N2 = tmp;
-                }
-
-                // get the 3 points of this triangle
+        for (int g=1;g<=nbTriInFace;g++) {
+            // Get the triangle
+            Standard_Integer N1,N2,N3;
 #if OCC_VERSION_HEX < 0x070600
-                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
+            Triangles(g).Get(N1,N2,N3);
 #else
-                gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
+            mesh->Triangle(g).Get(N1,N2,N3);
 #endif
 
-                // get the 3 normals of this triangle
-                gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
-                    NV1.SetXYZ(Normals(N1).XYZ());
-                    NV2.SetXYZ(Normals(N2).XYZ());
-                    NV3.SetXYZ(Normals(N3).XYZ());
-                }
-                else {
-                    gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
-                           v2(V2.X(),V2.Y(),V2.Z()),
-                           v3(V3.X(),V3.Y(),V3.Z());
-                    gp_Vec normal = (v2-v1)^(v3-v1);
-                    NV1 = normal;
-                    NV2 = normal;
-                    NV3 = normal;
-                }
-
-                // transform the vertices and normals to the place of the face
-                if (!identity) {
-                    V1.Transform(myTransf);
-                    V2.Transform(myTransf);
-                    V3.Transform(myTransf);
-                    if (NormalsFromUV) {
-                        NV1.Transform(myTransf);
-                        NV2.Transform(myTransf);
-                        NV3.Transform(myTransf);
-                    }
-                }
-
-                // add the normals for all points of this triangle
-                norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
-                norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
-                norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
-
-                // set the vertices
-                verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
-                verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
-                verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
-
-                // set the index vector with the 3 point indexes and the end delimiter
-                index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
-                index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
-                index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
-                index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
+            // change orientation of the triangle if the face is reversed
+            if ( orient != TopAbs_FORWARD ) {
+                Standard_Integer tmp = N1;
+                N1 = N2;
+                N2 = tmp;
             }
 
-            parts[ii] = nbTriInFace; // new part
-
-            // handling the edges lying on this face
-            TopExp_Explorer Exp;
-            for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
-                const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
-                // get the overall index of this edge
-                int edgeIndex = edgeMap.FindIndex(curEdge);
-                edgeVector.push_back((int32_t)edgeIndex-1);
-                // already processed this index ?
-                if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-
-                    // this holds the indices of the edge's triangulation to the current polygon
-                    Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                    if (aPoly.IsNull())
-                        continue; // polygon does not exist
-
-                    // getting the indexes of the edge polygon
-                    const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                    for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
-                        int nodeIndex = indices(i);
-                        int index = faceNodeOffset+nodeIndex-1;
-                        lineSetMap[edgeIndex].push_back(index);
-
-                        // usually the coordinates for this edge are already set by the
-                        // triangles of the face this edge belongs to. However, there are
-                        // rare cases where some points are only referenced by the polygon
-                        // but not by any triangle. Thus, we must apply the coordinates to
-                        // make sure that everything is properly set.
+            // get the 3 points of this triangle
 #if OCC_VERSION_HEX < 0x070600
-                        gp_Pnt p(Nodes(nodeIndex));
+            gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
 #else
-                        gp_Pnt p(mesh->Node(nodeIndex));
+            gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
 #endif
-                        if (!identity)
-                            p.Transform(myTransf);
-                        verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
-                    }
 
-                    // remove the handled edge index from the set
-                    edgeIdxSet.erase(edgeIndex);
-                }
+            // get the 3 normals of this triangle
+            gp_Vec NV1, NV2, NV3;
+            if (NormalsFromUV) {
+                NV1.SetXYZ(Normals(N1).XYZ());
+                NV2.SetXYZ(Normals(N2).XYZ());
+                NV3.SetXYZ(Normals(N3).XYZ());
+            }
+            else {
+                gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
+                       v2(V2.X(),V2.Y(),V2.Z()),
+                       v3(V3.X(),V3.Y(),V3.Z());
+                gp_Vec normal = (v2-v1)^(v3-v1);
+                NV1 = normal;
+                NV2 = normal;
+                NV3 = normal;
             }
 
-            edgeVector.push_back(-1);
+            // transform the vertices and normals to the place of the face
+            if (!identity) {
+                V1.Transform(myTransf);
+                V2.Transform(myTransf);
+                V3.Transform(myTransf);
+                if (NormalsFromUV) {
+                    NV1.Transform(myTransf);
+                    NV2.Transform(myTransf);
+                    NV3.Transform(myTransf);
+                }
+            }
 
-            // counting up the per Face offsets
-            faceNodeOffset += nbNodesInFace;
-            faceTriaOffset += nbTriInFace;
+            // add the normals for all points of this triangle
+            norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
+            norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
+            norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
+
+            // set the vertices
+            verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
+            verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
+            verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
+
+            // set the index vector with the 3 point indexes and the end delimiter
+            index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
+            index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
+            index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
+            index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
         }
 
-        // handling of the free edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            Standard_Boolean identity = true;
-            gp_Trsf myTransf;
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            int hash = Part::ShapeMapHasher{}(aEdge);
-            if (faceEdges.find(hash) == faceEdges.end()) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
-                if (!aPoly.IsNull()) {
-                    if (!aLoc.IsIdentity()) {
-                        identity = false;
-                        myTransf = aLoc.Transformation();
-                    }
-
-                    const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                    int nbNodesInEdge = aPoly->NbNodes();
-
-                    gp_Pnt pnt;
-                    for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
-                        pnt = aNodes(j);
-                        if (!identity)
-                            pnt.Transform(myTransf);
-                        int index = faceNodeOffset+j-1;
-                        verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-                        lineSetMap[i].push_back(index);
-                    }
-
-                    faceNodeOffset += nbNodesInEdge;
+        parts[ii] = nbTriInFace; // new part
+
+        // handling the edges lying on this face
+        TopExp_Explorer Exp;
+        for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
+            const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
+            // get the overall index of this edge
+            int edgeIndex = edgeMap.FindIndex(curEdge);
+            edgeVector.push_back((int32_t)edgeIndex-1);
+            // already processed this index ?
+            if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
+
+                // this holds the indices of the edge's triangulation to the current polygon
+                Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
+                if (aPoly.IsNull())
+                    continue; // polygon does not exist
+
+                // getting the indexes of the edge polygon
+                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+                for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
+                    int nodeIndex = indices(i);
+                    int index = faceNodeOffset+nodeIndex-1;
+                    lineSetMap[edgeIndex].push_back(index);
+
+                    // usually the coordinates for this edge are already set by the
+                    // triangles of the face this edge belongs to. However, there are
+                    // rare cases where some points are only referenced by the polygon
+                    // but not by any triangle. Thus, we must apply the coordinates to
+                    // make sure that everything is properly set.
+#if OCC_VERSION_HEX < 0x070600
+                    gp_Pnt p(Nodes(nodeIndex));
+#else
+                    gp_Pnt p(mesh->Node(nodeIndex));
+#endif
+                    if (!identity)
+                        p.Transform(myTransf);
+                    verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
                 }
+
+                // remove the handled edge index from the set
+                edgeIdxSet.erase(edgeIndex);
             }
         }
 
-        nodeset->startIndex.setValue(faceNodeOffset);
-        for (int i=0; i<vertexMap.Extent(); i++) {
-            const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
-            gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
-            verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-        }
+        edgeVector.push_back(-1);
 
-        // normalize all normals
-        for (int i = 0; i< numNorms ;i++)
-            norms[i].normalize();
+        // counting up the per Face offsets
+        faceNodeOffset += nbNodesInFace;
+        faceTriaOffset += nbTriInFace;
+    }
 
-        std::vector<int32_t> lineSetCoords;
-        for (const auto & it : lineSetMap) {
-            lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
-            lineSetCoords.push_back(-1);
-        }
+    // handling of the free edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        Standard_Boolean identity = true;
+        gp_Trsf myTransf;
+        TopLoc_Location aLoc;
 
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
+        // handling of the free edge that are not associated to a face
+        int hash = Part::ShapeMapHasher{}(aEdge);
+        if (faceEdges.find(hash) == faceEdges.end()) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc);
+            if (!aPoly.IsNull()) {
+                if (!aLoc.IsIdentity()) {
+                    identity = false;
+                    myTransf = aLoc.Transformation();
+                }
 
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
+                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
+                int nbNodesInEdge = aPoly->NbNodes();
+
+                gp_Pnt pnt;
+                for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
+                    pnt = aNodes(j);
+                    if (!identity)
+                        pnt.Transform(myTransf);
+                    int index = faceNodeOffset+j-1;
+                    verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+                    lineSetMap[i].push_back(index);
+                }
 
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
+                faceNodeOffset += nbNodesInEdge;
+            }
+        }
     }
-    catch (const Standard_Failure& e) {
-        FC_ERR("Cannot compute Inventor representation for the shape of "
-               << pcObject->getFullName() << ": " << e.GetMessageString());
+
+    data->vertexIndex = faceNodeOffset;
+    for (int i=0; i<vertexMap.Extent(); i++) {
+        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
+        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
+        verts[faceNodeOffset+i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
     }
-    catch (...) {
-        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+
+    // normalize all normals
+    for (int i = 0; i< numNorms ;i++)
+        norms[i].normalize();
+
+    std::vector<int32_t>& lineSetCoords = data->lineIndex;
+    for (const auto & it : lineSetMap) {
+        lineSetCoords.insert(lineSetCoords.end(), it.second.begin(), it.second.end());
+        lineSetCoords.push_back(-1);
     }
 
-#   ifdef FC_DEBUG
-        // printing some information
-        Base::Console().Log("ViewProvider update time: %f s\n",Base::TimeElapsed::diffTimeF(start_time,Base::TimeElapsed()));
-        Base::Console().Log("Shape tria info: Faces:%d Edges:%d Nodes:%d Triangles:%d IdxVec:%d\n",numFaces,numEdges,numNodes,numTriangles,numLines);
-#   else
-    (void)numEdges;
-#   endif
-    VisualTouched = false;
+    return data;
+}
 
-    // The material has to be checked again
-    setHighlightedFaces(ShapeAppearance.getValues());
-    setHighlightedEdges(LineColorArray.getValues());
-    setHighlightedPoints(PointColorArray.getValue());
+void ViewProviderPartExt::applyTessellation(const TessellationData& data)
+{
+    setFieldValues(coords->point, data.points);
+    setFieldValues(norm->vector, data.normals);
+    setFieldValues(faceset->coordIndex, data.faceIndex);
+    setFieldValues(faceset->partIndex, data.partIndex);
+    setFieldValues(lineset->coordIndex, data.lineIndex);
+    nodeset->startIndex.setValue(data.vertexIndex);
 }
 
 void ViewProviderPartExt::forceUpdate(bool enable) {
@@ -24,6 +24,7 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include <map>
+#include <vector>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -32,6 +33,8 @@
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/PartGlobal.h>
 
+#include "TessellationCache.h"
+
 
 class TopoDS_Shape;
 class TopoDS_Edge;
@@ -86,6 +89,8 @@ public:
     App::PropertyColor LineColor;
     App::PropertyMaterial LineMaterial;
     App::PropertyColorList LineColorArray;
+    // Tessellation
+    PropertyTessellation Tessellation;
 
     void attach(App::DocumentObject *) override;
     void setDisplayMode(const char* ModeName) override;
@@ -104,6 +109,12 @@ public:
     void finishRestoring() override;
     //@}
 
+    /** Updates the visual of several view providers at once. The shapes are meshed
+     * concurrently, except for shapes that share faces or edges. These are meshed one after
+     * another because the mesher stores the triangulation in the shared sub-shapes.
+     */
+    static void updateVisuals(const std::vector<ViewProviderPartExt*>& views);
+
     /** @name Selection handling
      * This group of methods do the selection handling.
      * Here you can define how the selection for your ViewProfider
@@ -163,6 +174,16 @@ protected:
     void onChanged(const App::Property* prop) override;
     bool loadParameter();
     void updateVisual();
+    /// Updates the visual with \a shape. If \a key is null it's computed from the shape.
+    void updateVisual(const TopoDS_Shape& shape, TessellationKey key);
+    /// Returns the key of the tessellation of \a shape with the current meshing parameters
+    TessellationKey createTessellationKey(const TopoDS_Shape& shape) const;
+    /// Meshes the shape and creates the arrays of the Coin nodes
+    std::shared_ptr<TessellationData> createTessellation(TopoDS_Shape shape,
+                                                         double deflection,
+                                                         double angularDeflection) const;
+    /// Passes the arrays to the Coin nodes
+    void applyTessellation(const TessellationData& data);
     void handleChangedPropertyName(Base::XMLReader& reader,
                                    const char* TypeName,
                                    const char* PropName) override;
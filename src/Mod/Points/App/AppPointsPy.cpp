@@ -36,6 +36,7 @@
 
 #include "Points.h"
 #include "PointsAlgos.h"
+#include "PointsFilter.h"
 #include "PointsPy.h"
 #include "Properties.h"
 #include "Structured.h"
@@ -56,6 +57,22 @@ public:
                            &Module::show,
                            "show(points,[string]) -- Add the points to the active document or "
                            "create one if no document exists.  Returns document object.");
+        add_varargs_method("filterVoxelGrid",
+                           &Module::filterVoxelGrid,
+                           "filterVoxelGrid(object, dimX, [dimY, dimZ]) -- Replace the points of "
+                           "each voxel by their centroid.\n"
+                           "Normals, intensities and colors of the object are averaged as well.");
+        add_varargs_method("removeStatisticalOutliers",
+                           &Module::removeStatisticalOutliers,
+                           "removeStatisticalOutliers(object, meanK, stddevMul) -- Remove the "
+                           "points whose mean distance to their k nearest neighbours\n"
+                           "exceeds the global mean distance by more than stddevMul standard "
+                           "deviations. Returns the number of removed points.");
+        add_varargs_method("removeRadiusOutliers",
+                           &Module::removeRadiusOutliers,
+                           "removeRadiusOutliers(object, radius, minNeighbours) -- Remove the "
+                           "points that have less than minNeighbours\n"
+                           "neighbours within radius. Returns the number of removed points.");
         initialize("This module is the Points module.");  // register with Python
     }
 
@@ -426,6 +443,147 @@ private:
 
         return Py::None();
     }
+
+    Points::Feature* getScatteredFeature(PyObject* object) const
+    {
+        App::DocumentObject* obj =
+            static_cast<App::DocumentObjectPy*>(object)->getDocumentObjectPtr();
+        auto fea = dynamic_cast<Points::Feature*>(obj);
+        if (!fea) {
+            throw Py::TypeError("Object is not a points feature");
+        }
+        // removing points destroys the grid structure
+        if (fea->isDerivedFrom<Points::Structured>()) {
+            throw Py::TypeError("Filtering of structured points is not supported");
+        }
+        return fea;
+    }
+
+    void removeOutliers(Points::Feature* fea, const std::vector<unsigned long>& outliers) const
+    {
+        if (outliers.empty()) {
+            return;
+        }
+
+        // only attributes with a value for each point can be filtered
+        std::size_t count = fea->Points.getValue().size();
+        fea->Points.removeIndices(outliers);
+        auto normals = dynamic_cast<PropertyNormalList*>(fea->getPropertyByName("Normal"));
+        if (normals && normals->getSize() == static_cast<int>(count)) {
+            normals->removeIndices(outliers);
+        }
+        auto grey = dynamic_cast<PropertyGreyValueList*>(fea->getPropertyByName("Intensity"));
+        if (grey && grey->getSize() == static_cast<int>(count)) {
+            grey->removeIndices(outliers);
+        }
+        auto colors = dynamic_cast<App::PropertyColorList*>(fea->getPropertyByName("Color"));
+        if (colors && colors->getSize() == static_cast<int>(count)) {
+            // PropertyColorList has no removeIndices(), the outliers are sorted
+            std::vector<App::Color> remainValue;
+            remainValue.reserve(count - outliers.size());
+            auto pos = outliers.begin();
+            for (std::size_t index = 0; index < count; index++) {
+                if (pos != outliers.end() && *pos == index) {
+                    ++pos;
+                }
+                else {
+                    remainValue.push_back((*colors)[index]);
+                }
+            }
+            colors->setValues(remainValue);
+        }
+    }
+
+    Py::Object filterVoxelGrid(const Py::Tuple& args)
+    {
+        PyObject* object {};
+        double dimX {};
+        double dimY {};
+        double dimZ {};
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "O!d|dd",
+                              &(App::DocumentObjectPy::Type),
+                              &object,
+                              &dimX,
+                              &dimY,
+                              &dimZ)) {
+            throw Py::Exception();
+        }
+
+        if (dimY == 0) {
+            dimY = dimX;
+        }
+        if (dimZ == 0) {
+            dimZ = dimX;
+        }
+
+        try {
+            Points::Feature* fea = getScatteredFeature(object);
+            PointKernel kernel;
+            PointAttributes attr;
+            VoxelGrid voxel(dimX, dimY, dimZ);
+            voxel.filter(fea->Points.getValue(), PointAttributes::fromObject(fea), kernel, attr);
+            fea->Points.setValue(kernel);
+            attr.toObject(fea);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object removeStatisticalOutliers(const Py::Tuple& args)
+    {
+        PyObject* object {};
+        int meanK {};
+        double stddevMul {};
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "O!id",
+                              &(App::DocumentObjectPy::Type),
+                              &object,
+                              &meanK,
+                              &stddevMul)) {
+            throw Py::Exception();
+        }
+
+        try {
+            Points::Feature* fea = getScatteredFeature(object);
+            StatisticalOutlierRemoval filter(meanK, stddevMul);
+            std::vector<unsigned long> outliers = filter.outliers(fea->Points.getValue());
+            removeOutliers(fea, outliers);
+            return Py::Long(static_cast<unsigned long>(outliers.size()));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
+
+    Py::Object removeRadiusOutliers(const Py::Tuple& args)
+    {
+        PyObject* object {};
+        double radius {};
+        int minNeighbours {};
+        if (!PyArg_ParseTuple(args.ptr(),
+                              "O!di",
+                              &(App::DocumentObjectPy::Type),
+                              &object,
+                              &radius,
+                              &minNeighbours)) {
+            throw Py::Exception();
+        }
+
+        try {
+            Points::Feature* fea = getScatteredFeature(object);
+            RadiusOutlierRemoval filter(radius, minNeighbours);
+            std::vector<unsigned long> outliers = filter.outliers(fea->Points.getValue());
+            removeOutliers(fea, outliers);
+            return Py::Long(static_cast<unsigned long>(outliers.size()));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
 };
 
 PyObject* initModule()
@@ -0,0 +1,512 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#endif
+
+#include <App/DocumentObject.h>
+#include <App/PropertyStandard.h>
+#include <Base/BoundBox.h>
+#include <Base/Exception.h>
+
+#include "PointsFilter.h"
+#include "Properties.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+bool isValid(const PointKernel::value_type& pnt)
+{
+    return !(std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z));
+}
+
+std::vector<unsigned long> makeIndices(std::size_t count)
+{
+    std::vector<unsigned long> indices(count);
+    std::iota(indices.begin(), indices.end(), 0UL);
+    return indices;
+}
+
+// Number of bits per axis used to encode a cell position into a single key
+constexpr int CellBits = 21;
+constexpr long CellMax = (1L << CellBits) - 1;
+
+using CellKey = std::uint64_t;
+
+CellKey makeKey(long x, long y, long z)
+{
+    return (static_cast<CellKey>(x) << (2 * CellBits)) | (static_cast<CellKey>(y) << CellBits)
+        | static_cast<CellKey>(z);
+}
+
+/*!
+ * A sparse uniform grid over the valid points of a kernel that is used for neighbour queries.
+ * Unlike PointsGrid it only stores the occupied cells and is therefore suitable for large and
+ * unevenly distributed scans. After construction the grid is read-only and can be queried from
+ * several threads.
+ */
+class NeighbourGrid
+{
+public:
+    NeighbourGrid(const std::vector<PointKernel::value_type>& pts, double cellSize)
+        : points(pts)
+        , cellSize(cellSize)
+    {
+        for (const auto& pnt : points) {
+            if (isValid(pnt)) {
+                bbox.Add(Base::Vector3d(pnt.x, pnt.y, pnt.z));
+            }
+        }
+
+        if (!bbox.IsValid()) {
+            return;
+        }
+
+        double extent = std::max({bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()});
+        if (extent / this->cellSize > double(CellMax)) {
+            this->cellSize = extent / double(CellMax);
+        }
+
+        std::vector<std::pair<CellKey, unsigned long>> keys;
+        keys.reserve(points.size());
+        for (std::size_t index = 0; index < points.size(); index++) {
+            const auto& pnt = points[index];
+            if (isValid(pnt)) {
+                long x {}, y {}, z {};
+                position(pnt, x, y, z);
+                keys.emplace_back(makeKey(x, y, z), static_cast<unsigned long>(index));
+            }
+        }
+
+        std::sort(keys.begin(), keys.end());
+
+        sorted.reserve(keys.size());
+        for (std::size_t index = 0; index < keys.size(); index++) {
+            sorted.push_back(keys[index].second);
+            if (index == 0 || keys[index].first != keys[index - 1].first) {
+                cells[keys[index].first] = std::make_pair(index, index + 1);
+            }
+            else {
+                cells[keys[index].first].second = index + 1;
+            }
+        }
+    }
+
+    /// Returns the number of other points inside the sphere around the point with \a index
+    std::size_t countInRadius(unsigned long index, double radius, std::size_t maxCount) const
+    {
+        const auto& pnt = points[index];
+        long cx {}, cy {}, cz {};
+        position(pnt, cx, cy, cz);
+
+        long ring = static_cast<long>(std::ceil(radius / cellSize));
+        double radius2 = radius * radius;
+        std::size_t count = 0;
+        for (long x = std::max(0L, cx - ring); x <= std::min(CellMax, cx + ring); x++) {
+            for (long y = std::max(0L, cy - ring); y <= std::min(CellMax, cy + ring); y++) {
+                for (long z = std::max(0L, cz - ring); z <= std::min(CellMax, cz + ring); z++) {
+                    auto it = cells.find(makeKey(x, y, z));
+                    if (it == cells.end()) {
+                        continue;
+                    }
+                    for (std::size_t i = it->second.first; i < it->second.second; i++) {
+                        unsigned long other = sorted[i];
+                        if (other != index && Base::DistanceP2(pnt, points[other]) <= radius2) {
+                            if (++count >= maxCount) {
+                                return count;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /// Returns the mean distance to the \a k nearest neighbours of the point with \a index
+    double meanDistance(unsigned long index, std::size_t k) const
+    {
+        const auto& pnt = points[index];
+        long cx {}, cy {}, cz {};
+        position(pnt, cx, cy, cz);
+
+        // max-heap of the squared distances of the k nearest points found so far
+        std::priority_queue<double> nearest;
+        auto visit = [&](long x, long y, long z) {
+            if (x < 0 || y < 0 || z < 0 || x > CellMax || y > CellMax || z > CellMax) {
+                return;
+            }
+            auto it = cells.find(makeKey(x, y, z));
+            if (it == cells.end()) {
+                return;
+            }
+            for (std::size_t i = it->second.first; i < it->second.second; i++) {
+                unsigned long other = sorted[i];
+                if (other == index) {
+                    continue;
+                }
+                double dist2 = Base::DistanceP2(pnt, points[other]);
+                if (nearest.size() < k) {
+                    nearest.push(dist2);
+                }
+                else if (dist2 < nearest.top()) {
+                    nearest.pop();
+                    nearest.push(dist2);
+                }
+            }
+        };
+
+        long maxRing = static_cast<long>(std::ceil(
+            std::max({bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()}) / cellSize)) + 1;
+        for (long ring = 0; ring <= maxRing; ring++) {
+            // visit only the shell of the cube with the given ring distance
+            for (long x = cx - ring; x <= cx + ring; x++) {
+                for (long y = cy - ring; y <= cy + ring; y++) {
+                    bool shell = (x == cx - ring || x == cx + ring || y == cy - ring
+                                  || y == cy + ring);
+                    if (shell) {
+                        for (long z = cz - ring; z <= cz + ring; z++) {
+                            visit(x, y, z);
+                        }
+                    }
+                    else {
+                        visit(x, y, cz - ring);
+                        visit(x, y, cz + ring);
+                    }
+                }
+            }
+
+            // all points not visited yet are at least this far away
+            double minDist = double(ring) * cellSize;
+            if (nearest.size() == k && nearest.top() <= minDist * minDist) {
+                break;
+            }
+        }
+
+        if (nearest.empty()) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        std::size_t count = nearest.size();
+        while (!nearest.empty()) {
+            sum += std::sqrt(nearest.top());
+            nearest.pop();
+        }
+
+        return sum / double(count);
+    }
+
+private:
+    void position(const PointKernel::value_type& pnt, long& x, long& y, long& z) const
+    {
+        x = std::clamp(static_cast<long>((pnt.x - bbox.MinX) / cellSize), 0L, CellMax);
+        y = std::clamp(static_cast<long>((pnt.y - bbox.MinY) / cellSize), 0L, CellMax);
+        z = std::clamp(static_cast<long>((pnt.z - bbox.MinZ) / cellSize), 0L, CellMax);
+    }
+
+private:
+    const std::vector<PointKernel::value_type>& points;
+    double cellSize;
+    Base::BoundBox3d bbox;
+    std::vector<unsigned long> sorted;
+    std::unordered_map<CellKey, std::pair<std::size_t, std::size_t>> cells;
+};
+
+/// Estimates a cell size so that a cell holds about \a perCell points on average
+double estimateCellSize(const std::vector<PointKernel::value_type>& points, std::size_t perCell)
+{
+    Base::BoundBox3d bbox;
+    std::size_t count = 0;
+    for (const auto& pnt : points) {
+        if (isValid(pnt)) {
+            bbox.Add(Base::Vector3d(pnt.x, pnt.y, pnt.z));
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return 1.0;
+    }
+
+    double extent = std::max({bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()});
+    if (extent <= 0.0) {
+        return 1.0;
+    }
+
+    // scans are often flat, so avoid that a degenerated axis lets the volume vanish
+    double minExtent = 0.01 * extent;
+    double volume = std::max(bbox.LengthX(), minExtent) * std::max(bbox.LengthY(), minExtent)
+        * std::max(bbox.LengthZ(), minExtent);
+    return std::cbrt(volume * double(perCell) / double(count));
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+PointAttributes PointAttributes::fromObject(const App::DocumentObject* obj)
+{
+    PointAttributes attr;
+    if (auto normals = dynamic_cast<PropertyNormalList*>(obj->getPropertyByName("Normal"))) {
+        attr.normals = normals->getValues();
+    }
+    if (auto grey = dynamic_cast<PropertyGreyValueList*>(obj->getPropertyByName("Intensity"))) {
+        attr.intensity = grey->getValues();
+    }
+    if (auto colors = dynamic_cast<App::PropertyColorList*>(obj->getPropertyByName("Color"))) {
+        attr.colors = colors->getValues();
+    }
+    return attr;
+}
+
+void PointAttributes::toObject(App::DocumentObject* obj) const
+{
+    if (auto prop = dynamic_cast<PropertyNormalList*>(obj->getPropertyByName("Normal"))) {
+        prop->setValues(normals);
+    }
+    if (auto prop = dynamic_cast<PropertyGreyValueList*>(obj->getPropertyByName("Intensity"))) {
+        prop->setValues(intensity);
+    }
+    if (auto prop = dynamic_cast<App::PropertyColorList*>(obj->getPropertyByName("Color"))) {
+        prop->setValues(colors);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+VoxelGrid::VoxelGrid(double dimX, double dimY, double dimZ)
+    : dimX(dimX)
+    , dimY(dimY)
+    , dimZ(dimZ)
+{
+    if (dimX <= 0.0 || dimY <= 0.0 || dimZ <= 0.0) {
+        throw Base::ValueError("Voxel dimensions must be positive");
+    }
+}
+
+void VoxelGrid::filter(const PointKernel& input,
+                       const PointAttributes& inputAttr,
+                       PointKernel& output,
+                       PointAttributes& outputAttr) const
+{
+    const std::vector<PointKernel::value_type>& points = input.getBasicPoints();
+    bool hasNormals = inputAttr.normals.size() == points.size();
+    bool hasIntensity = inputAttr.intensity.size() == points.size();
+    bool hasColors = inputAttr.colors.size() == points.size();
+
+    Base::BoundBox3d bbox;
+    for (const auto& pnt : points) {
+        if (isValid(pnt)) {
+            bbox.Add(Base::Vector3d(pnt.x, pnt.y, pnt.z));
+        }
+    }
+
+    std::vector<PointKernel::value_type> centroids;
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> intensity;
+    std::vector<App::Color> colors;
+
+    if (bbox.IsValid()) {
+        if (bbox.LengthX() / dimX > double(CellMax) || bbox.LengthY() / dimY > double(CellMax)
+            || bbox.LengthZ() / dimZ > double(CellMax)) {
+            throw Base::ValueError("Voxel dimensions are too small for the extent of the points");
+        }
+
+        // compute the voxel of each point in parallel
+        std::vector<std::pair<CellKey, unsigned long>> keys(points.size());
+        std::vector<unsigned long> indices = makeIndices(points.size());
+        QtConcurrent::blockingMap(indices, [&](unsigned long index) {
+            const auto& pnt = points[index];
+            if (isValid(pnt)) {
+                auto x = static_cast<long>((pnt.x - bbox.MinX) / dimX);
+                auto y = static_cast<long>((pnt.y - bbox.MinY) / dimY);
+                auto z = static_cast<long>((pnt.z - bbox.MinZ) / dimZ);
+                keys[index] = std::make_pair(makeKey(x, y, z), index);
+            }
+            else {
+                keys[index] = std::make_pair(std::numeric_limits<CellKey>::max(), index);
+            }
+        });
+
+        std::sort(keys.begin(), keys.end());
+        while (!keys.empty() && keys.back().first == std::numeric_limits<CellKey>::max()) {
+            keys.pop_back();
+        }
+
+        // the ranges of points falling into the same voxel
+        std::vector<std::pair<std::size_t, std::size_t>> voxels;
+        for (std::size_t index = 0; index < keys.size(); index++) {
+            if (index == 0 || keys[index].first != keys[index - 1].first) {
+                voxels.emplace_back(index, index + 1);
+            }
+            else {
+                voxels.back().second = index + 1;
+            }
+        }
+
+        centroids.resize(voxels.size());
+        if (hasNormals) {
+            normals.resize(voxels.size());
+        }
+        if (hasIntensity) {
+            intensity.resize(voxels.size());
+        }
+        if (hasColors) {
+            colors.resize(voxels.size());
+        }
+
+        std::vector<unsigned long> voxelIndices = makeIndices(voxels.size());
+        QtConcurrent::blockingMap(voxelIndices, [&](unsigned long voxel) {
+            std::size_t first = voxels[voxel].first;
+            std::size_t last = voxels[voxel].second;
+            double count = double(last - first);
+
+            Base::Vector3d center;
+            Base::Vector3d normal;
+            double grey = 0.0;
+            double red = 0.0, green = 0.0, blue = 0.0, alpha = 0.0;
+            for (std::size_t i = first; i < last; i++) {
+                unsigned long index = keys[i].second;
+                const auto& pnt = points[index];
+                center += Base::Vector3d(pnt.x, pnt.y, pnt.z);
+                if (hasNormals) {
+                    const auto& nor = inputAttr.normals[index];
+                    normal += Base::Vector3d(nor.x, nor.y, nor.z);
+                }
+                if (hasIntensity) {
+                    grey += inputAttr.intensity[index];
+                }
+                if (hasColors) {
+                    const App::Color& col = inputAttr.colors[index];
+                    red += col.r;
+                    green += col.g;
+                    blue += col.b;
+                    alpha += col.a;
+                }
+            }
+
+            center /= count;
+            centroids[voxel] = Base::toVector<float>(center);
+            if (hasNormals) {
+                normal.Normalize();
+                normals[voxel] = Base::toVector<float>(normal);
+            }
+            if (hasIntensity) {
+                intensity[voxel] = static_cast<float>(grey / count);
+            }
+            if (hasColors) {
+                colors[voxel] = App::Color(static_cast<float>(red / count),
+                                           static_cast<float>(green / count),
+                                           static_cast<float>(blue / count),
+                                           static_cast<float>(alpha / count));
+            }
+        });
+    }
+
+    output.setTransform(input.getTransform());
+    output.swap(centroids);
+    outputAttr.normals.swap(normals);
+    outputAttr.intensity.swap(intensity);
+    outputAttr.colors.swap(colors);
+}
+
+// ----------------------------------------------------------------------------
+
+StatisticalOutlierRemoval::StatisticalOutlierRemoval(int meanK, double stddevMul)
+    : meanK(meanK)
+    , stddevMul(stddevMul)
+{
+    if (meanK < 1) {
+        throw Base::ValueError("Number of neighbours must be at least one");
+    }
+}
+
+std::vector<unsigned long> StatisticalOutlierRemoval::outliers(const PointKernel& points) const
+{
+    // distances are invariant under the placement so work on the untransformed points
+    const std::vector<PointKernel::value_type>& pts = points.getBasicPoints();
+    NeighbourGrid grid(pts, estimateCellSize(pts, static_cast<std::size_t>(meanK)));
+
+    std::vector<double> meanDist(pts.size(), 0.0);
+    std::vector<unsigned long> indices = makeIndices(pts.size());
+    QtConcurrent::blockingMap(indices, [&](unsigned long index) {
+        if (isValid(pts[index])) {
+            meanDist[index] = grid.meanDistance(index, static_cast<std::size_t>(meanK));
+        }
+    });
+
+    double sum = 0.0;
+    double sum2 = 0.0;
+    std::size_t count = 0;
+    for (std::size_t index = 0; index < pts.size(); index++) {
+        if (isValid(pts[index])) {
+            sum += meanDist[index];
+            sum2 += meanDist[index] * meanDist[index];
+            count++;
+        }
+    }
+
+    double mean = count > 0 ? sum / double(count) : 0.0;
+    double variance = count > 1 ? (sum2 - sum * mean) / double(count - 1) : 0.0;
+    double threshold = mean + stddevMul * std::sqrt(std::max(variance, 0.0));
+
+    std::vector<unsigned long> result;
+    for (std::size_t index = 0; index < pts.size(); index++) {
+        if (!isValid(pts[index]) || meanDist[index] > threshold) {
+            result.push_back(static_cast<unsigned long>(index));
+        }
+    }
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+RadiusOutlierRemoval::RadiusOutlierRemoval(double radius, int minNeighbours)
+    : radius(radius)
+    , minNeighbours(minNeighbours)
+{
+    if (radius <= 0.0) {
+        throw Base::ValueError("Search radius must be positive");
+    }
+}
+
+std::vector<unsigned long> RadiusOutlierRemoval::outliers(const PointKernel& points) const
+{
+    const std::vector<PointKernel::value_type>& pts = points.getBasicPoints();
+    NeighbourGrid grid(pts, radius);
+
+    std::size_t required = static_cast<std::size_t>(std::max(minNeighbours, 0));
+    std::vector<char> outlier(pts.size(), 0);
+    std::vector<unsigned long> indices = makeIndices(pts.size());
+    QtConcurrent::blockingMap(indices, [&](unsigned long index) {
+        if (!isValid(pts[index])) {
+            outlier[index] = 1;
+        }
+        else if (required > 0 && grid.countInRadius(index, radius, required) < required) {
+            outlier[index] = 1;
+        }
+    });
+
+    std::vector<unsigned long> result;
+    for (std::size_t index = 0; index < pts.size(); index++) {
+        if (outlier[index]) {
+            result.push_back(static_cast<unsigned long>(index));
+        }
+    }
+
+    return result;
+}
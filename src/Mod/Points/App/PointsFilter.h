@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef POINTS_FILTER_H
+#define POINTS_FILTER_H
+
+#include <vector>
+
+#include <App/Color.h>
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace App
+{
+class DocumentObject;
+}
+
+namespace Points
+{
+
+/** Optional per-point data that is carried along by the filters.
+ * An empty container means the attribute is not available. A non-empty container must have
+ * the same size as the point kernel it belongs to.
+ */
+struct PointsExport PointAttributes
+{
+    std::vector<Base::Vector3f> normals;
+    std::vector<float> intensity;
+    std::vector<App::Color> colors;
+
+    /** Reads the "Normal", "Intensity" and "Color" properties of a points feature. */
+    static PointAttributes fromObject(const App::DocumentObject* obj);
+    /** Writes all attributes to the matching properties of a points feature. An empty
+     * attribute clears its property, so that no property keeps data for other points.
+     */
+    void toObject(App::DocumentObject* obj) const;
+};
+
+/** The VoxelGrid class downsamples a point cloud by replacing all points inside a voxel
+ * with their centroid. Normals, intensities and colors are averaged the same way.
+ * The voxels are aligned to the local coordinate system of the point kernel.
+ * Points with NaN coordinates are dropped.
+ */
+class PointsExport VoxelGrid
+{
+public:
+    VoxelGrid(double dimX, double dimY, double dimZ);
+
+    /** Computes the downsampled cloud of \a input and stores it in \a output.
+     * The placement of \a input is kept.
+     */
+    void filter(const PointKernel& input,
+                const PointAttributes& inputAttr,
+                PointKernel& output,
+                PointAttributes& outputAttr) const;
+
+private:
+    double dimX;
+    double dimY;
+    double dimZ;
+};
+
+/** The StatisticalOutlierRemoval class computes for each point the mean distance to its
+ * \a meanK nearest neighbours. All points whose mean distance is outside the interval defined
+ * by the global mean and standard deviation multiplied with \a stddevMul are considered as
+ * outliers.
+ */
+class PointsExport StatisticalOutlierRemoval
+{
+public:
+    StatisticalOutlierRemoval(int meanK, double stddevMul);
+
+    /** Returns the sorted indices of the outliers of \a points. Points with NaN coordinates
+     * are always reported.
+     */
+    std::vector<unsigned long> outliers(const PointKernel& points) const;
+
+private:
+    int meanK;
+    double stddevMul;
+};
+
+/** The RadiusOutlierRemoval class considers all points as outliers that have less than
+ * \a minNeighbours other points inside the sphere with \a radius.
+ */
+class PointsExport RadiusOutlierRemoval
+{
+public:
+    RadiusOutlierRemoval(double radius, int minNeighbours);
+
+    /** Returns the sorted indices of the outliers of \a points. Points with NaN coordinates
+     * are always reported.
+     */
+    std::vector<unsigned long> outliers(const PointKernel& points) const;
+
+private:
+    double radius;
+    int minNeighbours;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_FILTER_H
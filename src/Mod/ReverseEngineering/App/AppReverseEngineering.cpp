@@ -22,6 +22,8 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <memory>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColgp_Array1OfPnt.hxx>
 #endif
@@ -33,10 +35,10 @@
 #include <Base/PyWrapParseTupleAndKeywords.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/Part/App/BSplineSurfacePy.h>
+#include <Mod/Points/App/PointsFilter.h>
 #include <Mod/Points/App/PointsPy.h>
 #if defined(HAVE_PCL_FILTERS)
 #include <pcl/filters/passthrough.h>
-#include <pcl/filters/voxel_grid.h>
 #include <pcl/point_types.h>
 #endif
 
@@ -120,10 +122,11 @@ public:
             "fitBSpline(PointKernel)."
         );
 #endif
-#if defined(HAVE_PCL_FILTERS)
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
-            "filterVoxelGrid(dim)."
+            "filterVoxelGrid(Points, DimX, [DimY, DimZ]) -> Points\n"
+            "Replaces the points inside each voxel by their centroid."
         );
+#if defined(HAVE_PCL_FILTERS)
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
@@ -749,7 +752,6 @@ Mesh.show(m)
         throw Py::RuntimeError("Computation of B-spline surface failed");
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object filterVoxelGrid(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -771,28 +773,18 @@ Mesh.show(m)
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
 
-        pcl::PointCloud<pcl::PointXYZ>::Ptr cloud (new pcl::PointCloud<pcl::PointXYZ>);
-        cloud->reserve(points->size());
-        for (Points::PointKernel::const_iterator it = points->begin(); it != points->end(); ++it) {
-            cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
+        try {
+            // the native filter works directly on the kernel without copying it into a PCL cloud
+            Points::VoxelGrid voxG(voxDimX, voxDimY, voxDimZ);
+            Points::PointAttributes attr;
+            std::unique_ptr<Points::PointKernel> points_sample(new Points::PointKernel());
+            voxG.filter(*points, Points::PointAttributes(), *points_sample, attr);
+            return Py::asObject(new Points::PointsPy(points_sample.release()));
         }
-
-        // Create the filtering object
-        pcl::PointCloud<pcl::PointXYZ>::Ptr cloud_downSmpl (new pcl::PointCloud<pcl::PointXYZ>);
-        pcl::VoxelGrid<pcl::PointXYZ> voxG;
-        voxG.setInputCloud (cloud);
-        voxG.setLeafSize (voxDimX, voxDimY, voxDimZ);
-        voxG.filter (*cloud_downSmpl);
-
-        Points::PointKernel* points_sample = new Points::PointKernel();
-        points_sample->reserve(cloud_downSmpl->size());
-        for (pcl::PointCloud<pcl::PointXYZ>::const_iterator it = cloud_downSmpl->begin();it!=cloud_downSmpl->end();++it) {
-            points_sample->push_back(Base::Vector3d(it->x,it->y,it->z));
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
         }
-
-        return Py::asObject(new Points::PointsPy(points_sample));
     }
-#endif
 #if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <boost/functional/hash.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#endif
+
+#include <Mod/Points/App/Points.h>
+
+#if defined(HAVE_PCL_FILTERS)
+#include <pcl/features/normal_3d_omp.h>
+#include <pcl/search/kdtree.h>
+
+#include "PointCloudCache.h"
+
+
+using namespace Reen;
+
+namespace
+{
+// Keep only a few clouds because every entry holds a copy of the points
+constexpr std::size_t MaxEntries = 4;
+// Keep only a few normal sets of a cloud because each of them is as large as the cloud
+constexpr std::size_t MaxNormals = 4;
+
+std::mutex cacheMutex;
+std::list<std::pair<std::size_t, std::shared_ptr<PointCloudCache::Entry>>> cacheEntries;
+}  // namespace
+
+std::size_t PointCloudCache::hash(const Points::PointKernel& kernel)
+{
+    std::size_t seed = kernel.size();
+    double mat[16];
+    kernel.getTransform().getMatrix(mat);
+    boost::hash_range(seed, mat, mat + 16);
+    for (const auto& it : kernel.getBasicPoints()) {
+        boost::hash_combine(seed, it.x);
+        boost::hash_combine(seed, it.y);
+        boost::hash_combine(seed, it.z);
+    }
+    return seed;
+}
+
+std::shared_ptr<PointCloudCache::Entry> PointCloudCache::get(const Points::PointKernel& kernel)
+{
+    std::size_t key = hash(kernel);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto it = cacheEntries.begin(); it != cacheEntries.end(); ++it) {
+        if (it->first == key && it->second->matches(kernel)) {
+            // move to the front as most recently used entry
+            cacheEntries.splice(cacheEntries.begin(), cacheEntries, it);
+            return it->second;
+        }
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->cloud.reset(new pcl::PointCloud<pcl::PointXYZ>);
+    entry->cloud->reserve(kernel.size());
+    entry->indices.reserve(kernel.size());
+    int index = 0;
+    for (Points::PointKernel::const_iterator it = kernel.begin(); it != kernel.end();
+         ++it, ++index) {
+        if (!boost::math::isnan(it->x) && !boost::math::isnan(it->y)
+            && !boost::math::isnan(it->z)) {
+            entry->cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
+            entry->indices.push_back(index);
+        }
+    }
+
+    entry->cloud->width = int(entry->cloud->points.size());
+    entry->cloud->height = 1;
+    entry->cloud->is_dense = true;
+
+    cacheEntries.emplace_front(key, entry);
+    if (cacheEntries.size() > MaxEntries) {
+        cacheEntries.pop_back();
+    }
+
+    return entry;
+}
+
+void PointCloudCache::clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheEntries.clear();
+}
+
+bool PointCloudCache::Entry::matches(const Points::PointKernel& kernel) const
+{
+    // the cloud is built from the transformed points in the same order, so the points of an
+    // equal kernel are bitwise identical
+    auto cloudIt = cloud->points.begin();
+    auto indexIt = indices.begin();
+    int index = 0;
+    for (Points::PointKernel::const_iterator it = kernel.begin(); it != kernel.end();
+         ++it, ++index) {
+        if (boost::math::isnan(it->x) || boost::math::isnan(it->y)
+            || boost::math::isnan(it->z)) {
+            continue;
+        }
+        if (cloudIt == cloud->points.end() || *indexIt != index || cloudIt->x != float(it->x)
+            || cloudIt->y != float(it->y) || cloudIt->z != float(it->z)) {
+            return false;
+        }
+        ++cloudIt;
+        ++indexIt;
+    }
+
+    return cloudIt == cloud->points.end();
+}
+
+pcl::PointCloud<pcl::Normal>::Ptr PointCloudCache::Entry::getNormals(int ksearch,
+                                                                     double searchRadius)
+{
+    std::lock_guard<std::mutex> lock(normalsMutex);
+    auto key = std::make_pair(ksearch, searchRadius);
+    for (auto it = normals.begin(); it != normals.end(); ++it) {
+        if (it->first == key) {
+            // move to the front as most recently used normals
+            normals.splice(normals.begin(), normals, it);
+            return it->second;
+        }
+    }
+
+    pcl::PointCloud<pcl::Normal>::Ptr result(new pcl::PointCloud<pcl::Normal>);
+    pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+    pcl::NormalEstimationOMP<pcl::PointXYZ, pcl::Normal> ne;
+    ne.setNumberOfThreads(0);  // use all available cores
+    ne.setSearchMethod(tree);
+    ne.setInputCloud(cloud);
+    if (ksearch > 0) {
+        ne.setKSearch(ksearch);
+    }
+    if (searchRadius > 0) {
+        ne.setRadiusSearch(searchRadius);
+    }
+    ne.compute(*result);
+
+    normals.emplace_front(key, result);
+    if (normals.size() > MaxNormals) {
+        normals.pop_back();
+    }
+
+    return result;
+}
+
+#endif  // HAVE_PCL_FILTERS
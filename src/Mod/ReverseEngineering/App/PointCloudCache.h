@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef REEN_POINTCLOUDCACHE_H
+#define REEN_POINTCLOUDCACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <pcl/point_types.h>
+
+
+namespace Points
+{
+class PointKernel;
+}
+
+namespace Reen
+{
+
+/** The PointCloudCache class keeps the PCL representation of recently used point kernels.
+ * For each point kernel the NaN free cloud and the normals computed for a given neighbourhood
+ * are stored, so that repeated calls with different segmentation parameters don't need to
+ * rebuild them. A kernel is looked up by a hash over its points and placement and the points
+ * are compared on a match, so a modified kernel gets a new entry.
+ *
+ * A PCL search tree is rebuilt whenever it gets an input cloud, which every PCL algorithm does
+ * on its own. Therefore, no search tree is shared and each caller must use its own one.
+ */
+class PointCloudCache
+{
+public:
+    struct Entry
+    {
+        /// The points without NaN coordinates
+        pcl::PointCloud<pcl::PointXYZ>::Ptr cloud;
+        /// The index of the point kernel for each point of the cloud
+        std::vector<int> indices;
+
+        /** Returns the normals of the cloud computed with the k nearest neighbours or
+         * the neighbours inside the search radius. The computation runs multi-threaded.
+         * Only the normals of the most recently used neighbourhoods are kept.
+         */
+        pcl::PointCloud<pcl::Normal>::Ptr getNormals(int ksearch, double searchRadius);
+        /** Checks whether the cloud has been created from the points of \a kernel. */
+        bool matches(const Points::PointKernel& kernel) const;
+
+    private:
+        std::mutex normalsMutex;
+        std::list<std::pair<std::pair<int, double>, pcl::PointCloud<pcl::Normal>::Ptr>> normals;
+    };
+
+    /** Returns the cached entry of \a kernel or creates a new one. */
+    static std::shared_ptr<Entry> get(const Points::PointKernel& kernel);
+    /** Removes all entries. */
+    static void clear();
+
+private:
+    static std::size_t hash(const Points::PointKernel& kernel);
+};
+
+}  // namespace Reen
+
+#endif  // REEN_POINTCLOUDCACHE_H
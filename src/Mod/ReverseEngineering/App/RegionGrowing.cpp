@@ -21,9 +21,6 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
-#ifndef _PreComp_
-#include <boost/math/special_functions/fpclassify.hpp>
-#endif
 
 #include <Mod/Points/App/Points.h>
 
@@ -31,62 +28,36 @@
 
 
 #if defined(HAVE_PCL_FILTERS)
-#include <pcl/filters/passthrough.h>
 #include <pcl/point_types.h>
 #endif
 #if defined(HAVE_PCL_SEGMENTATION)
-#include <pcl/features/normal_3d.h>
-#include <pcl/filters/extract_indices.h>
 #include <pcl/search/kdtree.h>
 #include <pcl/search/search.h>
 #include <pcl/segmentation/region_growing.h>
 
+#include "PointCloudCache.h"
+
 using namespace std;
 using namespace Reen;
 using pcl::PointCloud;
 using pcl::PointNormal;
 using pcl::PointXYZ;
 
-RegionGrowing::RegionGrowing(const Points::PointKernel& pts, std::list<std::vector<int>>& clusters)
-    : myPoints(pts)
-    , myClusters(clusters)
-{}
-
-void RegionGrowing::perform(int ksearch)
+namespace
 {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        if (!boost::math::isnan(it->x) && !boost::math::isnan(it->y)
-            && !boost::math::isnan(it->z)) {
-            cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-        }
-    }
-
-    // normal estimation
-    pcl::search::Search<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::NormalEstimation<pcl::PointXYZ, pcl::Normal> normal_estimator;
-    normal_estimator.setSearchMethod(tree);
-    normal_estimator.setInputCloud(cloud);
-    normal_estimator.setKSearch(ksearch);
-    normal_estimator.compute(*normals);
-
-    // pass through
-    pcl::IndicesPtr indices(new std::vector<int>);
-    pcl::PassThrough<pcl::PointXYZ> pass;
-    pass.setInputCloud(cloud);
-    pass.setFilterFieldName("z");
-    pass.setFilterLimits(0.0, 1.0);
-    pass.filter(*indices);
+void extractClusters(const PointCloudCache::Entry& entry,
+                     pcl::PointCloud<pcl::Normal>::Ptr normals,
+                     std::list<std::vector<int>>& myClusters)
+{
+    // the search tree is rebuilt for the input cloud, so it cannot be shared with other callers
+    pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
 
     pcl::RegionGrowing<pcl::PointXYZ, pcl::Normal> reg;
     reg.setMinClusterSize(50);
     reg.setMaxClusterSize(1000000);
     reg.setSearchMethod(tree);
     reg.setNumberOfNeighbours(30);
-    reg.setInputCloud(cloud);
-    // reg.setIndices (indices);
+    reg.setInputCloud(entry.cloud);
     reg.setInputNormals(normals);
     reg.setSmoothnessThreshold(3.0 / 180.0 * M_PI);
     reg.setCurvatureThreshold(1.0);
@@ -94,12 +65,31 @@ void RegionGrowing::perform(int ksearch)
     std::vector<pcl::PointIndices> clusters;
     reg.extract(clusters);
 
-    for (std::vector<pcl::PointIndices>::iterator it = clusters.begin(); it != clusters.end();
-         ++it) {
-        myClusters.push_back(std::vector<int>());
-        myClusters.back().swap(it->indices);
+    // map the indices of the NaN free cloud back to the indices of the point kernel
+    for (auto& it : clusters) {
+        myClusters.emplace_back();
+        std::vector<int>& cluster = myClusters.back();
+        cluster.reserve(it.indices.size());
+        for (int index : it.indices) {
+            cluster.push_back(entry.indices[index]);
+        }
     }
 }
+}  // namespace
+
+RegionGrowing::RegionGrowing(const Points::PointKernel& pts, std::list<std::vector<int>>& clusters)
+    : myPoints(pts)
+    , myClusters(clusters)
+{}
+
+void RegionGrowing::perform(int ksearch)
+{
+    // the cloud and the normals are shared with previous runs on the same points
+    std::shared_ptr<PointCloudCache::Entry> entry = PointCloudCache::get(myPoints);
+    pcl::PointCloud<pcl::Normal>::Ptr normals = entry->getNormals(ksearch, 0.0);
+
+    extractClusters(*entry, normals, myClusters);
+}
 
 void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
 {
@@ -107,52 +97,26 @@ void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
         throw Base::RuntimeError("Number of points doesn't match with number of normals");
     }
 
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-    cloud->reserve(myPoints.size());
-    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>);
-    normals->reserve(myNormals.size());
-
-    std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
-    for (std::size_t index = 0; index < num_points; index++) {
-        const Base::Vector3f& p = points[index];
-        const Base::Vector3f& n = myNormals[index];
-        if (!boost::math::isnan(p.x) && !boost::math::isnan(p.y) && !boost::math::isnan(p.z)) {
-            cloud->push_back(pcl::PointXYZ(p.x, p.y, p.z));
-            normals->push_back(pcl::Normal(n.x, n.y, n.z));
+    // The cached cloud consists of the transformed points, so the normals must be rotated
+    // accordingly. Remove the translation and the scaling of the placement.
+    Base::Matrix4D mat = myPoints.getTransform();
+    Base::Matrix4D rot;
+    for (unsigned short i = 0; i < 3; i++) {
+        double s = std::sqrt(mat[i][0] * mat[i][0] + mat[i][1] * mat[i][1] + mat[i][2] * mat[i][2]);
+        for (unsigned short j = 0; j < 3; j++) {
+            rot[i][j] = mat[i][j] / s;
         }
     }
 
-    pcl::search::Search<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-    tree->setInputCloud(cloud);
-
-    // pass through
-    pcl::IndicesPtr indices(new std::vector<int>);
-    pcl::PassThrough<pcl::PointXYZ> pass;
-    pass.setInputCloud(cloud);
-    pass.setFilterFieldName("z");
-    pass.setFilterLimits(0.0, 1.0);
-    pass.filter(*indices);
-
-    pcl::RegionGrowing<pcl::PointXYZ, pcl::Normal> reg;
-    reg.setMinClusterSize(50);
-    reg.setMaxClusterSize(1000000);
-    reg.setSearchMethod(tree);
-    reg.setNumberOfNeighbours(30);
-    reg.setInputCloud(cloud);
-    // reg.setIndices (indices);
-    reg.setInputNormals(normals);
-    reg.setSmoothnessThreshold(3.0 / 180.0 * M_PI);
-    reg.setCurvatureThreshold(1.0);
-
-    std::vector<pcl::PointIndices> clusters;
-    reg.extract(clusters);
-
-    for (std::vector<pcl::PointIndices>::iterator it = clusters.begin(); it != clusters.end();
-         ++it) {
-        myClusters.push_back(std::vector<int>());
-        myClusters.back().swap(it->indices);
+    std::shared_ptr<PointCloudCache::Entry> entry = PointCloudCache::get(myPoints);
+    pcl::PointCloud<pcl::Normal>::Ptr normals(new pcl::PointCloud<pcl::Normal>);
+    normals->reserve(entry->indices.size());
+    for (int index : entry->indices) {
+        Base::Vector3f n = rot * myNormals[index];
+        normals->push_back(pcl::Normal(n.x, n.y, n.z));
     }
+
+    extractClusters(*entry, normals, myClusters);
 }
 
 #endif  // HAVE_PCL_SEGMENTATION
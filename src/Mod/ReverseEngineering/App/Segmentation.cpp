@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <limits>
+#endif
 
 #include <Mod/Points/App/Points.h>
 
@@ -28,9 +31,11 @@
 
 
 #if defined(HAVE_PCL_FILTERS)
-#include <pcl/features/normal_3d.h>
+#include <pcl/features/normal_3d_omp.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/filters/passthrough.h>
+
+#include "PointCloudCache.h"
 #endif
 
 #if defined(HAVE_PCL_SAMPLE_CONSENSUS)
@@ -64,14 +69,14 @@ void Segmentation::perform(int ksearch)
 {
     // All the objects needed
     pcl::PassThrough<PointXYZ> pass;
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
+    pcl::NormalEstimationOMP<PointXYZ, pcl::Normal> ne;
     pcl::SACSegmentationFromNormals<PointXYZ, pcl::Normal> seg;
     pcl::ExtractIndices<PointXYZ> extract;
     pcl::ExtractIndices<pcl::Normal> extract_normals;
     pcl::search::KdTree<PointXYZ>::Ptr tree(new pcl::search::KdTree<PointXYZ>());
 
-    // Datasets
-    pcl::PointCloud<PointXYZ>::Ptr cloud(new pcl::PointCloud<PointXYZ>);
+    // Datasets, the NaN free cloud of the points is shared with other algorithms
+    pcl::PointCloud<PointXYZ>::Ptr cloud = PointCloudCache::get(myPoints)->cloud;
     pcl::PointCloud<PointXYZ>::Ptr cloud_filtered(new pcl::PointCloud<PointXYZ>);
     pcl::PointCloud<pcl::Normal>::Ptr cloud_normals(new pcl::PointCloud<pcl::Normal>);
     pcl::PointCloud<PointXYZ>::Ptr cloud_filtered2(new pcl::PointCloud<PointXYZ>);
@@ -81,15 +86,6 @@ void Segmentation::perform(int ksearch)
     pcl::PointIndices::Ptr inliers_plane(new pcl::PointIndices),
         inliers_cylinder(new pcl::PointIndices);
 
-    // Copy the points
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-    }
-
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-
     // Build a passthrough filter to remove spurious NaNs
     pass.setInputCloud(cloud);
     pass.setFilterFieldName("z");
@@ -97,6 +93,7 @@ void Segmentation::perform(int ksearch)
     pass.filter(*cloud_filtered);
 
     // Estimate point normals
+    ne.setNumberOfThreads(0);  // use all available cores
     ne.setSearchMethod(tree);
     ne.setInputCloud(cloud_filtered);
     ne.setKSearch(ksearch);
@@ -169,46 +166,17 @@ NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
 
 void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
 {
-    // Copy the points
-    pcl::PointCloud<PointXYZ>::Ptr cloud(new pcl::PointCloud<PointXYZ>);
-    cloud->reserve(myPoints.size());
-    for (Points::PointKernel::const_iterator it = myPoints.begin(); it != myPoints.end(); ++it) {
-        cloud->push_back(pcl::PointXYZ(it->x, it->y, it->z));
-    }
-
-    cloud->width = int(cloud->points.size());
-    cloud->height = 1;
-
-#if 0
-    // Build a passthrough filter to remove spurious NaNs
-    pcl::PointCloud<PointXYZ>::Ptr cloud_filtered (new pcl::PointCloud<PointXYZ>);
-    pcl::PassThrough<PointXYZ> pass;
-    pass.setInputCloud (cloud);
-    pass.setFilterFieldName ("z");
-    pass.setFilterLimits (0, 1.5);
-    pass.filter (*cloud_filtered);
-#endif
-
-    // Estimate point normals
-    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals(new pcl::PointCloud<pcl::Normal>);
-    pcl::search::KdTree<PointXYZ>::Ptr tree(new pcl::search::KdTree<PointXYZ>());
-    pcl::NormalEstimation<PointXYZ, pcl::Normal> ne;
-    ne.setSearchMethod(tree);
-    // ne.setInputCloud (cloud_filtered);
-    ne.setInputCloud(cloud);
-    if (kSearch > 0) {
-        ne.setKSearch(kSearch);
-    }
-    if (searchRadius > 0) {
-        ne.setRadiusSearch(searchRadius);
-    }
-    ne.compute(*cloud_normals);
-
-    normals.reserve(cloud_normals->size());
-    for (pcl::PointCloud<pcl::Normal>::const_iterator it = cloud_normals->begin();
-         it != cloud_normals->end();
-         ++it) {
-        normals.push_back(Base::Vector3d(it->normal_x, it->normal_y, it->normal_z));
+    // The cloud and the normals are cached for the points, so repeated estimations
+    // with the same parameters are cheap. The search tree is built for each estimation.
+    std::shared_ptr<PointCloudCache::Entry> entry = PointCloudCache::get(myPoints);
+    pcl::PointCloud<pcl::Normal>::Ptr cloud_normals = entry->getNormals(kSearch, searchRadius);
+
+    // Points with NaN coordinates get an undefined normal
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    normals.assign(myPoints.size(), Base::Vector3d(nan, nan, nan));
+    for (std::size_t i = 0; i < cloud_normals->size(); i++) {
+        const pcl::Normal& n = (*cloud_normals)[i];
+        normals[entry->indices[i]] = Base::Vector3d(n.normal_x, n.normal_y, n.normal_z);
     }
 }
 
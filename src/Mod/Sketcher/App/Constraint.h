@@ -106,6 +106,12 @@ public:
     // does not copy the tag, but generates a new one
     Constraint* copy() const;
 
+    /// the tag identifies a constraint and its clones
+    inline const boost::uuids::uuid& getTag() const
+    {
+        return tag;
+    }
+
     // from base class
     unsigned int getMemSize() const override;
     void Save(Base::Writer& /*writer*/) const override;
@@ -32,11 +32,16 @@
 #ifdef _PreComp_
 
 // standard
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 // Qt
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -71,6 +72,7 @@ Sketch::Sketch()
     : SolveTime(0)
     , RecalculateInitialSolutionWhileMovingPoint(false)
     , resolveAfterGeometryUpdated(false)
+    , incrementalSetUp(true)
     , GCSsys()
     , ConstraintsCounter(0)
     , isInitMove(false)
@@ -135,6 +137,7 @@ void Sketch::clear()
     // NonDrivingConstraints.end(); ++it)
     //    if (*it) delete *it;
     Constrs.clear();
+    setUpConstraints.clear();
 
     GCSsys.clear();
     isInitMove = false;
@@ -199,6 +202,19 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
 {
     Base::TimeElapsed start_time;
 
+    if (updateConstraints(GeoList, ConstraintList, extGeoCount)) {
+        int dofs = finishSetUp(ConstraintList);
+
+        if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
+            Base::TimeElapsed end_time;
+
+            Base::Console().Log("Sketcher::setUpSketch()-Updated-T:%s\n",
+                                Base::TimeElapsed::diffTime(start_time, end_time).c_str());
+        }
+
+        return dofs;
+    }
+
     clear();
 
     std::vector<Part::Geometry*> intGeoList, extGeoList;
@@ -272,6 +288,7 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
     GCSsys.declareUnknowns(Parameters);
     GCSsys.declareDrivenParams(DrivenParameters);
     GCSsys.initSolution(defaultSolverRedundant);
+    GCSsys.deferDiagnosis = false;
 
     // Post-analysis
     // Now that we have all the parameters information, we deal properly with the block constraints
@@ -330,6 +347,20 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
 #endif  // DEBUG_BLOCK_CONSTRAINT
     }
 
+    int dofs = finishSetUp(ConstraintList);
+
+    if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
+        Base::TimeElapsed end_time;
+
+        Base::Console().Log("Sketcher::setUpSketch()-T:%s\n",
+                            Base::TimeElapsed::diffTime(start_time, end_time).c_str());
+    }
+
+    return dofs;
+}
+
+int Sketch::finishSetUp(const std::vector<Constraint*>& ConstraintList)
+{
     // Now we set the Sketch status with the latest solver information
     GCSsys.getConflicting(Conflicting);
     GCSsys.getRedundant(Redundant);
@@ -338,16 +369,155 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
 
     calculateDependentParametersElements();
 
-    if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
-        Base::TimeElapsed end_time;
-
-        Base::Console().Log("Sketcher::setUpSketch()-T:%s\n",
-                            Base::TimeElapsed::diffTime(start_time, end_time).c_str());
+    // The solver system can be updated by the next set up if the tag of each solver constraint
+    // is the index of its constraint plus one. This isn't the case for malformed constraints.
+    // Block constraints fix geometry depending on the other constraints.
+    setUpConstraints.clear();
+    bool updatable = incrementalSetUp && !Geoms.empty() && MalformedConstraints.empty()
+        && ConstraintsCounter == int(ConstraintList.size())
+        && std::none_of(ConstraintList.begin(), ConstraintList.end(), [](const Constraint* c) {
+               return c->Type == Block;
+           });
+    if (updatable) {
+        setUpConstraints.reserve(ConstraintList.size());
+        for (auto* c : ConstraintList) {
+            setUpConstraints.emplace_back(c->clone());
+        }
     }
 
     return GCSsys.dofsNumber();
 }
 
+bool Sketch::updateConstraints(const std::vector<Part::Geometry*>& GeoList,
+                               const std::vector<Constraint*>& ConstraintList,
+                               int extGeoCount)
+{
+    if (setUpConstraints.empty() || GeoList.size() != Geoms.size()) {
+        return false;
+    }
+
+    // The geometry must be the same as the solved one, otherwise the parameters would have to be
+    // set up again
+    int intGeoCount = int(GeoList.size()) - extGeoCount;
+    for (int i = 0; i < int(GeoList.size()); i++) {
+        if (Geoms[i].external != (i >= intGeoCount)
+            || !GeoList[i]->isSame(*Geoms[i].geo, Precision::Confusion(), Precision::Angular())) {
+            return false;
+        }
+    }
+
+    // Match the constraints by their tag. The solver constraints of a former constraint are
+    // tagged with its index plus one and get the tag of the unchanged constraint, or are removed.
+    std::map<boost::uuids::uuid, int> formerIndex;
+    std::vector<int> constrDefIndex(setUpConstraints.size(), -1);
+    int constrDefCount = 0;
+    for (int i = 0; i < int(setUpConstraints.size()); i++) {
+        formerIndex.emplace(setUpConstraints[i]->getTag(), i);
+        if (setUpConstraints[i]->isActive) {
+            constrDefIndex[i] = constrDefCount++;
+        }
+    }
+    if (constrDefCount != int(Constrs.size())) {
+        return false;
+    }
+
+    std::vector<int> newTags(setUpConstraints.size() + 1, -1);
+    newTags[0] = 0;
+    std::vector<int> kept(ConstraintList.size(), -1);
+    for (int j = 0; j < int(ConstraintList.size()); j++) {
+        const Constraint* c = ConstraintList[j];
+        if (c->Type == Block) {
+            return false;
+        }
+
+        auto it = formerIndex.find(c->getTag());
+        if (it == formerIndex.end() || newTags[it->second + 1] >= 0) {
+            continue;
+        }
+        const Constraint* former = setUpConstraints[it->second].get();
+        // The value of a non-driving constraint is calculated by the solver
+        if (c->Type == former->Type && c->AlignmentType == former->AlignmentType
+            && c->First == former->First && c->FirstPos == former->FirstPos
+            && c->Second == former->Second && c->SecondPos == former->SecondPos
+            && c->Third == former->Third && c->ThirdPos == former->ThirdPos
+            && c->isDriving == former->isDriving && c->isActive == former->isActive
+            && c->InternalAlignmentIndex == former->InternalAlignmentIndex
+            && (!c->isDriving || c->getValue() == former->getValue())) {
+            newTags[it->second + 1] = j + 1;
+            kept[j] = it->second;
+        }
+    }
+
+    // Remove the solver constraints and parameters of removed or changed constraints
+    std::vector<ConstrDef> formerConstrs;
+    formerConstrs.swap(Constrs);
+    std::set<double*> removedParameters;
+    for (int i = 0; i < int(setUpConstraints.size()); i++) {
+        if (newTags[i + 1] < 0) {
+            GCSsys.clearByTag(i + 1);
+            if (constrDefIndex[i] >= 0) {
+                const auto& params = formerConstrs[constrDefIndex[i]].parameters;
+                removedParameters.insert(params.begin(), params.end());
+            }
+        }
+    }
+    if (!removedParameters.empty()) {
+        auto isRemoved = [&removedParameters](double* param) {
+            return removedParameters.count(param) > 0;
+        };
+        for (auto* params : {&Parameters, &DrivenParameters, &FixParameters}) {
+            params->erase(std::remove_if(params->begin(), params->end(), isRemoved),
+                          params->end());
+        }
+        for (double* param : removedParameters) {
+            delete param;
+        }
+    }
+    GCSsys.changeTags(newTags);
+
+    // Replace the geometry copies, as their extensions may have changed
+    for (int i = 0; i < int(GeoList.size()); i++) {
+        delete Geoms[i].geo;
+        Geoms[i].geo = GeoList[i]->clone();
+    }
+
+    // Keep the unchanged constraints and add the others with the tags of their index
+    internalAlignmentGeometryMap.clear();
+    buildInternalAlignmentGeometryMap(ConstraintList);
+    for (int j = 0; j < int(ConstraintList.size()); j++) {
+        if (kept[j] >= 0) {
+            if (constrDefIndex[kept[j]] >= 0) {
+                Constrs.push_back(formerConstrs[constrDefIndex[kept[j]]]);
+                Constrs.back().constr = ConstraintList[j];
+            }
+        }
+        else if (ConstraintList[j]->isActive) {
+            ConstraintsCounter = j;
+            if (addConstraint(ConstraintList[j]) == -1) {
+                int humanconstraintid = j + 1;
+                Base::Console().Error("Sketcher constraint number %d is malformed!\n",
+                                      humanconstraintid);
+                MalformedConstraints.push_back(humanconstraintid);
+            }
+        }
+    }
+    ConstraintsCounter = int(ConstraintList.size());
+    // The added constraints were appended, but the diagnosis depends on the order of the
+    // constraints, which must be the same as for a sketch set up from scratch
+    GCSsys.sortConstraintsByTag();
+
+    isInitMove = false;
+    pDependencyGroups.clear();
+    clearTemporaryConstraints();
+    GCSsys.invalidatedDiagnosis();
+    GCSsys.declareUnknowns(Parameters);
+    GCSsys.declareDrivenParams(DrivenParameters);
+    GCSsys.initSolution(defaultSolverRedundant);
+    GCSsys.deferDiagnosis = false;
+
+    return true;
+}
+
 void Sketch::buildInternalAlignmentGeometryMap(const std::vector<Constraint*>& constraintList)
 {
     for (auto* c : constraintList) {
@@ -1868,6 +2038,8 @@ int Sketch::addConstraint(const Constraint* constraint)
     ConstrDef c;
     c.constr = const_cast<Constraint*>(constraint);
     c.driving = constraint->isDriving;
+    size_t parameterCount = Parameters.size();
+    size_t fixParameterCount = FixParameters.size();
 
     switch (constraint->Type) {
         case DistanceX:
@@ -2378,6 +2550,10 @@ int Sketch::addConstraint(const Constraint* constraint)
             break;
     }
 
+    c.parameters.assign(Parameters.begin() + parameterCount, Parameters.end());
+    c.parameters.insert(c.parameters.end(),
+                        FixParameters.begin() + fixParameterCount,
+                        FixParameters.end());
     Constrs.push_back(c);
     return rtn;
 }
@@ -73,6 +73,11 @@ public:
      * an over-constrained sketch will always contain conflicting constraints
      * a fully constrained or under-constrained sketch may contain conflicting
      * constraints or may not
+     *
+     * if the geometry is the same as in the former set up and only constraints have been
+     * added, removed or changed, the solver system is updated instead of being rebuilt.
+     * The constraints are identified by their tag, the solver constraints of unchanged
+     * constraints are kept. Block constraints always lead to a rebuild.
      */
     int setUpSketch(const std::vector<Part::Geometry*>& GeoList,
                     const std::vector<Constraint*>& ConstraintList,
@@ -568,10 +573,21 @@ private:
         bool driving;
         double* value;
         double* secondvalue;  // this is needed for SnellsLaw
+        std::vector<double*> parameters;  // all parameters allocated for the constraint
     };
 
+    /// updates the solver system of the former set up to changed constraints, see setUpSketch()
+    bool updateConstraints(const std::vector<Part::Geometry*>& GeoList,
+                           const std::vector<Constraint*>& ConstraintList,
+                           int extGeoCount);
+    /// retrieves the diagnosis of the set up sketch and returns its degrees of freedom
+    int finishSetUp(const std::vector<Constraint*>& ConstraintList);
+
     std::vector<GeoDef> Geoms;
     std::vector<ConstrDef> Constrs;
+    // copies of the constraints of the former set up, empty if its solver system can't be updated
+    std::vector<std::unique_ptr<Constraint>> setUpConstraints;
+    bool incrementalSetUp;
     GCS::System GCSsys;
     int ConstraintsCounter;
     std::vector<int> Conflicting;
@@ -663,6 +679,37 @@ public:
     {
         return GCSsys.qrAlgorithm;
     }
+    inline void setSparseThreshold(int val)
+    {
+        GCSsys.sparseThreshold = val;
+    }
+    inline void setConcurrentThreshold(int val)
+    {
+        GCSsys.concurrentThreshold = val;
+    }
+    /// updates the solver system in setUpSketch() if only constraints have changed
+    inline void setIncrementalSetUp(bool val)
+    {
+        incrementalSetUp = val;
+    }
+    /** Reuses the diagnosis of the last setup in the next call of setUpSketch() if only the
+     * geometry has been moved since then, see GCS::System::deferDiagnosis. The flag is reset
+     * by setUpSketch().
+     */
+    inline void deferDiagnosis(bool defer = true)
+    {
+        GCSsys.deferDiagnosis = defer;
+    }
+    /// the timings of the last diagnosis, see GCS::System::diagnose()
+    inline const GCS::DiagnoseTimings& getDiagnoseTimings() const
+    {
+        return GCSsys.getDiagnoseTimings();
+    }
+    /// the number of solver iterations since the sketch was set up or a move was initialized
+    inline int getSolverIterations() const
+    {
+        return GCSsys.getIterations();
+    }
     inline void setQRPivotThreshold(double val)
     {
         GCSsys.qrpivotThreshold = val;
@@ -23,7 +23,13 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
 
 #include <BRep_Tool.hxx>
 #include <Precision.hxx>
@@ -37,6 +43,7 @@
 
 #include <App/Document.h>
 #include <Base/Console.h>
+#include <Base/Parallel.h>
 
 #include "GeometryFacade.h"
 #include "SketchAnalysis.h"
@@ -60,34 +67,28 @@ struct VertexIds
     Sketcher::PointPos PosId {};
 };
 
+struct VertexID_Less
+{
+    bool operator()(const VertexIds& x, const VertexIds& y) const
+    {
+        return (x.GeoId < y.GeoId || ((x.GeoId == y.GeoId) && (x.PosId < y.PosId)));
+    }
+};
+
 struct Vertex_Less
 {
-    explicit Vertex_Less(double tolerance)
-        : tolerance(tolerance)
-    {}
     bool operator()(const VertexIds& x, const VertexIds& y) const
     {
-        if (fabs(x.v.x - y.v.x) > tolerance) {
+        if (x.v.x != y.v.x) {
             return x.v.x < y.v.x;
         }
-        if (fabs(x.v.y - y.v.y) > tolerance) {
+        if (x.v.y != y.v.y) {
             return x.v.y < y.v.y;
         }
-        if (fabs(x.v.z - y.v.z) > tolerance) {
+        if (x.v.z != y.v.z) {
             return x.v.z < y.v.z;
         }
-        return false;  // points are considered to be equal
-    }
-
-private:
-    double tolerance;
-};
-
-struct VertexID_Less
-{
-    bool operator()(const VertexIds& x, const VertexIds& y) const
-    {
-        return (x.GeoId < y.GeoId || ((x.GeoId == y.GeoId) && (x.PosId < y.PosId)));
+        return VertexID_Less()(x, y);
     }
 };
 
@@ -112,6 +113,55 @@ private:
     double tolerance;
 };
 
+// A cell of a grid in the sketch plane
+struct GridCell
+{
+    std::int64_t x {};
+    std::int64_t y {};
+
+    bool operator==(const GridCell& other) const
+    {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct GridCell_Hash
+{
+    std::size_t operator()(const GridCell& cell) const
+    {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(cell.x) * 73856093U
+                                        ^ static_cast<std::uint64_t>(cell.y) * 19349663U);
+    }
+};
+
+// Disjoint sets of the points of a sketch
+class PointSets
+{
+public:
+    std::size_t add()
+    {
+        parents.push_back(parents.size());
+        return parents.size() - 1;
+    }
+
+    std::size_t find(std::size_t index)
+    {
+        while (parents[index] != index) {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    }
+
+    void unite(std::size_t index1, std::size_t index2)
+    {
+        parents[find(index1)] = find(index2);
+    }
+
+private:
+    std::vector<std::size_t> parents;
+};
+
 struct EdgeIds
 {
     double l {};
@@ -251,127 +301,95 @@ struct PointConstraints
         vertexIds.push_back(id);
     }
 
-    std::list<ConstraintIds> getMissingCoincidences(std::vector<Sketcher::Constraint*>& allcoincid,
-                                                    double precision)
+    std::list<ConstraintIds>
+    getMissingCoincidences(const std::vector<Sketcher::Constraint*>& coincidences,
+                           double precision)
     {
         std::list<ConstraintIds> missingCoincidences;  // Holds the list of missing coincidences
 
         // Sort points in geographic order
-        std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less(precision));
-
-        auto vt = vertexIds.begin();
-        Vertex_EqualTo pred(precision);
+        std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less());
 
-        // Comparing existing constraints and find missing ones
-
-        while (vt < vertexIds.end()) {
-            // Seeking for adjacent group of vertices
-            vt = std::adjacent_find(vt, vertexIds.end(), pred);
-            if (vt < vertexIds.end()) {  // If one found
-                std::vector<VertexIds>::iterator vn;
-                // Holds a single group of adjacent vertices
-                std::set<VertexIds, VertexID_Less> vertexGrp;
-                // Extract the group of adjacent vertices
-                vertexGrp.insert(*vt);
-                for (vn = vt + 1; vn < vertexIds.end(); ++vn) {
-                    if (pred(*vt, *vn)) {
-                        vertexGrp.insert(*vn);
-                    }
-                    else {
-                        break;
-                    }
-                }
-
-                // Holds groups of coincident vertices
-                std::vector<std::set<VertexIds, VertexID_Less>> coincVertexGrps;
-
-                // Decompose the group of adjacent vertices into groups of coincident vertices
-                // Going through existent coincidences
-                for (auto& coincidence : allcoincid) {
-                    VertexIds v1;
-                    VertexIds v2;
-                    v1.GeoId = coincidence->First;
-                    v1.PosId = coincidence->FirstPos;
-                    v2.GeoId = coincidence->Second;
-                    v2.PosId = coincidence->SecondPos;
-
-                    // Look if coincident vertices are in the group of adjacent ones we are
-                    // processing
-                    auto nv1 = vertexGrp.extract(v1);
-                    auto nv2 = vertexGrp.extract(v2);
-
-                    // Maybe if both empty, they already have been extracted by other coincidences
-                    // We have to check in existing coincident groups and eventually merge
-                    if (nv1.empty() && nv2.empty()) {
-                        std::set<VertexIds, VertexID_Less>* tempGrp = nullptr;
-                        for (auto it = coincVertexGrps.begin(); it < coincVertexGrps.end(); ++it) {
-                            if ((it->find(v1) != it->end()) || (it->find(v2) != it->end())) {
-                                if (!tempGrp) {
-                                    tempGrp = &*it;
-                                }
-                                else {
-                                    tempGrp->insert(it->begin(), it->end());
-                                    coincVertexGrps.erase(it);
-                                    break;
-                                }
-                            }
-                        }
-                        continue;
-                    }
+        std::vector<std::vector<std::size_t>> neighbours = findNeighbours(precision);
 
-                    // Look if one of the constrained vertices is already in a group of coincident
-                    // vertices
-                    for (std::set<VertexIds, VertexID_Less>& grp : coincVertexGrps) {
-                        if ((grp.find(v1) != grp.end()) || (grp.find(v2) != grp.end())) {
-                            // If yes add them to the existing group
-                            if (!nv1.empty()) {
-                                grp.insert(nv1.value());
-                            }
-                            if (!nv2.empty()) {
-                                grp.insert(nv2.value());
-                            }
-                            continue;
-                        }
-                    }
+        // Build the sets of points that are coincident by the existing constraints. The
+        // constraints may join the vertices through other points like the center of an arc.
+        PointSets coincidentSets;
+        std::map<VertexIds, std::size_t, VertexID_Less> pointIndexes;
+        for (const auto& vertex : vertexIds) {
+            pointIndexes.emplace(vertex, coincidentSets.add());
+        }
+        auto getPointIndex = [&](int geoId, Sketcher::PointPos posId) {
+            VertexIds point;
+            point.GeoId = geoId;
+            point.PosId = posId;
+            auto it = pointIndexes.find(point);
+            if (it == pointIndexes.end()) {
+                it = pointIndexes.emplace(point, coincidentSets.add()).first;
+            }
+            return it->second;
+        };
+        for (auto coincidence : coincidences) {
+            // an endpoint tangency or perpendicularity to an edge doesn't join two points
+            if (coincidence->FirstPos == Sketcher::PointPos::none
+                || coincidence->SecondPos == Sketcher::PointPos::none) {
+                continue;
+            }
+            coincidentSets.unite(getPointIndex(coincidence->First, coincidence->FirstPos),
+                                 getPointIndex(coincidence->Second, coincidence->SecondPos));
+        }
 
-                    if (nv1.empty() || nv2.empty()) {
-                        continue;
-                    }
+        // Each vertex not yet grouped forms a group of adjacent vertices with the vertices
+        // that are equal to it
+        std::vector<bool> grouped(vertexIds.size(), false);
+        for (std::size_t i = 0; i < vertexIds.size(); i++) {
+            if (grouped[i]) {
+                continue;
+            }
 
-                    // If no, create a new group of coincident vertices
-                    std::set<VertexIds, VertexID_Less> newGrp;
-                    newGrp.insert(nv1.value());
-                    newGrp.insert(nv2.value());
-                    coincVertexGrps.push_back(newGrp);
+            // Decompose the group of adjacent vertices into sets of coincident vertices, each
+            // set is represented by its first vertex
+            std::map<std::size_t, const VertexIds*> coincVertexGrps;
+            auto addToGroup = [&](std::size_t index) {
+                grouped[index] = true;
+                const VertexIds* vertex = &vertexIds[index];
+                auto it = coincVertexGrps.emplace(coincidentSets.find(index), vertex).first;
+                if (VertexID_Less()(*vertex, *it->second)) {
+                    it->second = vertex;
                 }
-
-                // If there are remaining vertices in the adjacent group (not in any existing
-                // constraint) add them as being each a separate coincident group
-                for (auto& lonept : vertexGrp) {
-                    std::set<VertexIds, VertexID_Less> newGrp;
-                    newGrp.insert(lonept);
-                    coincVertexGrps.push_back(newGrp);
+            };
+            addToGroup(i);
+            for (std::size_t j : neighbours[i]) {
+                if (!grouped[j]) {
+                    addToGroup(j);
                 }
+            }
 
-                // If there is more than 1 coincident group into adjacent group, constraint(s)
-                // is(are) missing Virtually generate the missing constraint(s)
-                if (coincVertexGrps.size() > 1) {
-                    std::vector<std::set<VertexIds, VertexID_Less>>::iterator vn;
-                    // Starting from the 2nd coincident group, generate a constraint between
-                    // this group first vertex, and previous group first vertex
-                    for (vn = coincVertexGrps.begin() + 1; vn < coincVertexGrps.end(); ++vn) {
-                        ConstraintIds id;
-                        id.Type = Coincident;  // default point on point restriction
-                        id.v = (vn - 1)->begin()->v;
-                        id.First = (vn - 1)->begin()->GeoId;
-                        id.FirstPos = (vn - 1)->begin()->PosId;
-                        id.Second = vn->begin()->GeoId;
-                        id.SecondPos = vn->begin()->PosId;
-                        missingCoincidences.push_back(id);
-                    }
+            // If there is more than 1 coincident set in the adjacent group, constraint(s)
+            // is(are) missing
+            if (coincVertexGrps.size() > 1) {
+                std::vector<const VertexIds*> firstVertices;
+                for (const auto& it : coincVertexGrps) {
+                    firstVertices.push_back(it.second);
+                }
+                std::sort(firstVertices.begin(),
+                          firstVertices.end(),
+                          [](const VertexIds* x, const VertexIds* y) {
+                              return VertexID_Less()(*x, *y);
+                          });
+
+                // Starting from the 2nd coincident set, generate a constraint between this
+                // set first vertex, and previous set first vertex
+                for (std::size_t k = 1; k < firstVertices.size(); k++) {
+                    ConstraintIds id;
+                    id.Type = Coincident;  // default point on point restriction
+                    id.v = firstVertices[k - 1]->v;
+                    id.First = firstVertices[k - 1]->GeoId;
+                    id.FirstPos = firstVertices[k - 1]->PosId;
+                    id.Second = firstVertices[k]->GeoId;
+                    id.SecondPos = firstVertices[k]->PosId;
+                    missingCoincidences.push_back(id);
                 }
-
-                vt = vn;
             }
         }
 
@@ -379,6 +397,54 @@ struct PointConstraints
     }
 
 private:
+    // For each vertex the indices of the following vertices that are equal to it
+    std::vector<std::vector<std::size_t>> findNeighbours(double precision) const
+    {
+        // Put the vertices into a grid whose cells are at least as large as the precision, so
+        // that the vertices equal to a vertex are in its cell or in one of the adjacent cells
+        double cellSize = std::max(precision, Precision::Confusion());
+        auto getCell = [cellSize](const Base::Vector3d& v) {
+            return GridCell {static_cast<std::int64_t>(std::floor(v.x / cellSize)),
+                             static_cast<std::int64_t>(std::floor(v.y / cellSize))};
+        };
+        std::unordered_map<GridCell, std::vector<std::size_t>, GridCell_Hash> grid;
+        for (std::size_t i = 0; i < vertexIds.size(); i++) {
+            grid[getCell(vertexIds[i].v)].push_back(i);
+        }
+
+        std::vector<std::vector<std::size_t>> neighbours(vertexIds.size());
+        Vertex_EqualTo pred(precision);
+        auto findNeighboursOf = [&](std::size_t i) {
+            GridCell cell = getCell(vertexIds[i].v);
+            for (std::int64_t x = cell.x - 1; x <= cell.x + 1; x++) {
+                for (std::int64_t y = cell.y - 1; y <= cell.y + 1; y++) {
+                    auto it = grid.find(GridCell {x, y});
+                    if (it == grid.end()) {
+                        continue;
+                    }
+                    for (std::size_t j : it->second) {
+                        if (j > i && pred(vertexIds[i], vertexIds[j])) {
+                            neighbours[i].push_back(j);
+                        }
+                    }
+                }
+            }
+            std::sort(neighbours[i].begin(), neighbours[i].end());
+        };
+
+        // The lookups are independent, so large sketches are scanned in chunks on all cores
+        constexpr std::size_t chunkSize = 4096;
+        std::size_t numChunks = (vertexIds.size() + chunkSize - 1) / chunkSize;
+        Base::runConcurrently(numChunks, [&](std::size_t chunk) {
+            std::size_t end = std::min(vertexIds.size(), (chunk + 1) * chunkSize);
+            for (std::size_t i = chunk * chunkSize; i < end; i++) {
+                findNeighboursOf(i);
+            }
+        });
+
+        return neighbours;
+    }
+
     // Holds a list of all vertices in the sketch
     std::vector<VertexIds> vertexIds;
 };
@@ -521,7 +587,7 @@ int SketchAnalysis::detectMissingPointOnPointConstraints(double precision,
 
     // Build a list of all coincidences in the sketch
 
-    std::vector<Sketcher::Constraint*> coincidences = sketch->Constraints.getValues();
+    std::vector<Sketcher::Constraint*> coincidences;
     for (auto& constraint : sketch->Constraints.getValues()) {
         // clang-format off
         if (constraint->Type == Sketcher::Coincident ||
@@ -530,7 +596,6 @@ int SketchAnalysis::detectMissingPointOnPointConstraints(double precision,
             coincidences.push_back(constraint);
         }
         // clang-format on
-        // TODO optimizing by removing constraints not applying on vertices ?
     }
 
     // Holds the list of missing coincidences
@@ -651,17 +716,87 @@ void SketchAnalysis::makeConstraints(std::vector<ConstraintIds>& ids)
 
 void SketchAnalysis::makeConstraintsOneByOne(std::vector<ConstraintIds>& ids, const char* errorText)
 {
-    for (const auto& it : ids) {
-        auto c = create(it);
+    makeConstraintsBatch(ids.cbegin(), ids.cend(), errorText);
 
-        // addConstraint() creates a clone
-        sketch->addConstraint(c);
-        delete c;
+    ids.clear();
+}
 
-        solveSketch(errorText);
+void SketchAnalysis::makeConstraintsBatch(std::vector<ConstraintIds>::const_iterator begin,
+                                          std::vector<ConstraintIds>::const_iterator end,
+                                          const char* errorText)
+{
+    if (begin == end) {
+        return;
     }
 
-    ids.clear();
+    // Adding the constraints together needs a single solve. Only if the sketch can't be solved
+    // then, the batch is split to find the first constraint that fails like when adding them
+    // one by one.
+    std::vector<Sketcher::Constraint*> constr;
+    std::set<boost::uuids::uuid> tags;
+    for (auto it = begin; it != end; ++it) {
+        auto c = create(*it);
+        constr.push_back(c);
+        tags.insert(c->getTag());
+    }
+
+    // addConstraints() creates clones with the same tags
+    sketch->addConstraints(constr);
+    for (auto it : constr) {
+        delete it;
+    }
+
+    int status {};
+    int dofs {};
+    solvesketch(status, dofs, true);
+
+    // autoRemoveRedundants() may also remove constraints that were in the sketch before, so
+    // they are kept to restore the sketch without the batch if it still can't be solved
+    std::vector<std::unique_ptr<Sketcher::Constraint>> previous;
+    bool removedRedundants = false;
+    if (status == int(Solver::RedundantConstraints)) {
+        for (auto it : sketch->Constraints.getValues()) {
+            if (tags.count(it->getTag()) == 0) {
+                previous.emplace_back(it->clone());
+            }
+        }
+        removedRedundants = true;
+        sketch->autoRemoveRedundants(false);
+
+        solvesketch(status, dofs, false);
+    }
+
+    if (!status) {
+        return;
+    }
+
+    if (std::next(begin) == end) {
+        THROWMT(Base::RuntimeError, errorText);
+    }
+
+    // remove the batch again
+    if (removedRedundants) {
+        std::vector<Sketcher::Constraint*> vals;
+        vals.reserve(previous.size());
+        for (auto& it : previous) {
+            vals.push_back(it.release());
+        }
+        sketch->Constraints.setValues(std::move(vals));
+    }
+    else {
+        std::vector<int> added;
+        const std::vector<Sketcher::Constraint*>& vals = sketch->Constraints.getValues();
+        for (std::size_t i = 0; i < vals.size(); i++) {
+            if (tags.count(vals[i]->getTag()) > 0) {
+                added.push_back(static_cast<int>(i));
+            }
+        }
+        sketch->delConstraints(added, false);
+    }
+
+    auto middle = begin + (end - begin) / 2;
+    makeConstraintsBatch(begin, middle, errorText);
+    makeConstraintsBatch(middle, end, errorText);
 }
 
 void SketchAnalysis::makeMissingPointOnPointCoincident()
@@ -108,8 +108,9 @@ public:
     /// Point on Point constraint simple routine Make step (see constructor)
     void makeMissingPointOnPointCoincident();
     /// Point on Point constraint simple routine Make step (see constructor)
-    /// The sketch is solved after each individual constraint addition and any
-    /// redundancy removed.
+    /// The sketch is solved after adding the constraints and any redundancy removed. If it
+    /// can't be solved, the constraints are added in smaller batches until the one that fails is
+    /// found, like when adding them one by one.
     void makeMissingPointOnPointCoincidentOneByOne();
 
     /// Vertical/Horizontal constraints simple routine Detect step (see constructor)
@@ -199,6 +200,9 @@ private:
     bool checkVertical(Base::Vector3d dir, double angleprecision);
     void makeConstraints(std::vector<ConstraintIds>&);
     void makeConstraintsOneByOne(std::vector<ConstraintIds>&, const char* errorText);
+    void makeConstraintsBatch(std::vector<ConstraintIds>::const_iterator begin,
+                              std::vector<ConstraintIds>::const_iterator end,
+                              const char* errorText);
     std::set<int> getDegeneratedGeometries(double tolerance) const;
     void solveSketch(const char* errorText);
     static Sketcher::Constraint* create(const ConstraintIds& id);
@@ -193,6 +193,12 @@ SketchObject::SketchObject() : geoLastId(0)
 
     noRecomputes = false;
 
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Sketcher/SolverAdvanced");
+    solvedSketch.setSparseThreshold(hGrp->GetInt("SparseThreshold", 1000));
+    solvedSketch.setConcurrentThreshold(hGrp->GetInt("ConcurrentThreshold", 200));
+    solvedSketch.setIncrementalSetUp(hGrp->GetBool("IncrementalSetUp", true));
+
     //NOLINTBEGIN
     ExpressionEngine.setValidator(
         std::bind(&Sketcher::SketchObject::validateExpression, this, sp::_1, sp::_2));
@@ -1353,6 +1359,10 @@ int SketchObject::moveGeometries(std::vector<GeoElementId> geoEltIds, const Base
 
 
     if (updateGeoBeforeMoving || solverNeedsUpdate) {
+        if (!updateGeoBeforeMoving) {
+            // the sketch has only been dragged since the last setup
+            solvedSketch.deferDiagnosis();
+        }
         lastDoF = solvedSketch.setUpSketch(
             getCompleteGeometry(), Constraints.getValues(), getExternalGeometryCount());
 
@@ -1383,6 +1393,8 @@ int SketchObject::moveGeometries(std::vector<GeoElementId> geoEltIds, const Base
         }
     }
 
+    // the move has ended, so the next setup of the sketch diagnoses it fully
+    solvedSketch.deferDiagnosis(false);
     solvedSketch.resetInitMove();// reset solver point moving mechanism
 
     return lastSolverStatus;
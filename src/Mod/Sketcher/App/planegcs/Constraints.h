@@ -171,7 +171,11 @@ public:
     virtual void rescale(double coef = 1.);
     virtual double error();
     virtual double grad(double*);
-    // virtual void grad(MAP_pD_D &deriv);  --> TODO: vectorized grad version
+    // Computes the error and the derivatives with respect to all entries of pvec in one pass,
+    // grads must have room for pvec.size() values. The derivative with respect to a parameter
+    // that occurs several times in pvec is the sum of the values of its entries.
+    // The default implementation calls grad() for each parameter.
+    virtual double errorAndGrads(double* grads);
     virtual double maxStep(MAP_pD_D& dir, double lim = 1.);
     // Finds first occurrence of param in pvec. This is useful to test if a constraint depends
     // on the parameter (it may not actually depend on it, e.g. angle-via-point doesn't depend
@@ -200,6 +204,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // Center of Gravity
@@ -380,6 +385,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // P2PDistance
@@ -417,6 +423,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
 };
 
@@ -456,6 +463,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
 };
 
@@ -502,6 +510,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
     double abs(double darea);
 };
@@ -546,6 +555,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // PointOnPerpBisector
@@ -638,6 +648,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // Perpendicular
@@ -688,6 +699,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // L2LAngle
@@ -742,6 +754,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
     double maxStep(MAP_pD_D& dir, double lim = 1.) override;
 };
 
@@ -793,6 +806,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 
 // TangentCircumf
@@ -845,6 +859,7 @@ public:
     void rescale(double coef = 1.) override;
     double error() override;
     double grad(double*) override;
+    double errorAndGrads(double* grads) override;
 };
 // PointOnEllipse
 class ConstraintPointOnEllipse: public Constraint
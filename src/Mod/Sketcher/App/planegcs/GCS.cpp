@@ -48,9 +48,11 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <limits>
+#include <numeric>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -96,6 +98,7 @@
 #endif
 
 #include <Base/Console.h>
+#include <Base/Parallel.h>
 #include <FCConfig.h>
 
 #include <boost/graph/connected_components.hpp>
@@ -470,6 +473,7 @@ System::System()
     , hasUnknowns(false)
     , hasDiagnosis(false)
     , isInit(false)
+    , iterations(0)
     , emptyDiagnoseMatrix(true)
     , maxIter(100)
     , maxIterRedundant(100)
@@ -479,6 +483,9 @@ System::System()
     , convergenceRedundant(1e-10)
     , qrAlgorithm(EigenSparseQR)
     , dogLegGaussStep(FullPivLU)
+    , sparseThreshold(1000)
+    , concurrentThreshold(200)
+    , deferDiagnosis(false)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
     , LM_eps(1E-10)
@@ -553,6 +560,26 @@ void System::clearByTag(int tagId)
     }
 }
 
+void System::changeTags(const std::vector<int>& newTags)
+{
+    for (Constraint* constr : clist) {
+        int tag = constr->getTag();
+        if (tag >= 0 && tag < int(newTags.size())) {
+            constr->setTag(newTags[tag]);
+        }
+    }
+    sortConstraintsByTag();
+}
+
+void System::sortConstraintsByTag()
+{
+    std::stable_sort(clist.begin(), clist.end(), [](Constraint* c1, Constraint* c2) {
+        return c1->getTag() < c2->getTag();
+    });
+    isInit = false;
+    hasDiagnosis = false;
+}
+
 int System::addConstraint(Constraint* constr)
 {
     isInit = false;
@@ -1817,6 +1844,7 @@ void System::initSolution(Algorithm alg)
     //   system reduction specified in the previous step
 
     isInit = false;
+    iterations = 0;
     if (!hasUnknowns) {
         return;
     }
@@ -1976,25 +2004,65 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    // the components that have to be solved with the number of their parameters
+    std::vector<std::pair<int, int>> components;
+    int totalSize = 0;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
+        if (subSystems[cid] || subSystemsAux[cid]) {
+            int size = subSystems[cid] ? subSystems[cid]->pSize() : 0;
+            size += subSystemsAux[cid] ? subSystemsAux[cid]->pSize() : 0;
+            components.emplace_back(cid, size);
+            totalSize += size;
         }
+    }
+    if (!components.empty()) {
+        resetToReference();
+    }
+
+    auto solveComponent = [&](int cid) {
         if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            return solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         }
         else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
+            return solve(subSystems[cid], isFine, alg, isRedundantsolving);
         }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+        else {
+            return solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
         }
+    };
+
+    // The components neither share parameters nor constraints, so they can be solved at the
+    // same time. The iteration log isn't written concurrently.
+#ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
+    bool concurrent = false;
+#else
+    bool concurrent = components.size() > 1 && concurrentThreshold > 0
+        && totalSize >= concurrentThreshold && debugMode != IterationLevel;
+#endif
+    std::vector<int> results(components.size(), Success);
+    if (concurrent) {
+        // start with the largest components
+        std::vector<std::size_t> order(components.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&components](std::size_t a, std::size_t b) {
+            return components[a].second > components[b].second;
+        });
+        Base::runConcurrently(order.size(), [&](std::size_t index) {
+            std::size_t i = order[index];
+            results[i] = solveComponent(components[i].first);
+        });
+    }
+    else {
+        for (std::size_t i = 0; i < components.size(); i++) {
+            results[i] = solveComponent(components[i].first);
+        }
+    }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (int result : results) {
+        res = std::max(res, result);
     }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
@@ -2084,7 +2152,8 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     double divergingLim = 1e6 * err + 1e12;
     double h_norm {};
 
-    for (int iter = 1; iter < maxIterNumber; ++iter) {
+    int iter = 1;
+    for (; iter < maxIterNumber; ++iter) {
         h_norm = h.norm();
         if (h_norm <= convCriterion || err <= smallF) {
             if (debugMode == IterationLevel) {
@@ -2146,6 +2215,7 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
         }
     }
 
+    iterations += iter - 1;
     subsys->revertParams();
 
     if (err <= smallF) {
@@ -2157,6 +2227,85 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+
+// Solves the augmented normal equations A * h = g of the Levenberg-Marquardt method
+bool solveNormalEquations(SubSystem* /*subsys*/,
+                          const Eigen::MatrixXd& A,
+                          const Eigen::VectorXd& g,
+                          Eigen::VectorXd& h)
+{
+    h = A.fullPivLu().solve(g);
+    return true;
+}
+
+bool solveNormalEquations(SubSystem* subsys,
+                          const Eigen::SparseMatrix<double>& A,
+                          const Eigen::VectorXd& g,
+                          Eigen::VectorXd& h)
+{
+    return subsys->solveNormal(A, g, h);
+}
+
+// Computes the Gauss-Newton step h_gn of the DogLeg method
+void gaussNewtonStep(DogLegGaussStep mode,
+                     SubSystem* /*subsys*/,
+                     const Eigen::MatrixXd& Jx,
+                     const Eigen::VectorXd& fx,
+                     Eigen::VectorXd& h_gn)
+{
+    // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+    // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+    switch (mode) {
+        case FullPivLU:
+            h_gn = Jx.fullPivLu().solve(-fx);
+            break;
+        case LeastNormFullPivLU:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+            break;
+        case LeastNormLdlt:
+            h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+            break;
+    }
+}
+
+void gaussNewtonStep(DogLegGaussStep mode,
+                     SubSystem* subsys,
+                     const Eigen::SparseMatrix<double>& Jx,
+                     const Eigen::VectorXd& fx,
+                     Eigen::VectorXd& h_gn)
+{
+    // The least norm step with a sparse factorization of J * J^T. If it's singular, e.g.
+    // because of redundant constraints, the dense step is used instead.
+    Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+    Eigen::VectorXd y;
+    if (subsys->solveLeastNorm(JJt, -fx, y)) {
+        h_gn = Jx.transpose() * y;
+        if ((Jx * h_gn + fx).norm() <= 1e-6 * fx.norm()) {
+            return;
+        }
+    }
+
+    gaussNewtonStep(mode, subsys, Eigen::MatrixXd(Jx), fx, h_gn);
+}
+
+}  // namespace
+
+bool System::useSparseSolver(SubSystem* subsys) const
+{
+    return sparseThreshold > 0 && subsys->pSize() >= sparseThreshold;
+}
+
+int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (useSparseSolver(subsys)) {
+        return solve_LM<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+    return solve_LM<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename JacobiMatrix>
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2172,8 +2321,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    JacobiMatrix J(csize, xsize);  // Jacobi of the subsystem
+    JacobiMatrix A(xsize, xsize);
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2251,12 +2400,14 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         while (k < 50) {
             // augment normal equations A = A+uI
             for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
+                A.coeffRef(i, i) += mu;
             }
 
             // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A * h - g).norm() / g.norm();
+            double rel_error = 1.;
+            if (solveNormalEquations(subsys, A, g, h)) {
+                rel_error = (A * h - g).norm() / g.norm();
+            }
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -2306,7 +2457,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
             mu *= nu;
             nu *= 2.0;
             for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
+                A.coeffRef(i, i) = diag_A(i);
             }
 
             k++;
@@ -2331,11 +2482,21 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         stop = 5;
     }
 
+    iterations += iter;
     subsys->revertParams();
 
     return (stop == 1) ? Success : Failed;
 }
 
+int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
+{
+    if (useSparseSolver(subsys)) {
+        return solve_DL<Eigen::SparseMatrix<double>>(subsys, isRedundantsolving);
+    }
+    return solve_DL<Eigen::MatrixXd>(subsys, isRedundantsolving);
+}
+
+template<typename JacobiMatrix>
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2381,7 +2542,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    JacobiMatrix Jx(csize, xsize), Jx_new(csize, xsize);
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
     subsys->redirectParams();
@@ -2433,19 +2594,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         h_sd = alpha * g;
 
         // get the gauss-newton step
-        // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-        // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-        switch (dogLegGaussStep) {
-            case FullPivLU:
-                h_gn = Jx.fullPivLu().solve(-fx);
-                break;
-            case LeastNormFullPivLU:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                break;
-            case LeastNormLdlt:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                break;
-        }
+        gaussNewtonStep(dogLegGaussStep, subsys, Jx, fx, h_gn);
 
         double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
         if (rel_error > 1e15) {
@@ -2540,6 +2689,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         iter++;
     }
 
+    iterations += iter;
     subsys->revertParams();
 
     if (debugMode == IterationLevel) {
@@ -4746,7 +4896,8 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
 
     double mu = 0;
     lambda.setZero();
-    for (int iter = 1; iter < maxIterNumber; iter++) {
+    int iter = 1;
+    for (; iter < maxIterNumber; iter++) {
         int status = qp_eq(B, grad, JA, resA, xdir, Y, Z);
         if (status) {
             break;
@@ -4841,6 +4992,7 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
         }
     }
 
+    iterations += iter;
     int ret;
     if (subsysA->error() <= smallF) {
         ret = Success;
@@ -4943,6 +5095,40 @@ int System::diagnose(Algorithm alg)
         return dofs;
     }
 
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point since) {
+        return std::chrono::duration<double>(Clock::now() - since).count();
+    };
+    Clock::time_point startTime = Clock::now();
+    diagnoseTimings = DiagnoseTimings();
+
+    std::vector<int> structure;
+    VEC_D constants;
+    makeDiagnosisStructure(alg, structure, constants);
+    if (deferDiagnosis && structure == lastDiagnosis.structure
+        && constants == lastDiagnosis.constants) {
+        restoreDiagnosis();
+        diagnoseTimings.reused = true;
+        diagnoseTimings.total = seconds(startTime);
+        if (debugMode == Minimal || debugMode == IterationLevel) {
+            Base::Console().Log("Sketcher::diagnose()-Reused-T:%f\n", diagnoseTimings.total);
+        }
+        return dofs;
+    }
+
+    auto finishDiagnosis = [&]() {
+        storeDiagnosis(structure, constants);
+        diagnoseTimings.total = seconds(startTime);
+        if (debugMode == Minimal || debugMode == IterationLevel) {
+            Base::Console().Log("Sketcher::diagnose()-Jacobian:%f-QR:%f-Redundancy:%f-T:%f\n",
+                                diagnoseTimings.jacobian,
+                                diagnoseTimings.decomposition,
+                                diagnoseTimings.redundancy,
+                                diagnoseTimings.total);
+        }
+        return dofs;
+    };
+
 #ifdef _DEBUG_TO_FILE
     SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
 #endif
@@ -4991,7 +5177,10 @@ int System::diagnose(Algorithm alg)
     // like 0 and -1.
     std::map<int, int> tagmultiplicity;
 
+    Clock::time_point stageTime = Clock::now();
     makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
+    diagnoseTimings.jacobian = seconds(stageTime);
+    stageTime = Clock::now();
 
     // this function will exit with a diagnosis and, unless overridden by functions below, with full
     // DoFs
@@ -5053,17 +5242,13 @@ int System::diagnose(Algorithm alg)
 #endif
 
     if (J.rows() == 0) {
-        return dofs;
+        return finishDiagnosis();
     }
 
     // From here on, presuming `J.rows() > 0`.
     emptyDiagnoseMatrix = false;
 
     if (qrAlgorithm == EigenDenseQR) {
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_start_time;
-#endif
-
         int rank = 0;  // rank is not cheap to retrieve from qrJT in DenseQR
         Eigen::MatrixXd R;
         Eigen::FullPivHouseholderQR<Eigen::MatrixXd> qrJT;
@@ -5098,6 +5283,8 @@ int System::diagnose(Algorithm alg)
         // pdiagnoselist, paramsNum, rank);
 
         fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+        diagnoseTimings.decomposition = seconds(stageTime);
+        stageTime = Clock::now();
 
         dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
 
@@ -5118,21 +5305,11 @@ int System::diagnose(Algorithm alg)
                 dofs = paramsNum - nonredundantconstrNum;
             }
         }
-
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed DenseQR_end_time;
-
-        auto SolveTime = Base::TimeElapsed::diffTimeF(DenseQR_start_time, DenseQR_end_time);
-
-        Base::Console().Log("\nDenseQR - Lapsed Time: %f seconds\n", SolveTime);
-#endif
+        diagnoseTimings.redundancy = seconds(stageTime);
     }
 
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
     else if (qrAlgorithm == EigenSparseQR) {
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_start_time;
-#endif
         int rank = 0;
         Eigen::MatrixXd R;
         Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> SqrJT;
@@ -5171,6 +5348,8 @@ int System::diagnose(Algorithm alg)
         int constrNum = SqrJT.cols();
 
         fut.wait();  // wait for the execution of identifyDependentParametersSparseQR to finish
+        diagnoseTimings.decomposition = seconds(stageTime);
+        stageTime = Clock::now();
 
         dofs = paramsNum - rank;  // unless overconstraint, which will be overridden below
 
@@ -5193,18 +5372,95 @@ int System::diagnose(Algorithm alg)
                 dofs = paramsNum - nonredundantconstrNum;
             }
         }
+        diagnoseTimings.redundancy = seconds(stageTime);
+    }
+#endif
 
-#ifdef PROFILE_DIAGNOSE
-        Base::TimeElapsed SparseQR_end_time;
+    return finishDiagnosis();
+}
 
-        auto SolveTime = Base::TimeElapsed::diffTimeF(SparseQR_start_time, SparseQR_end_time);
+void System::makeDiagnosisStructure(Algorithm alg, std::vector<int>& structure, VEC_D& constants)
+{
+    // The parameters are identified by their index in plist, because their addresses change
+    // when a sketch is set up again.
+    structure.clear();
+    constants.clear();
+    structure.push_back(alg);
+    structure.push_back(qrAlgorithm);
+    structure.push_back(static_cast<int>(plist.size()));
+    for (double* param : pdrivenlist) {
+        MAP_pD_I::const_iterator it = pIndex.find(param);
+        structure.push_back(it != pIndex.end() ? it->second : -1);
+    }
+    for (Constraint* constr : clist) {
+        structure.push_back(constr->getTypeId());
+        structure.push_back(constr->getTag());
+        structure.push_back(constr->isDriving() ? 1 : 0);
+        for (double* param : c2p[constr]) {
+            MAP_pD_I::const_iterator it = pIndex.find(param);
+            if (it != pIndex.end()) {
+                structure.push_back(it->second);
+            }
+            else {
+                structure.push_back(-1);
+                constants.push_back(*param);
+            }
+        }
+    }
+}
 
-        Base::Console().Log("\nSparseQR - Lapsed Time: %f seconds\n", SolveTime);
-#endif
+void System::storeDiagnosis(std::vector<int>& structure, VEC_D& constants)
+{
+    lastDiagnosis = DiagnosisSnapshot();
+    lastDiagnosis.structure.swap(structure);
+    lastDiagnosis.constants.swap(constants);
+    lastDiagnosis.dofs = dofs;
+    lastDiagnosis.emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    lastDiagnosis.conflictingTags = conflictingTags;
+    lastDiagnosis.redundantTags = redundantTags;
+    lastDiagnosis.partiallyRedundantTags = partiallyRedundantTags;
+    for (int i = 0; i < int(clist.size()); ++i) {
+        if (redundant.count(clist[i]) > 0) {
+            lastDiagnosis.redundant.push_back(i);
+        }
     }
-#endif
+    // the dependent parameters are taken from plist
+    for (double* param : pDependentParameters) {
+        lastDiagnosis.dependentParameters.push_back(pIndex.at(param));
+    }
+    for (const auto& group : pDependentParametersGroups) {
+        VEC_I indices;
+        for (double* param : group) {
+            indices.push_back(pIndex.at(param));
+        }
+        lastDiagnosis.dependentParametersGroups.push_back(indices);
+    }
+}
 
-    return dofs;
+void System::restoreDiagnosis()
+{
+    dofs = lastDiagnosis.dofs;
+    emptyDiagnoseMatrix = lastDiagnosis.emptyDiagnoseMatrix;
+    conflictingTags = lastDiagnosis.conflictingTags;
+    redundantTags = lastDiagnosis.redundantTags;
+    partiallyRedundantTags = lastDiagnosis.partiallyRedundantTags;
+    redundant.clear();
+    for (int i : lastDiagnosis.redundant) {
+        redundant.insert(clist[i]);
+    }
+    pDependentParameters.clear();
+    for (int i : lastDiagnosis.dependentParameters) {
+        pDependentParameters.push_back(plist[i]);
+    }
+    pDependentParametersGroups.clear();
+    for (const auto& indices : lastDiagnosis.dependentParametersGroups) {
+        std::vector<double*> group;
+        for (int i : indices) {
+            group.push_back(plist[i]);
+        }
+        pDependentParametersGroups.push_back(group);
+    }
+    hasDiagnosis = true;
 }
 
 void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
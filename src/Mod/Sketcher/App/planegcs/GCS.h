@@ -23,6 +23,8 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <atomic>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -102,6 +104,16 @@ enum SpecialTag
     DefaultTemporaryConstraint = -1
 };
 
+// Duration in seconds of the stages of System::diagnose()
+struct DiagnoseTimings
+{
+    double jacobian = 0.;       // setup of the reduced jacobian matrix
+    double decomposition = 0.;  // QR decompositions for the constraints and the parameters
+    double redundancy = 0.;     // identification of conflicting and redundant constraints
+    double total = 0.;
+    bool reused = false;  // the last diagnosis was reused, see System::deferDiagnosis
+};
+
 class SketcherExport System
 {
     // This is the main class. It holds all constraints and information
@@ -141,11 +153,39 @@ private:
     bool hasDiagnosis;  // if dofs, conflictingTags, redundantTags are up to date
     bool isInit;        // if plists, clists, reductionmaps are up to date
 
+    DiagnoseTimings diagnoseTimings;
+    // the iterations of all solves since the last initSolution(), components may be solved
+    // concurrently
+    std::atomic<int> iterations;
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    // The result of the last full diagnosis by the indices of the constraints in clist and of the
+    // parameters in plist, so that it survives clear() and can be reused for a rebuilt system.
+    struct DiagnosisSnapshot
+    {
+        std::vector<int> structure;  // the constraints and the unknowns they depend on
+        VEC_D constants;             // the values of the parameters that aren't unknowns
+        int dofs = 0;
+        bool emptyDiagnoseMatrix = true;
+        VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
+        VEC_I redundant;
+        VEC_I dependentParameters;
+        std::vector<VEC_I> dependentParametersGroups;
+    };
+    DiagnosisSnapshot lastDiagnosis;
+    void makeDiagnosisStructure(Algorithm alg, std::vector<int>& structure, VEC_D& constants);
+    void storeDiagnosis(std::vector<int>& structure, VEC_D& constants);
+    void restoreDiagnosis();
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
+    // JacobiMatrix is either Eigen::MatrixXd or Eigen::SparseMatrix<double>
+    template<typename JacobiMatrix>
+    int solve_LM(SubSystem* subsys, bool isRedundantsolving);
+    template<typename JacobiMatrix>
+    int solve_DL(SubSystem* subsys, bool isRedundantsolving);
+    bool useSparseSolver(SubSystem* subsys) const;
 
     void makeReducedJacobian(Eigen::MatrixXd& J,
                              std::map<int, int>& jacobianconstraintmap,
@@ -224,6 +264,16 @@ public:
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
     DogLegGaussStep dogLegGaussStep;
+    // Subsystems with at least this number of parameters are solved by LM and DL with sparse
+    // matrices. DL then always uses the least norm Gauss-Newton step. 0 disables it.
+    int sparseThreshold;
+    // Decoupled subsystems are solved concurrently if they have at least this number of
+    // parameters in total. 0 disables it.
+    int concurrentThreshold;
+    // If true, diagnose() reuses the last diagnosis if the constraints and the values of the
+    // parameters that aren't unknowns are the same. Only the unknowns may have changed, like
+    // while dragging, which cannot add conflicts or redundancies.
+    bool deferDiagnosis;
     double qrpivotThreshold;
     DebugMode debugMode;
     double LM_eps;
@@ -246,6 +296,14 @@ public:
 
     void clear();
     void clearByTag(int tagId);
+    /** Changes the tag of each constraint tagged with t >= 0 to newTags[t]. The constraints
+     * stay ordered by their tags like after adding them in the order of their tags.
+     */
+    void changeTags(const std::vector<int>& newTags);
+    /** Orders the constraints by their tags. Constraints with the same tag keep their order,
+     * so constraints added later are placed as if the system was built in the order of the tags.
+     */
+    void sortConstraintsByTag();
 
     int addConstraint(Constraint* constr);
     void removeConstraint(Constraint* constr);
@@ -570,6 +628,15 @@ public:
     }
 
     int diagnose(Algorithm alg = DogLeg);
+    const DiagnoseTimings& getDiagnoseTimings() const
+    {
+        return diagnoseTimings;
+    }
+    /// the number of solver iterations since the last call of initSolution()
+    int getIterations() const
+    {
+        return iterations;
+    }
     int dofsNumber() const
     {
         return hasDiagnosis ? dofs : -1;
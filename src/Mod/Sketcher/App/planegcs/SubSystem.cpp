@@ -24,6 +24,7 @@
 #pragma warning(disable : 4251)
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
@@ -137,6 +138,56 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
         }
         //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
+
+    // the non-zero pattern of the jacobi matrix follows from the adjacency lists
+    std::map<Constraint*, int> rows;
+    for (int i = 0; i < csize; i++) {
+        rows[clist[i]] = i;
+    }
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int j = 0; j < psize; j++) {
+        auto constrs = p2c.find(&pvals[j]);
+        if (constrs != p2c.end()) {
+            for (Constraint* constr : constrs->second) {
+                triplets.emplace_back(rows[constr], j, 0.);
+            }
+        }
+    }
+    jacobiPattern.resize(csize, psize);
+    jacobiPattern.setFromTriplets(triplets.begin(), triplets.end());
+    jacobiPattern.makeCompressed();
+
+    jacobiBatch.clear();
+    jacobiColumns.clear();
+    jacobiNonZeros.clear();
+    std::size_t maxCount = 0;
+    for (int i = 0; i < csize; i++) {
+        VEC_pD constr_params = clist[i]->params();  // still the original parameters
+        jacobiBatch.push_back({clist[i], i, jacobiColumns.size(), constr_params.size()});
+        maxCount = std::max(maxCount, constr_params.size());
+        for (double* p : constr_params) {
+            int col = -1;
+            int nonZero = -1;
+            MAP_pD_pD::const_iterator pmapfind = pmap.find(p);
+            if (pmapfind != pmap.end()) {
+                col = static_cast<int>(pmapfind->second - pvals.data());
+                const int* rows = jacobiPattern.innerIndexPtr();
+                const int* begin = rows + jacobiPattern.outerIndexPtr()[col];
+                const int* end = rows + jacobiPattern.outerIndexPtr()[col + 1];
+                nonZero = static_cast<int>(std::lower_bound(begin, end, i) - rows);
+            }
+            jacobiColumns.push_back(col);
+            jacobiNonZeros.push_back(nonZero);
+        }
+    }
+    std::stable_sort(jacobiBatch.begin(),
+                     jacobiBatch.end(),
+                     [](const JacobiBatchEntry& a, const JacobiBatchEntry& b) {
+                         return a.constr->getTypeId() < b.constr->getTypeId();
+                     });
+    jacobiGrads.resize(maxCount);
+    normalNonZeros = -1;
+    leastNormNonZeros = -1;
 }
 
 void SubSystem::redirectParams()
@@ -273,7 +324,31 @@ void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 
 void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
 {
-    calcJacobi(plist, jacobi);
+    jacobi.setZero(csize, psize);
+    for (const JacobiBatchEntry& entry : jacobiBatch) {
+        entry.constr->errorAndGrads(jacobiGrads.data());
+        for (std::size_t k = 0; k < entry.count; k++) {
+            int col = jacobiColumns[entry.first + k];
+            if (col >= 0) {
+                jacobi(entry.row, col) += jacobiGrads[k];
+            }
+        }
+    }
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    jacobi = jacobiPattern;
+    double* values = jacobi.valuePtr();
+    for (const JacobiBatchEntry& entry : jacobiBatch) {
+        entry.constr->errorAndGrads(jacobiGrads.data());
+        for (std::size_t k = 0; k < entry.count; k++) {
+            int nonZero = jacobiNonZeros[entry.first + k];
+            if (nonZero >= 0) {
+                values[nonZero] += jacobiGrads[k];
+            }
+        }
+    }
 }
 
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
@@ -325,6 +400,43 @@ double SubSystem::maxStep(Eigen::VectorXd& xdir)
     return maxStep(plist, xdir);
 }
 
+namespace
+{
+
+bool solveSparse(Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>& solver,
+                 Eigen::Index& nonZeros,
+                 const Eigen::SparseMatrix<double>& A,
+                 const Eigen::VectorXd& b,
+                 Eigen::VectorXd& x)
+{
+    if (nonZeros != A.nonZeros()) {
+        solver.analyzePattern(A);
+        nonZeros = A.nonZeros();
+    }
+    solver.factorize(A);
+    if (solver.info() != Eigen::Success) {
+        return false;
+    }
+    x = solver.solve(b);
+    return solver.info() == Eigen::Success && x.allFinite();
+}
+
+}  // namespace
+
+bool SubSystem::solveNormal(const Eigen::SparseMatrix<double>& A,
+                            const Eigen::VectorXd& b,
+                            Eigen::VectorXd& x)
+{
+    return solveSparse(normalSolver, normalNonZeros, A, b, x);
+}
+
+bool SubSystem::solveLeastNorm(const Eigen::SparseMatrix<double>& A,
+                               const Eigen::VectorXd& b,
+                               Eigen::VectorXd& x)
+{
+    return solveSparse(leastNormSolver, leastNormNonZeros, A, b, x);
+}
+
 void SubSystem::applySolution()
 {
     for (MAP_pD_pD::const_iterator it = pmap.begin(); it != pmap.end(); ++it) {
@@ -27,6 +27,7 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/Sparse>
 
 #include "Constraints.h"
 
@@ -45,6 +46,25 @@ private:
                      //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
     std::map<Constraint*, VEC_pD> c2p;                // constraint to parameter adjacency list
     std::map<double*, std::vector<Constraint*>> p2c;  // parameter to constraint adjacency list
+    Eigen::SparseMatrix<double> jacobiPattern;  // non-zero pattern of the jacobi matrix
+    // The jacobi matrix is evaluated in batches of constraints of the same type. Each
+    // constraint computes the derivatives with respect to all its parameters in one pass.
+    struct JacobiBatchEntry
+    {
+        Constraint* constr;
+        int row;
+        std::size_t first;  // index of the first parameter of constr in jacobiColumns
+        std::size_t count;
+    };
+    std::vector<JacobiBatchEntry> jacobiBatch;  // sorted by constraint type
+    // for each parameter of the constraints of jacobiBatch the column of the jacobi matrix and
+    // the index of the non-zero in jacobiPattern, or -1 if the parameter isn't an unknown
+    std::vector<int> jacobiColumns;
+    std::vector<int> jacobiNonZeros;
+    VEC_D jacobiGrads;  // scratch space for Constraint::errorAndGrads
+    // sparse factorizations of the normal equations whose symbolic analysis is done only once
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> normalSolver, leastNormSolver;
+    Eigen::Index normalNonZeros = -1, leastNormNonZeros = -1;
     void initialize(VEC_pD& params, MAP_pD_pD& reductionmap);  // called by the constructors
 public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params);
@@ -78,12 +98,25 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    // only evaluates the gradients of the parameters a constraint depends on
+    void calcJacobi(Eigen::SparseMatrix<double>& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
     double maxStep(VEC_pD& params, Eigen::VectorXd& xdir);
     double maxStep(Eigen::VectorXd& xdir);
 
+    // Solve the symmetric system A * x = b with A = J^T * J + mu * I (normal equations) or with
+    // A = J * J^T (least norm equations) of the sparse jacobi matrix J of this subsystem. The
+    // sparsity pattern of A doesn't change, so the symbolic factorization is reused.
+    // Return false if A cannot be factorized.
+    bool solveNormal(const Eigen::SparseMatrix<double>& A,
+                     const Eigen::VectorXd& b,
+                     Eigen::VectorXd& x);
+    bool solveLeastNorm(const Eigen::SparseMatrix<double>& A,
+                        const Eigen::VectorXd& b,
+                        Eigen::VectorXd& x);
+
     void applySolution();
     void analyse(Eigen::MatrixXd& J, Eigen::MatrixXd& ker, Eigen::MatrixXd& img);
     void report();
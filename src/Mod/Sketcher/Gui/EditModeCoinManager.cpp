@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <chrono>
 #include <memory>
 
 #include <Inventor/SbVec3f.h>
@@ -45,6 +46,7 @@
 #include <Base/Exception.h>
 #include <Gui/Inventor/MarkerBitmaps.h>
 #include <Gui/Inventor/SoFCBoundingBox.h>
+#include <Mod/Part/App/Geometry.h>
 #include <Mod/Sketcher/App/Constraint.h>
 #include <Mod/Sketcher/App/GeoList.h>
 
@@ -544,7 +546,8 @@ EditModeCoinManager::EditModeCoinManager(ViewProviderSketch& vp)
                                                       geometryLayerParameters,
                                                       analysisResults,
                                                       editModeScenegraphNodes,
-                                                      coinMapping);
+                                                      coinMapping,
+                                                      tessellationCache);
     // Create Edit Mode Scenograph
     createEditModeInventorNodes();
 
@@ -798,17 +801,42 @@ SoGroup* EditModeCoinManager::getSelectedConstraints()
 
 void EditModeCoinManager::processGeometryConstraintsInformationOverlay(
     const GeoListFacade& geolistfacade,
-    bool rebuildinformationlayer)
+    bool rebuildinformationlayer,
+    bool temp)
 {
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point since) {
+        return std::chrono::duration<double>(Clock::now() - since).count();
+    };
+    Clock::time_point startTime = Clock::now();
+    redrawTimings = RedrawTimings();
+
     overlayParameters.rebuildInformationLayer = rebuildinformationlayer;
 
     pEditModeGeometryCoinManager->processGeometry(geolistfacade);
 
+    redrawTimings.geometry = seconds(startTime);
+    redrawTimings.tessellatedGeometries = static_cast<int>(tessellationCache.changedGeoIds.size());
+    redrawTimings.reusedGeometries = tessellationCache.reusedCount;
+    Clock::time_point overlayTime = Clock::now();
+
     updateOverlayParameters();
 
     processGeometryInformationOverlay(geolistfacade);
 
-    pEditModeConstraintCoinManager->processConstraints(geolistfacade);
+    redrawTimings.overlay = seconds(overlayTime);
+    Clock::time_point constraintsTime = Clock::now();
+
+    // While dragging, the constraints and the drawing parameters don't change, so only the
+    // constraints on the geometry that moved need to be updated.
+    redrawTimings.updatedConstraints = pEditModeConstraintCoinManager->processConstraints(
+        geolistfacade,
+        temp ? &tessellationCache.changedGeoIds : nullptr);
+    redrawTimings.skippedConstraints =
+        editModeScenegraphNodes.constrGroup->getNumChildren() - redrawTimings.updatedConstraints;
+
+    redrawTimings.constraints = seconds(constraintsTime);
+    redrawTimings.total = seconds(startTime);
 }
 
 void EditModeCoinManager::updateOverlayParameters()
@@ -227,8 +227,17 @@ public:
     //@}
 
     /** @name update coin nodes*/
+    /// temp => temporary solver solution while dragging, only the constraints on geometry that
+    /// moved are updated
     void processGeometryConstraintsInformationOverlay(const GeoListFacade& geolistfacade,
-                                                      bool rebuildinformationlayer);
+                                                      bool rebuildinformationlayer,
+                                                      bool temp = false);
+
+    /// CPU time spent in the last processGeometryConstraintsInformationOverlay
+    const RedrawTimings& getRedrawTimings() const
+    {
+        return redrawTimings;
+    }
 
     void updateVirtualSpace();
 
@@ -305,6 +314,8 @@ private:
     OverlayParameters overlayParameters;
     ConstraintParameters constraintParameters;
     GeometryLayerParameters geometryLayerParameters;
+    TessellationCache tessellationCache;
+    RedrawTimings redrawTimings;
 
     /// The pointers to Coin Scenegraph
     EditModeScenegraphNodes editModeScenegraphNodes;
@@ -24,6 +24,8 @@
 #define SKETCHERGUI_EditModeCoinManagerParameters_H
 
 #include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 #include <QString>
@@ -41,6 +43,7 @@
 #include <Inventor/nodes/SoTranslation.h>
 
 #include <App/Color.h>
+#include <Base/Vector3D.h>
 #include <Gui/ViewParams.h>
 #include <Gui/Inventor/SmSwitchboard.h>
 #include <Mod/Sketcher/App/GeoList.h>
@@ -357,6 +360,48 @@ struct AnalysisResults
     std::vector<int> arcGeoIds;
 };
 
+/** @brief     Struct to keep the tessellation of the geometry between draws
+ *
+ * @details
+ * A geometry is only tessellated again if it differs from the geometry it was last tessellated
+ * from, as while dragging, where the solver moves only part of the sketch. It is updated by
+ * EditModeGeometryCoinConverter with every draw of the scenegraph.
+ */
+struct TessellationCache
+{
+    struct Entry
+    {
+        // copy of the tessellated curve, nullptr for points and line segments, which are
+        // compared by their coordinates
+        std::unique_ptr<Part::Geometry> geometry;
+        int numSegments = 0;
+        std::vector<Base::Vector3d> coords;  // the points or the polyline of the geometry
+        double combRepresentationScale = 0;  // only for B-splines
+    };
+
+    std::map<int, Entry> entries;  // by GeoId
+
+    /// GeoIds of the geometries that were tessellated again in the last draw
+    std::set<int> changedGeoIds;
+    /// number of geometries whose tessellation was reused in the last draw
+    int reusedCount = 0;
+};
+
+/** @brief     Struct to hold the CPU time spent in the last update of the edit mode coin nodes
+ * (in seconds) and how much of the sketch had to be updated.
+ */
+struct RedrawTimings
+{
+    double geometry = 0.;     // conversion of the geometry into points and line sets
+    double constraints = 0.;  // update of the constraint nodes
+    double overlay = 0.;      // geometry information overlay
+    double total = 0.;
+    int tessellatedGeometries = 0;  // geometries that had to be tessellated again
+    int reusedGeometries = 0;       // geometries drawn from the tessellation cache
+    int updatedConstraints = 0;
+    int skippedConstraints = 0;  // constraints left as they were, see processConstraints
+};
+
 /** @brief      Struct adapted to store the parameters necessary to create and update
  *  the information overlay layer.
  */
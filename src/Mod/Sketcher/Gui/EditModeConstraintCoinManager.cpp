@@ -89,6 +89,33 @@ EditModeConstraintCoinManager::EditModeConstraintCoinManager(
 EditModeConstraintCoinManager::~EditModeConstraintCoinManager()
 {}
 
+EditModeConstraintCoinManager::DrawnConstraint::DrawnConstraint(
+    const Sketcher::Constraint* constraint)
+    : value(constraint->getValue())
+    , name(constraint->Name)
+    , first(constraint->First)
+    , firstPos(constraint->FirstPos)
+    , second(constraint->Second)
+    , secondPos(constraint->SecondPos)
+    , third(constraint->Third)
+    , thirdPos(constraint->ThirdPos)
+    , labelDistance(constraint->LabelDistance)
+    , labelPosition(constraint->LabelPosition)
+    , isDriving(constraint->isDriving)
+    , isActive(constraint->isActive)
+{}
+
+bool EditModeConstraintCoinManager::DrawnConstraint::isDrawnFrom(
+    const Sketcher::Constraint* constraint) const
+{
+    return value == constraint->getValue() && first == constraint->First
+        && firstPos == constraint->FirstPos && second == constraint->Second
+        && secondPos == constraint->SecondPos && third == constraint->Third
+        && thirdPos == constraint->ThirdPos && labelDistance == constraint->LabelDistance
+        && labelPosition == constraint->LabelPosition && isDriving == constraint->isDriving
+        && isActive == constraint->isActive && name == constraint->Name;
+}
+
 void EditModeConstraintCoinManager::updateVirtualSpace()
 {
     const std::vector<Sketcher::Constraint*>& constrlist =
@@ -112,7 +139,8 @@ void EditModeConstraintCoinManager::updateVirtualSpace()
     }
 }
 
-void EditModeConstraintCoinManager::processConstraints(const GeoListFacade& geolistfacade)
+int EditModeConstraintCoinManager::processConstraints(const GeoListFacade& geolistfacade,
+                                                      const std::set<int>* changedGeoIds)
 {
     const auto& constrlist = ViewProviderSketchCoinAttorney::getConstraints(viewProvider);
 
@@ -123,7 +151,7 @@ void EditModeConstraintCoinManager::processConstraints(const GeoListFacade& geol
     // constraint list In this case just ignore the constraints. (See bug #0000421)
     if (geolistfacade.geomlist.size() <= 2 && !constrlist.empty()) {
         rebuildConstraintNodes(geolistfacade);
-        return;
+        return 0;
     }
 
     int extGeoCount = geolistfacade.getExternalCount();
@@ -169,6 +197,23 @@ Restart:
         }
     };
 
+    // Only the constraints on moved geometry and the constraints that changed themselves need an
+    // update, as long as the nodes were not rebuilt and the sketch was not flipped.
+    bool skipUnchanged = changedGeoIds && drawnConstraints.size() == constrlist.size()
+        && drawnZConstrH == zConstrH;
+
+    if (!skipUnchanged) {
+        drawnConstraints.clear();
+        drawnConstraints.reserve(constrlist.size());
+        drawnZConstrH = zConstrH;
+    }
+
+    auto isGeometryChanged = [changedGeoIds](int geoId) {
+        return changedGeoIds->find(geoId) != changedGeoIds->end();
+    };
+
+    int updatedCount = 0;
+
     // go through the constraints and update the position
     int i = 0;
     for (std::vector<Sketcher::Constraint*>::const_iterator it = constrlist.begin();
@@ -182,6 +227,20 @@ Restart:
             // bug #0001956).
             goto Restart;
         }
+
+        if (!skipUnchanged) {
+            drawnConstraints.emplace_back(*it);
+        }
+        else if (drawnConstraints[i].isDrawnFrom(*it) && !isGeometryChanged((*it)->First)
+                 && !isGeometryChanged((*it)->Second) && !isGeometryChanged((*it)->Third)) {
+            continue;
+        }
+        else {
+            drawnConstraints[i] = DrawnConstraint(*it);
+        }
+
+        updatedCount++;
+
         try {  // because calculateNormalAtPoint, used in there, can throw
             // root separator for this constraint
             SoSeparator* sep =
@@ -1624,6 +1683,8 @@ Restart:
                                            "Exception during draw: unknown\n");
         }
     }
+
+    return updatedCount;
 }
 
 void EditModeConstraintCoinManager::findHelperAngles(double& helperStartAngle,
@@ -1913,6 +1974,7 @@ void EditModeConstraintCoinManager::rebuildConstraintNodes(const GeoListFacade&
     Gui::coinRemoveAllChildren(editModeScenegraphNodes.constrGroup);
 
     vConstrType.clear();
+    drawnConstraints.clear();
 
     // Get sketch normal
     Base::Vector3d RN(0, 0, 1);
@@ -24,6 +24,8 @@
 #define SKETCHERGUI_EditModeConstraintCoinManager_H
 
 #include <functional>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <QColor>
@@ -105,7 +107,12 @@ public:
 
     /** @name update coin nodes*/
     // geometry list to be used for constraints, which may be a temporal geometry
-    void processConstraints(const GeoListFacade& geolistfacade);
+    //
+    // If changedGeoIds is provided, only the nodes of the constraints on those geometries and of
+    // the constraints that changed since the last update are updated, as when dragging. Returns
+    // the number of constraints whose nodes were updated.
+    int processConstraints(const GeoListFacade& geolistfacade,
+                           const std::set<int>* changedGeoIds = nullptr);
 
     void updateVirtualSpace();
 
@@ -177,6 +184,30 @@ private:
     // helper data structures for the constraint rendering
     std::vector<Sketcher::ConstraintType> vConstrType;
 
+    /// The members of a constraint that its nodes were last updated from by processConstraints
+    struct DrawnConstraint
+    {
+        explicit DrawnConstraint(const Sketcher::Constraint* constraint);
+
+        bool isDrawnFrom(const Sketcher::Constraint* constraint) const;
+
+        double value;
+        std::string name;
+        int first;
+        Sketcher::PointPos firstPos;
+        int second;
+        Sketcher::PointPos secondPos;
+        int third;
+        Sketcher::PointPos thirdPos;
+        float labelDistance;
+        float labelPosition;
+        bool isDriving;
+        bool isActive;
+    };
+
+    std::vector<DrawnConstraint> drawnConstraints;
+    float drawnZConstrH = 0;
+
     // For each of the combined constraint icons drawn, also create a vector
     // of bounding boxes and associated constraint IDs, to go from the icon's
     // pixel coordinates to the relevant constraint IDs.
@@ -21,9 +21,15 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+
+#include <Precision.hxx>
+#endif  // #ifndef _PreComp_
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Mod/Part/App/Geometry.h>
 
 #include "EditModeCoinManagerParameters.h"
 #include "EditModeGeometryCoinConverter.h"
@@ -39,12 +45,14 @@ EditModeGeometryCoinConverter::EditModeGeometryCoinConverter(
     GeometryLayerNodes& geometrylayernodes,
     DrawingParameters& drawingparameters,
     GeometryLayerParameters& geometryLayerParams,
-    CoinMapping& coinMap)
+    CoinMapping& coinMap,
+    TessellationCache& tessellationcache)
     : viewProvider(vp)
     , geometryLayerNodes(geometrylayernodes)
     , drawingParameters(drawingparameters)
     , geometryLayerParameters(geometryLayerParams)
     , coinMapping(coinMap)
+    , tessellationCache(tessellationcache)
 {}
 
 void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geolistfacade)
@@ -54,6 +62,15 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeoListFacade& geoli
     bsplineGeoIds.clear();
     arcGeoIds.clear();
 
+    // drop the tessellation of geometry that no longer exists
+    auto& cachedEntries = tessellationCache.entries;
+    cachedEntries.erase(cachedEntries.lower_bound(geolistfacade.getInternalCount()),
+                        cachedEntries.end());
+    cachedEntries.erase(cachedEntries.begin(),
+                        cachedEntries.lower_bound(-geolistfacade.getExternalCount()));
+    tessellationCache.changedGeoIds.clear();
+    tessellationCache.reusedCount = 0;
+
     // end information layer
     Points.clear();
     Coords.clear();
@@ -350,46 +367,93 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
     }
 
     // Curves
-    if constexpr (curvemode == CurveMode::StartEndPointsOnly) {
-        addPoint(Coords[coinLayer][subLayer], geo->getStartPoint());
-        addPoint(Coords[coinLayer][subLayer], geo->getEndPoint());
-        Index[coinLayer][subLayer].push_back(2);
-    }
-    else if constexpr (curvemode == CurveMode::ClosedCurve) {
-        int numSegments = drawingParameters.curvedEdgeCountSegments;
-        if constexpr (std::is_same<GeoType, Part::GeomBSplineCurve>::value) {
-            numSegments *= geo->countKnots();
+    if constexpr (curvemode != CurveMode::NoCurve) {
+        const auto& coords = tessellate<GeoType, curvemode, analysemode>(geo, geoid);
+
+        for (const auto& pnt : coords) {
+            addPoint(Coords[coinLayer][subLayer], pnt);
         }
 
-        double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
+        Index[coinLayer][subLayer].push_back(coords.size());
+    }
+    else {
+        tessellate<GeoType, curvemode, analysemode>(geo, geoid);
+    }
+}
 
-        for (int i = 0; i < numSegments; i++) {
-            Base::Vector3d pnt = geo->value(i * segment);
-            addPoint(Coords[coinLayer][subLayer], pnt);
+template<typename GeoType,
+         EditModeGeometryCoinConverter::CurveMode curvemode,
+         EditModeGeometryCoinConverter::AnalyseMode analysemode>
+const std::vector<Base::Vector3d>&
+EditModeGeometryCoinConverter::tessellate(const GeoType* geo, int geoid)
+{
+    auto& entry = tessellationCache.entries[geoid];
+
+    // Points and line segments are defined by the coordinates drawn for them. Curves are compared
+    // with the copy they were last tessellated from.
+    if constexpr (curvemode == CurveMode::NoCurve || curvemode == CurveMode::StartEndPointsOnly) {
+        std::vector<Base::Vector3d> coords;
+        if constexpr (curvemode == CurveMode::NoCurve) {
+            coords = {geo->getPoint()};
+        }
+        else {
+            coords = {geo->getStartPoint(), geo->getEndPoint()};
         }
 
-        Base::Vector3d pnt = geo->value(0);
-        addPoint(Coords[coinLayer][subLayer], pnt);
+        auto isSamePoint = [](const Base::Vector3d& p1, const Base::Vector3d& p2) {
+            return Base::DistanceP2(p1, p2) <= Precision::SquareConfusion();
+        };
 
-        Index[coinLayer][subLayer].push_back(numSegments + 1);
+        if (!entry.geometry && entry.coords.size() == coords.size()
+            && std::equal(coords.begin(), coords.end(), entry.coords.begin(), isSamePoint)) {
+            tessellationCache.reusedCount++;
+            return entry.coords;
+        }
+
+        entry = TessellationCache::Entry();
+        entry.coords = std::move(coords);
     }
-    else if constexpr (curvemode == CurveMode::OpenCurve) {
+    else {
         int numSegments = drawingParameters.curvedEdgeCountSegments;
         if constexpr (std::is_same<GeoType, Part::GeomBSplineCurve>::value) {
-            numSegments *= (geo->countKnots() - 1);  // one less segments than knots
+            if constexpr (curvemode == CurveMode::ClosedCurve) {
+                numSegments *= geo->countKnots();
+            }
+            else {
+                numSegments *= (geo->countKnots() - 1);  // one less segments than knots
+            }
         }
 
+        if (entry.geometry && entry.numSegments == numSegments
+            && entry.geometry->isSame(*geo, Precision::Confusion(), Precision::Angular())) {
+            if (entry.combRepresentationScale > combrepscale) {
+                combrepscale = entry.combRepresentationScale;
+            }
+            tessellationCache.reusedCount++;
+            return entry.coords;
+        }
+
+        entry = TessellationCache::Entry();
+        entry.geometry.reset(geo->clone());
+        entry.numSegments = numSegments;
+        entry.coords.reserve(numSegments + 1);
+
         double segment = (geo->getLastParameter() - geo->getFirstParameter()) / numSegments;
 
-        for (int i = 0; i < numSegments; i++) {
-            Base::Vector3d pnt = geo->value(geo->getFirstParameter() + i * segment);
-            addPoint(Coords[coinLayer][subLayer], pnt);
-        }
+        if constexpr (curvemode == CurveMode::ClosedCurve) {
+            for (int i = 0; i < numSegments; i++) {
+                entry.coords.push_back(geo->value(i * segment));
+            }
 
-        Base::Vector3d pnt = geo->value(geo->getLastParameter());
-        addPoint(Coords[coinLayer][subLayer], pnt);
+            entry.coords.push_back(geo->value(0));
+        }
+        else {
+            for (int i = 0; i < numSegments; i++) {
+                entry.coords.push_back(geo->value(geo->getFirstParameter() + i * segment));
+            }
 
-        Index[coinLayer][subLayer].push_back(numSegments + 1);
+            entry.coords.push_back(geo->value(geo->getLastParameter()));
+        }
 
         if constexpr (analysemode == AnalyseMode::BoundingBoxMagnitudeAndBSplineCurvature) {
             //***************************************************************************************************************
@@ -456,11 +520,17 @@ void EditModeGeometryCoinConverter::convert(const Sketcher::GeometryFacade* geom
                     / maxcurv;  // just a factor to make a comb reasonably visible
             }
 
+            entry.combRepresentationScale = temprepscale;
+
             if (temprepscale > combrepscale) {
                 combrepscale = temprepscale;
             }
         }
     }
+
+    tessellationCache.changedGeoIds.insert(geoid);
+
+    return entry.coords;
 }
 
 float EditModeGeometryCoinConverter::getBoundingBoxMaxMagnitude()
@@ -54,6 +54,7 @@ struct GeometryLayerNodes;
 struct DrawingParameters;
 class GeometryLayerParameters;
 struct CoinMapping;
+struct TessellationCache;
 
 /** @brief      Class for creating the Geometry layer into coin nodes
  *  @details
@@ -70,6 +71,9 @@ struct CoinMapping;
  *
  * Analysis performs analysis such as maximum boundingbox magnitude of all geometries and maximum
  * curvature of BSplines
+ *
+ * The tessellation and the curvature of the geometry are kept in a TessellationCache, so that only
+ * the geometry that changed since the previous conversion is tessellated again.
  */
 class EditModeGeometryCoinConverter
 {
@@ -108,12 +112,15 @@ public:
      * the geometry
      *
      * @param drawingparameters: Parameters for drawing the overlay information
+     *
+     * @param tessellationcache: The tessellation of the previous conversion, which is updated
      */
     EditModeGeometryCoinConverter(ViewProviderSketch& vp,
                                   GeometryLayerNodes& geometrylayernodes,
                                   DrawingParameters& drawingparameters,
                                   GeometryLayerParameters& geometryLayerParams,
-                                  CoinMapping& coinMap);
+                                  CoinMapping& coinMap,
+                                  TessellationCache& tessellationcache);
 
     /**
      * converts the geometry defined by GeometryLayer into the coin nodes.
@@ -156,6 +163,11 @@ private:
                  [[maybe_unused]] int geoId,
                  [[maybe_unused]] int subLayerId = 0);
 
+    /// returns the coordinates of the points or the polyline of the geometry, which is only
+    /// tessellated again if it changed since the last conversion
+    template<typename GeoType, CurveMode curvemode, AnalyseMode analysemode>
+    const std::vector<Base::Vector3d>& tessellate(const GeoType* geo, int geoId);
+
 private:
     /// Reference to ViewProviderSketch in order to access the public and the Attorney Interface
     ViewProviderSketch& viewProvider;
@@ -177,6 +189,7 @@ private:
     GeometryLayerParameters& geometryLayerParameters;
     // Mappings coin geoId
     CoinMapping& coinMapping;
+    TessellationCache& tessellationCache;
 
     // measurements
     float boundingBoxMaxMagnitude = 100;
@@ -58,13 +58,15 @@ EditModeGeometryCoinManager::EditModeGeometryCoinManager(
     GeometryLayerParameters& geometryLayerParams,
     AnalysisResults& analysisResultStruct,
     EditModeScenegraphNodes& editModeScenegraph,
-    CoinMapping& coinMap)
+    CoinMapping& coinMap,
+    TessellationCache& tessellationcache)
     : viewProvider(vp)
     , drawingParameters(drawingParams)
     , geometryLayerParameters(geometryLayerParams)
     , analysisResults(analysisResultStruct)
     , editModeScenegraphNodes(editModeScenegraph)
     , coinMapping(coinMap)
+    , tessellationCache(tessellationcache)
 {}
 
 EditModeGeometryCoinManager::~EditModeGeometryCoinManager()
@@ -106,7 +108,8 @@ void EditModeGeometryCoinManager::processGeometry(const GeoListFacade& geolistfa
                                          geometrylayernodes,
                                          drawingParameters,
                                          geometryLayerParameters,
-                                         coinMapping);
+                                         coinMapping,
+                                         tessellationCache);
 
     gcconv.convert(geolistfacade);
 
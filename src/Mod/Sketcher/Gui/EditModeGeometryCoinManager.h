@@ -91,7 +91,8 @@ public:
                                          GeometryLayerParameters& geometryLayerParams,
                                          AnalysisResults& analysisResultStruct,
                                          EditModeScenegraphNodes& editModeScenegraph,
-                                         CoinMapping& coinMap);
+                                         CoinMapping& coinMap,
+                                         TessellationCache& tessellationcache);
     ~EditModeGeometryCoinManager();
 
 
@@ -122,6 +123,8 @@ private:
     EditModeScenegraphNodes& editModeScenegraphNodes;
 
     CoinMapping& coinMapping;
+
+    TessellationCache& tessellationCache;
 };
 
 
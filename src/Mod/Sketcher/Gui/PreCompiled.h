@@ -39,6 +39,7 @@
 // STL
 #include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
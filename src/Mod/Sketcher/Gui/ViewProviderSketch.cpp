@@ -2816,7 +2816,17 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationoverl
     // ==================================
 
     editCoinManager->processGeometryConstraintsInformationOverlay(geolistfacade,
-                                                                  rebuildinformationoverlay);
+                                                                  rebuildinformationoverlay,
+                                                                  temp);
+
+    // Set the parameter BaseApp/LogLevels/Sketch to 3 to print the timings of each draw
+    const RedrawTimings& timings = getRedrawTimings();
+    FC_LOG("draw" << (temp ? " (temp)" : "") << ": total " << timings.total << " s, geometry "
+                  << timings.geometry << " s (" << timings.tessellatedGeometries
+                  << " tessellated, " << timings.reusedGeometries << " reused), overlay "
+                  << timings.overlay << " s, constraints " << timings.constraints << " s ("
+                  << timings.updatedConstraints << " updated, " << timings.skippedConstraints
+                  << " skipped)");
 
     // Avoids unneeded calls to pixmapFromSvg
     if (Mode == STATUS_NONE || Mode == STATUS_SKETCH_UseHandler) {
@@ -2830,6 +2840,13 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationoverl
     }
 }
 
+const RedrawTimings& ViewProviderSketch::getRedrawTimings() const
+{
+    assert(isInEditMode());
+
+    return editCoinManager->getRedrawTimings();
+}
+
 void ViewProviderSketch::setIsShownVirtualSpace(bool isshownvirtualspace)
 {
     viewProviderParameters.isShownVirtualSpace = isshownvirtualspace;
@@ -91,6 +91,7 @@ namespace SketcherGui
 
 class EditModeCoinManager;
 class SnapManager;
+struct RedrawTimings;
 class DrawSketchHandler;
 
 using GeoList = Sketcher::GeoList;
@@ -570,6 +571,9 @@ public:
     /// recreateinformationscenography => forces a rebuild of the information overlay scenography
     void draw(bool temp = false, bool rebuildinformationoverlay = true);
 
+    /// CPU time spent in updating the inventor nodes by the last draw
+    const RedrawTimings& getRedrawTimings() const;
+
     /// helper change the color of the sketch according to selection and solver status
     void updateColor();
     //@}
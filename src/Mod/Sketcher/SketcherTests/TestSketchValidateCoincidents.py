@@ -207,6 +207,29 @@ class TestSketchValidateCoincidents(unittest.TestCase):
             len(doc.Sketch001.ExternalGeo), 3
         )  # Two axis, plus one the reference to deleted geometry
 
+    def testMissingCoincidentsOneByOneCase(self):
+        sketch = self.Doc.addObject("Sketcher::SketchObject", "Sketch")
+        for i in range(3):
+            x = 20.0 * i
+            # the corners are slightly apart, not only along one axis
+            corners = [
+                Vector(x, 0, 0),
+                Vector(x + 10, 0, 0),
+                Vector(x + 10, 10, 0),
+                Vector(x, 10, 0),
+            ]
+            for j in range(4):
+                start = corners[j]
+                end = corners[(j + 1) % 4] + Vector(1.0e-6, -1.0e-6, 0)
+                sketch.addGeometry(Part.LineSegment(start, end))
+        self.Doc.recompute()
+        self.assertEqual(sketch.detectMissingPointOnPointConstraints(0.0001), 12)
+        sketch.makeMissingPointOnPointCoincident(True)
+        self.Doc.recompute()
+        self.assertEqual(sketch.ConstraintCount, 12)
+        self.assertEqual(sketch.detectMissingPointOnPointConstraints(0.0001), 0)
+        del sketch
+
     def tearDown(self):
         # closing doc
         FreeCAD.closeDocument(self.Doc.Name)
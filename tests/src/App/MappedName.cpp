@@ -5,6 +5,7 @@
 #include "App/ComplexGeoData.h"
 #include "App/MappedName.h"
 
+#include <limits>
 #include <string>
 
 // NOLINTBEGIN(readability-magic-numbers)
@@ -649,6 +650,38 @@ TEST(MappedName, compare)
     EXPECT_EQ(mappedName1 < mappedName6, true);
 }
 
+TEST(MappedName, compareAcrossPostfix)
+{
+    // Arrange
+    Data::MappedName mappedName1(Data::MappedName("TESTPOSTFIX"));
+    Data::MappedName mappedName2(Data::MappedName("T"), "ESTPOSTFIX");
+    Data::MappedName mappedName3(Data::MappedName("TESTPOST"), "FIXA");
+    Data::MappedName mappedName4(Data::MappedName("TESTPOSTFI"), "W");
+    Data::MappedName mappedName5(Data::MappedName("TESTPOSTFI"));
+
+    // Act & Assert
+    EXPECT_EQ(mappedName1.compare(mappedName2), 0);
+    EXPECT_EQ(mappedName2.compare(mappedName1), 0);
+    EXPECT_EQ(mappedName1.compare(mappedName3), -1);
+    EXPECT_EQ(mappedName3.compare(mappedName2), 1);
+    EXPECT_EQ(mappedName2.compare(mappedName4), 1);
+    EXPECT_EQ(mappedName4.compare(mappedName1), -1);
+    EXPECT_EQ(mappedName5.compare(mappedName2), -1);
+    EXPECT_EQ(mappedName2.compare(mappedName5), 1);
+}
+
+TEST(MappedName, compareSignedChars)
+{
+    // Arrange
+    Data::MappedName mappedName1(Data::MappedName("TEST"), "\xe4");
+    Data::MappedName mappedName2(Data::MappedName("TEST"), "A");
+
+    // Act & Assert
+    // Characters are compared as 'char' like MappedName::operator[] returns them
+    EXPECT_EQ(mappedName1.compare(mappedName2), std::numeric_limits<char>::is_signed ? -1 : 1);
+    EXPECT_EQ(mappedName2.compare(mappedName1), std::numeric_limits<char>::is_signed ? 1 : -1);
+}
+
 TEST(MappedName, subscriptOperator)
 {
     // Arrange
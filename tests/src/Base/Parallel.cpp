@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Base/Parallel.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+TEST(BaseParallelSuite, CallsEveryIndexOnce)
+{
+    std::vector<std::atomic<int>> calls(1000);
+    Base::runConcurrently(calls.size(), [&calls](std::size_t index) {
+        calls[index]++;
+    });
+
+    for (const auto& it : calls) {
+        EXPECT_EQ(it.load(), 1);
+    }
+}
+
+TEST(BaseParallelSuite, NoIndices)
+{
+    bool called = false;
+    Base::runConcurrently(0, [&called](std::size_t) {
+        called = true;
+    });
+
+    EXPECT_FALSE(called);
+}
+
+TEST(BaseParallelSuite, RethrowsException)
+{
+    EXPECT_THROW(Base::runConcurrently(100,
+                                       [](std::size_t index) {
+                                           if (index == 50) {
+                                               throw std::runtime_error("failed");
+                                           }
+                                       }),
+                 std::runtime_error);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
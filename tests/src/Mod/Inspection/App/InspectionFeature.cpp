@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Base/Vector3D.h>
+#include "Mod/Inspection/App/InspectionFeature.h"
+#include <src/App/InitApplication.h>
+
+// NOLINTBEGIN
+class InspectionFeatureTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    // The search radius of the fast engine covers all points used below
+    static constexpr float radius = 5.0F;
+
+    static void compareEngines(const TopoDS_Shape& shape, const std::vector<Base::Vector3f>& points)
+    {
+        Inspection::InspectNominalShape exact(shape, radius);
+        Inspection::InspectNominalFastShape fast(shape, radius);
+        for (const auto& point : points) {
+            EXPECT_NEAR(fast.getDistance(point), exact.getDistance(point), 1e-4)
+                << "at " << point.x << ", " << point.y << ", " << point.z;
+        }
+    }
+};
+
+TEST_F(InspectionFeatureTest, fastDistanceToBox)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    Inspection::InspectNominalFastShape fast(box, radius);
+
+    EXPECT_NEAR(fast.getDistance(Base::Vector3f(5.0F, 5.0F, 12.0F)), 2.0, 1e-4);
+    EXPECT_NEAR(fast.getDistance(Base::Vector3f(5.0F, 5.0F, 9.0F)), -1.0, 1e-4);
+    EXPECT_NEAR(fast.getDistance(Base::Vector3f(12.0F, 12.0F, 5.0F)), std::sqrt(8.0), 1e-4);
+    EXPECT_NEAR(fast.getDistance(Base::Vector3f(11.0F, 12.0F, 13.0F)), std::sqrt(14.0), 1e-4);
+    // outside of the search radius
+    EXPECT_EQ(fast.getDistance(Base::Vector3f(20.0F, 5.0F, 5.0F)), FLT_MAX);
+}
+
+TEST_F(InspectionFeatureTest, fastAndExactDistanceToBox)
+{
+    // points near faces, edges and corners, inside and outside
+    compareEngines(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(),
+                   {{5.0F, 5.0F, 12.0F},
+                    {5.0F, 5.0F, 9.0F},
+                    {-1.0F, 5.0F, 5.0F},
+                    {12.0F, 12.0F, 5.0F},
+                    {11.0F, 12.0F, 13.0F},
+                    {2.0F, 3.0F, 4.0F},
+                    {5.0F, 5.0F, 10.0F}});
+}
+
+TEST_F(InspectionFeatureTest, fastAndExactDistanceToCylinder)
+{
+    compareEngines(BRepPrimAPI_MakeCylinder(5.0, 10.0).Shape(),
+                   {{0.0F, 0.0F, 12.0F},
+                    {0.0F, 0.0F, 9.0F},
+                    {6.0F, 0.0F, 5.0F},
+                    {3.0F, 0.0F, 5.0F},
+                    {4.0F, 3.0F, 11.0F},
+                    {6.0F, 0.0F, 11.0F},
+                    {0.0F, 4.0F, 0.5F}});
+}
+// NOLINTEND
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <BRep_Builder.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp_Pnt.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
+
+#include <App/Application.h>
+#include "Mod/Part/App/ClusteredFuse.h"
+#include "Mod/Part/App/TopoShapeOpCode.h"
+#include <src/App/InitApplication.h>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN
+class ClusteredFuseTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void TearDown() override
+    {
+        getParameter()->RemoveInt("ClusteredFuseThreshold");
+    }
+
+    static Base::Reference<ParameterGrp> getParameter()
+    {
+        return App::GetApplication().GetUserParameter().GetGroup(
+            "BaseApp/Preferences/Mod/Part/Boolean");
+    }
+
+    static void setThreshold(int count)
+    {
+        getParameter()->SetInt("ClusteredFuseThreshold", count);
+    }
+
+    // Two overlapping boxes at x = 0, a single box at x = 5 and two overlapping boxes at x = 10
+    static std::vector<TopoDS_Shape> makeBoxes()
+    {
+        std::vector<TopoDS_Shape> shapes;
+        for (double x : {10.5, 0.0, 5.0, 10.0, 0.5}) {
+            shapes.push_back(BRepPrimAPI_MakeBox(gp_Pnt(x, 0, 0), 1, 1, 1).Shape());
+        }
+        return shapes;
+    }
+
+    // A row of boxes where each box overlaps the next one, so they form a single cluster
+    static std::vector<TopoDS_Shape> makeRow(int count)
+    {
+        std::vector<TopoDS_Shape> shapes;
+        for (int i = 0; i < count; i++) {
+            gp_Pnt corner(0.5 * i, 0.2 * (i % 2), 0);
+            shapes.push_back(BRepPrimAPI_MakeBox(corner, 1, 1, 1).Shape());
+        }
+        return shapes;
+    }
+
+    static std::vector<Part::TopoShape> makeTopoShapes(const std::vector<TopoDS_Shape>& shapes)
+    {
+        std::vector<Part::TopoShape> result;
+        long tag = 1;
+        for (const auto& shape : shapes) {
+            result.emplace_back(shape, tag++);
+        }
+        return result;
+    }
+
+    static int countSolids(const TopoDS_Shape& shape)
+    {
+        int count = 0;
+        for (TopExp_Explorer xp(shape, TopAbs_SOLID); xp.More(); xp.Next()) {
+            count++;
+        }
+        return count;
+    }
+
+    // The bounding boxes of the elements by their mapped names
+    static std::map<std::string, Base::BoundBox3d> namedElements(const Part::TopoShape& shape)
+    {
+        std::map<std::string, Base::BoundBox3d> result;
+        for (const auto& element : shape.getElementMap()) {
+            result[element.name.toString()] =
+                shape.getSubTopoShape(element.index.toString().c_str()).getBoundBox();
+        }
+        return result;
+    }
+};
+
+TEST_F(ClusteredFuseTest, makeClusters)
+{
+    // Arrange
+    auto shapes = makeBoxes();
+
+    // Act
+    auto clusters = Part::ClusteredFuse::makeClusters(shapes, 0.0);
+
+    // Assert
+    ASSERT_EQ(clusters.size(), 3);
+    EXPECT_EQ(clusters[0], std::vector<int>({0, 3}));
+    EXPECT_EQ(clusters[1], std::vector<int>({1, 4}));
+    EXPECT_EQ(clusters[2], std::vector<int>({2}));
+}
+
+TEST_F(ClusteredFuseTest, makeClustersWithGap)
+{
+    // Arrange
+    auto shapes = makeBoxes();
+
+    // Act
+    auto clusters = Part::ClusteredFuse::makeClusters(shapes, 2.5);
+
+    // Assert
+    ASSERT_EQ(clusters.size(), 1);
+    EXPECT_EQ(clusters[0].size(), shapes.size());
+}
+
+TEST_F(ClusteredFuseTest, fuseClusters)
+{
+    // Arrange
+    Part::ClusteredFuse mkFuse(makeBoxes(), -1.0);
+
+    // Act
+    mkFuse.build();
+
+    // Assert
+    EXPECT_FALSE(mkFuse.shape().IsNull());
+    EXPECT_EQ(countSolids(mkFuse.shape()), 3);
+    EXPECT_NEAR(PartTestHelpers::getVolume(mkFuse.shape()), 4.0, 1e-7);
+}
+
+TEST_F(ClusteredFuseTest, compoundClusters)
+{
+    // Arrange
+    auto shapes = makeBoxes();
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(20, 0, 0), 1, 1, 1).Shape());
+    shapes.push_back(comp);
+    Part::ClusteredFuse mkFuse(shapes, 0.0);
+
+    // Act
+    mkFuse.build();
+
+    // Assert
+    ASSERT_EQ(mkFuse.shape().ShapeType(), TopAbs_COMPOUND);
+    int count = 0;
+    for (TopoDS_Iterator it(mkFuse.shape()); it.More(); it.Next()) {
+        EXPECT_EQ(it.Value().ShapeType(), TopAbs_SOLID);
+        count++;
+    }
+    EXPECT_EQ(count, 4);
+    EXPECT_NEAR(PartTestHelpers::getVolume(mkFuse.shape()), 5.0, 1e-7);
+}
+
+TEST_F(ClusteredFuseTest, mapUnchangedShapes)
+{
+    // Arrange
+    auto shapes = makeBoxes();
+    Part::ClusteredFuse mkFuse(shapes, 0.0);
+    mkFuse.build();
+    TopExp_Explorer xp(shapes[2], TopAbs_FACE);
+
+    // Act
+    const auto& modified = mkFuse.modified(xp.Current());
+
+    // Assert
+    EXPECT_TRUE(modified.empty());
+}
+
+TEST_F(ClusteredFuseTest, fuseBottomUp)
+{
+    // Arrange
+    setThreshold(3);
+    auto shapes = makeRow(10);
+    Part::ClusteredFuse mkFuse(shapes, -1.0);
+    Part::TopoShape result;
+
+    // Act
+    mkFuse.build();
+    result.makeShapeWithElementMap(mkFuse.shape(),
+                                   mkFuse,
+                                   makeTopoShapes(shapes),
+                                   Part::OpCodes::Fuse);
+
+    // Assert
+    EXPECT_EQ(countSolids(mkFuse.shape()), 1);
+    EXPECT_NEAR(PartTestHelpers::getVolume(mkFuse.shape()), 6.4, 1e-7);
+    for (int i = 1; i <= result.countSubShapes(TopAbs_FACE); i++) {
+        EXPECT_TRUE(result.getMappedName(Data::IndexedName::fromConst("Face", i)));
+    }
+}
+
+TEST_F(ClusteredFuseTest, makeElementBoolean)
+{
+    // Arrange
+    setThreshold(2);
+    auto shapes = makeTopoShapes(makeBoxes());
+    Part::TopoShape clustered;
+    Part::TopoShape single;
+
+    // Act
+    clustered.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    setThreshold(0);
+    single.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+
+    // Assert
+    EXPECT_NEAR(PartTestHelpers::getVolume(clustered.getShape()),
+                PartTestHelpers::getVolume(single.getShape()),
+                1e-7);
+    EXPECT_EQ(clustered.countSubShapes(TopAbs_FACE), single.countSubShapes(TopAbs_FACE));
+    EXPECT_EQ(clustered.getElementMapSize(), single.getElementMapSize());
+}
+
+TEST_F(ClusteredFuseTest, elementNamesAreStable)
+{
+    // Arrange
+    setThreshold(2);
+    auto shapes = makeTopoShapes(makeBoxes());
+    Part::TopoShape clustered;
+    Part::TopoShape single;
+
+    // Act
+    clustered.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    setThreshold(0);
+    single.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+
+    // Assert: Every cluster is fused in one operation, so the same names refer to the same
+    // elements as if all shapes were fused at once
+    auto clusteredElements = namedElements(clustered);
+    auto singleElements = namedElements(single);
+    ASSERT_EQ(clusteredElements.size(), singleElements.size());
+    for (const auto& it : singleElements) {
+        auto jt = clusteredElements.find(it.first);
+        ASSERT_TRUE(jt != clusteredElements.end()) << it.first;
+        EXPECT_TRUE(PartTestHelpers::boxesMatch(jt->second, it.second)) << it.first;
+    }
+}
+
+TEST_F(ClusteredFuseTest, defaultFuseIsNotClustered)
+{
+    // Arrange
+    auto shapes = makeTopoShapes(makeRow(60));
+    Part::TopoShape fused;
+    Part::TopoShape single;
+
+    // Act
+    fused.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    setThreshold(0);
+    single.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+
+    // Assert: Without the parameter many shapes are still fused in one operation, so the
+    // element map is the same as before the clustering existed
+    auto fusedElements = namedElements(fused);
+    auto singleElements = namedElements(single);
+    ASSERT_EQ(fusedElements.size(), singleElements.size());
+    for (const auto& it : singleElements) {
+        auto jt = fusedElements.find(it.first);
+        ASSERT_TRUE(jt != fusedElements.end()) << it.first;
+        EXPECT_TRUE(PartTestHelpers::boxesMatch(jt->second, it.second)) << it.first;
+    }
+}
+
+TEST_F(ClusteredFuseTest, elementNamesAreReproducible)
+{
+    // Arrange
+    setThreshold(3);
+    auto shapes = makeTopoShapes(makeRow(10));
+    Part::TopoShape first;
+    Part::TopoShape second;
+
+    // Act
+    first.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+    second.makeElementBoolean(Part::OpCodes::Fuse, shapes);
+
+    // Assert: The operations run concurrently, but the names don't depend on their order
+    auto firstElements = namedElements(first);
+    auto secondElements = namedElements(second);
+    ASSERT_EQ(firstElements.size(), secondElements.size());
+    for (const auto& it : firstElements) {
+        auto jt = secondElements.find(it.first);
+        ASSERT_TRUE(jt != secondElements.end()) << it.first;
+        EXPECT_TRUE(PartTestHelpers::boxesMatch(jt->second, it.second)) << it.first;
+    }
+}
+// NOLINTEND
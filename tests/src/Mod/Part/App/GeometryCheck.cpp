@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <BRep_Builder.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp_Pnt.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Shell.hxx>
+#include <TopoDS_Solid.hxx>
+
+#include "Mod/Part/App/GeometryCheck.h"
+
+// NOLINTBEGIN
+class GeometryCheckTest: public ::testing::Test
+{
+protected:
+    // Collects the results and optionally cancels the check after the first one
+    class Check: public Part::GeometryCheck
+    {
+    public:
+        struct Entry
+        {
+            std::size_t owner;
+            std::size_t index;
+            bool valid;
+            std::size_t issues;
+            bool bopCheck;
+            std::vector<BOPAlgo_CheckStatus> bopStatuses;
+        };
+        std::vector<Entry> entries;
+        bool cancelAfterFirst {false};
+
+    protected:
+        void onResult(const Result& result) override
+        {
+            std::vector<BOPAlgo_CheckStatus> bopStatuses;
+            for (const auto& it : result.bopFaults) {
+                bopStatuses.push_back(it.status);
+            }
+            entries.push_back({result.owner,
+                               result.index,
+                               result.isValid(),
+                               result.issues().size(),
+                               result.bopCheck,
+                               bopStatuses});
+            if (cancelAfterFirst) {
+                cancel();
+            }
+        }
+    };
+
+    static TopoDS_Shape makeBoxes(int count)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (int i = 0; i < count; i++) {
+            builder.Add(comp, BRepPrimAPI_MakeBox(gp_Pnt(2.0 * i, 0, 0), 1, 1, 1).Shape());
+        }
+        return comp;
+    }
+
+    // A solid with a single face is not closed
+    static TopoDS_Shape makeOpenSolid()
+    {
+        TopExp_Explorer xp(BRepPrimAPI_MakeBox(1, 1, 1).Shape(), TopAbs_FACE);
+        BRep_Builder builder;
+        TopoDS_Shell shell;
+        builder.MakeShell(shell);
+        builder.Add(shell, xp.Current());
+        TopoDS_Solid solid;
+        builder.MakeSolid(solid);
+        builder.Add(solid, shell);
+        return solid;
+    }
+};
+
+TEST_F(GeometryCheckTest, splitCompounds)
+{
+    // Arrange
+    Check check;
+    BRep_Builder builder;
+    TopoDS_Compound nested;
+    builder.MakeCompound(nested);
+    builder.Add(nested, makeBoxes(3));
+    builder.Add(nested, BRepPrimAPI_MakeBox(1, 1, 1).Shape());
+
+    // Act
+    auto first = check.addShape(nested);
+    auto second = check.addShape(TopoDS_Shape());
+    auto third = check.addShape(makeBoxes(2));
+
+    // Assert
+    EXPECT_EQ(first, 0U);
+    EXPECT_EQ(second, 1U);
+    EXPECT_EQ(third, 2U);
+    EXPECT_EQ(check.countParts(), 6U);
+}
+
+TEST_F(GeometryCheckTest, resultsInOrder)
+{
+    // Arrange
+    Check check;
+    check.addShape(makeBoxes(20));
+    check.addShape(makeOpenSolid());
+    check.addShape(makeBoxes(5));
+
+    // Act
+    check.perform();
+
+    // Assert
+    ASSERT_EQ(check.entries.size(), 26U);
+    for (std::size_t i = 0; i < check.entries.size(); i++) {
+        EXPECT_EQ(check.entries[i].index, i);
+    }
+    EXPECT_EQ(check.entries[0].owner, 0U);
+    EXPECT_EQ(check.entries[20].owner, 1U);
+    EXPECT_EQ(check.entries[21].owner, 2U);
+    EXPECT_FALSE(check.entries[20].valid);
+    EXPECT_GT(check.entries[20].issues, 0U);
+    EXPECT_TRUE(check.entries[0].valid);
+    EXPECT_EQ(check.entries[0].issues, 0U);
+}
+
+TEST_F(GeometryCheckTest, serialAndParallelAgree)
+{
+    // Arrange
+    Check parallel;
+    Check serial;
+    Part::GeometryCheck::Options options;
+    options.parallel = false;
+    serial.setOptions(options);
+    for (auto check : {&parallel, &serial}) {
+        check->addShape(makeBoxes(4));
+        check->addShape(makeOpenSolid());
+    }
+
+    // Act
+    parallel.perform();
+    serial.perform();
+
+    // Assert
+    ASSERT_EQ(parallel.entries.size(), serial.entries.size());
+    for (std::size_t i = 0; i < serial.entries.size(); i++) {
+        EXPECT_EQ(parallel.entries[i].valid, serial.entries[i].valid);
+        EXPECT_EQ(parallel.entries[i].issues, serial.entries[i].issues);
+    }
+}
+
+TEST_F(GeometryCheckTest, bopCheckOfCompound)
+{
+    for (bool parallel : {true, false}) {
+        // Arrange
+        Check check;
+        Part::GeometryCheck::Options options;
+        options.runBopCheck = true;
+        options.parallel = parallel;
+        check.setOptions(options);
+        BRep_Builder builder;
+        TopoDS_Compound overlapping;
+        builder.MakeCompound(overlapping);
+        builder.Add(overlapping, BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 2, 2, 2).Shape());
+        builder.Add(overlapping, BRepPrimAPI_MakeBox(gp_Pnt(1, 1, 1), 2, 2, 2).Shape());
+        check.addShape(overlapping);
+        check.addShape(makeOpenSolid());
+        check.addShape(makeBoxes(3));
+
+        // Act
+        check.perform();
+
+        // Assert: Each box is valid on its own, but the members of the compound intersect.
+        // The shape with a BRepCheck error is not checked by BOPAlgo_ArgumentAnalyzer.
+        EXPECT_EQ(check.countResults(), 9U);
+        ASSERT_EQ(check.entries.size(), 8U);
+        EXPECT_TRUE(check.entries[0].valid);
+        EXPECT_TRUE(check.entries[1].valid);
+        EXPECT_TRUE(check.entries[2].bopCheck);
+        EXPECT_EQ(check.entries[2].owner, 0U);
+        EXPECT_FALSE(check.entries[2].valid);
+        const auto& statuses = check.entries[2].bopStatuses;
+        EXPECT_NE(std::find(statuses.begin(), statuses.end(), BOPAlgo_SelfIntersect),
+                  statuses.end());
+        EXPECT_FALSE(check.entries[3].bopCheck);
+        EXPECT_FALSE(check.entries[3].valid);
+        EXPECT_EQ(check.entries[4].owner, 2U);
+        EXPECT_TRUE(check.entries[7].bopCheck);
+        EXPECT_TRUE(check.entries[7].valid);
+    }
+}
+
+TEST_F(GeometryCheckTest, cancel)
+{
+    // Arrange
+    Check check;
+    check.cancelAfterFirst = true;
+    check.addShape(makeBoxes(50));
+
+    // Act
+    check.perform();
+
+    // Assert
+    EXPECT_TRUE(check.isCancelled());
+    EXPECT_EQ(check.entries.size(), 1U);
+}
+
+TEST_F(GeometryCheckTest, statusStrings)
+{
+    EXPECT_STREQ(Part::GeometryCheck::statusToString(BRepCheck_NotClosed), "Not closed");
+    EXPECT_STREQ(Part::GeometryCheck::bopStatusToString(BOPAlgo_SelfIntersect),
+                 "BOPAlgo SelfIntersect");
+}
+// NOLINTEND
@@ -230,3 +230,51 @@ TEST_F(FeaturePartTest, getComplexElementTypes)
     EXPECT_STREQ(types[1], "Edge");
     EXPECT_STREQ(types[2], "Vertex");
 }
+
+TEST_F(FeaturePartTest, getTopoShapeCache)
+{
+    // Arrange
+    Feature::clearShapeCache();
+    Feature::resetShapeCacheStats();
+
+    // Act
+    auto first = Feature::getTopoShape(_boxes[0]);
+    auto second = Feature::getTopoShape(_boxes[0]);
+    auto stats = Feature::getShapeCacheStats();
+    _boxes[0]->Length.setValue(2.0);
+    _boxes[0]->recomputeFeature();
+    auto changedStats = Feature::getShapeCacheStats();
+    auto changed = Feature::getTopoShape(_boxes[0]);
+
+    // Assert
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_GE(stats.misses, 1);
+    EXPECT_GE(stats.entries, 1);
+    EXPECT_TRUE(first.getShape().IsEqual(second.getShape()));
+    EXPECT_EQ(changedStats.entries, 0);
+    EXPECT_DOUBLE_EQ(getVolume(changed.getShape()), 2.0 * getVolume(first.getShape()));
+}
+
+TEST_F(FeaturePartTest, getTopoShapeCacheKeepsUnrelatedObjects)
+{
+    // Arrange
+    _common->Base.setValue(_boxes[0]);
+    _common->Tool.setValue(_boxes[1]);
+    Feature::getTopoShape(_boxes[0]);
+    Feature::getTopoShape(_boxes[2]);
+    Feature::getTopoShape(_common);
+    Feature::resetShapeCacheStats();
+
+    // Act
+    _boxes[0]->Length.setValue(2.0);
+    Feature::getTopoShape(_boxes[2]);
+    auto unchangedStats = Feature::getShapeCacheStats();
+    Feature::getTopoShape(_common);
+    auto changedStats = Feature::getShapeCacheStats();
+
+    // Assert: The common depends on the changed box, the other box doesn't
+    EXPECT_EQ(unchangedStats.hits, 1);
+    EXPECT_EQ(unchangedStats.misses, 0);
+    EXPECT_EQ(changedStats.hits, 1);
+    EXPECT_GE(changedStats.misses, 1);
+}
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <TopLoc_Location.hxx>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "Mod/Part/App/PartFeature.h"
+#include "Mod/Part/App/ShapePool.h"
+#include "Mod/Part/App/TopoShape.h"
+#include <src/App/InitApplication.h>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN
+class ShapePoolTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Part::ShapePool::initialize();
+    }
+
+    void SetUp() override
+    {
+        getParameter()->SetBool("ShareGeometry", true);
+        fileName = App::Application::getTempFileName("ShapePool") + ".FCStd";
+    }
+
+    void TearDown() override
+    {
+        for (auto doc : docs) {
+            App::GetApplication().closeDocument(doc->getName());
+        }
+        for (const auto& name : {fileName, fileName + ".recovery.FCStd"}) {
+            Base::FileInfo(name).deleteFile();
+        }
+        getParameter()->RemoveBool("ShareGeometry");
+    }
+
+    static Base::Reference<ParameterGrp> getParameter()
+    {
+        return App::GetApplication().GetUserParameter().GetGroup(
+            "BaseApp/Preferences/Mod/Part/General");
+    }
+
+    static gp_Trsf makeTranslation()
+    {
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec(10, 0, 0));
+        return trsf;
+    }
+
+    // A document with a box and a moved copy of it that doesn't share the geometry
+    App::Document* createDocument()
+    {
+        TopoDS_Shape box = BRepPrimAPI_MakeBox(1, 2, 3).Shape();
+        TopoDS_Shape copy = BRepBuilderAPI_Copy(box).Shape().Moved(makeTranslation());
+        auto doc = newDocument();
+        getFeature(doc, "Box", true)->Shape.setValue(box);
+        getFeature(doc, "Copy", true)->Shape.setValue(copy);
+        return doc;
+    }
+
+    App::Document* newDocument()
+    {
+        auto name = App::GetApplication().getUniqueDocumentName("test");
+        docs.push_back(App::GetApplication().newDocument(name.c_str(), "testUser"));
+        return docs.back();
+    }
+
+    App::Document* openDocument(const std::string& name)
+    {
+        docs.push_back(App::GetApplication().openDocument(name.c_str()));
+        return docs.back();
+    }
+
+    static Part::Feature* getFeature(App::Document* doc, const char* name, bool create = false)
+    {
+        if (create) {
+            return static_cast<Part::Feature*>(doc->addObject("Part::Feature", name));
+        }
+        return dynamic_cast<Part::Feature*>(doc->getObject(name));
+    }
+
+    // Saves the document like the auto saver saves a compressed recovery file
+    static void saveRecoveryFile(App::Document* doc, const std::string& name)
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream file(fi, std::ios::out | std::ios::binary);
+        Base::ZipWriter writer(file);
+        writer.setMode("BinaryBrep");
+        writer.putNextEntry("Document.xml");
+        doc->Save(writer);
+        doc->signalSaveDocument(writer);
+        writer.writeFiles();
+    }
+
+    static void expectSameShapes(App::Document* doc, App::Document* restored)
+    {
+        for (const char* name : {"Box", "Copy"}) {
+            auto feature = getFeature(restored, name);
+            ASSERT_TRUE(feature) << name;
+            EXPECT_FALSE(feature->Shape.getShape().isNull()) << name;
+            EXPECT_TRUE(PartTestHelpers::boxesMatch(feature->Shape.getBoundingBox(),
+                                                    getFeature(doc, name)->Shape.getBoundingBox()))
+                << name;
+        }
+    }
+
+    std::string fileName;
+    std::vector<App::Document*> docs;
+
+    // A box and a moved and reversed copy that shares the geometry
+    static std::vector<TopoDS_Shape> makeShapes()
+    {
+        TopoDS_Shape box = BRepPrimAPI_MakeBox(1, 2, 3).Shape();
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec(10, 0, 0));
+        return {box, box.Moved(TopLoc_Location(trsf)).Reversed()};
+    }
+
+    static void roundTrip(bool binary)
+    {
+        // Arrange
+        auto shapes = makeShapes();
+        Part::ShapePool pool;
+        for (const auto& shape : shapes) {
+            pool.addShape(shape);
+        }
+        std::stringstream stream;
+
+        // Act
+        pool.write(stream, binary);
+        Part::ShapePool restored;
+        restored.read(stream, binary);
+
+        // Assert
+        ASSERT_EQ(restored.countShapes(), 2);
+        TopoDS_Shape first = restored.getShape(0);
+        TopoDS_Shape second = restored.getShape(1);
+        EXPECT_TRUE(first.IsPartner(second));
+        EXPECT_FALSE(first.IsSame(second));
+        EXPECT_EQ(first.Orientation(), shapes[0].Orientation());
+        EXPECT_EQ(second.Orientation(), shapes[1].Orientation());
+        EXPECT_DOUBLE_EQ(second.Location().Transformation().TranslationPart().X(), 10.0);
+        EXPECT_TRUE(restored.getShape(2).IsNull());
+    }
+};
+
+TEST_F(ShapePoolTest, roundTripBrep)
+{
+    roundTrip(false);
+}
+
+TEST_F(ShapePoolTest, roundTripBinary)
+{
+    roundTrip(true);
+}
+
+TEST_F(ShapePoolTest, sharedGeometryWrittenOnce)
+{
+    // Arrange
+    auto shapes = makeShapes();
+    Part::ShapePool pool;
+    std::stringstream separate;
+    for (const auto& shape : shapes) {
+        pool.addShape(shape);
+        Part::TopoShape(shape).exportBrep(separate);
+    }
+    std::stringstream pooled;
+
+    // Act
+    pool.write(pooled, false);
+
+    // Assert
+    EXPECT_LT(pooled.str().size(), separate.str().size() * 3 / 4);
+}
+
+TEST_F(ShapePoolTest, identicalCopiesWrittenOnce)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1, 2, 3).Shape();
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(box).Shape().Moved(makeTranslation());
+    Part::ShapePool pool;
+    std::stringstream separate;
+    for (const auto& shape : {box, copy}) {
+        pool.addShape(shape);
+        Part::TopoShape(shape).exportBrep(separate);
+    }
+    std::stringstream pooled;
+
+    // Act
+    pool.write(pooled, false);
+
+    // Assert
+    EXPECT_TRUE(pool.getShape(0).IsPartner(pool.getShape(1)));
+    EXPECT_TRUE(pool.getShape(1).Location().IsEqual(copy.Location()));
+    EXPECT_LT(pooled.str().size(), separate.str().size() * 3 / 4);
+}
+
+TEST_F(ShapePoolTest, differentGeometriesNotShared)
+{
+    // Arrange
+    Part::ShapePool pool;
+
+    // Act
+    pool.addShape(BRepPrimAPI_MakeBox(1, 2, 3).Shape());
+    pool.addShape(BRepPrimAPI_MakeBox(1, 2, 4).Shape());
+    pool.addShape(BRepPrimAPI_MakeBox(1, 2, 3).Shape());
+
+    // Assert
+    EXPECT_FALSE(pool.getShape(0).IsPartner(pool.getShape(1)));
+    EXPECT_TRUE(pool.getShape(0).IsPartner(pool.getShape(2)));
+}
+
+TEST_F(ShapePoolTest, invalidStream)
+{
+    // Arrange
+    Part::ShapePool pool;
+    std::stringstream stream("nothing to read");
+
+    // Act and Assert
+    EXPECT_THROW(pool.read(stream, false), Base::CADKernelError);
+}
+
+TEST_F(ShapePoolTest, saveAndRestoreDocument)
+{
+    // Arrange
+    auto doc = createDocument();
+
+    // Act
+    doc->saveCopy(fileName.c_str());
+    auto restored = openDocument(fileName);
+
+    // Assert
+    ASSERT_TRUE(restored);
+    expectSameShapes(doc, restored);
+    EXPECT_TRUE(getFeature(restored, "Box")->Shape.getValue().IsPartner(
+        getFeature(restored, "Copy")->Shape.getValue()));
+}
+
+TEST_F(ShapePoolTest, restorePartialDocument)
+{
+    // Arrange
+    auto doc = createDocument();
+    doc->saveCopy(fileName.c_str());
+    auto restored = newDocument();
+
+    // Act: The first shape of the pool isn't loaded
+    restored->restore(fileName.c_str(), false, {"Copy"});
+
+    // Assert
+    EXPECT_FALSE(restored->getObject("Box"));
+    auto copy = getFeature(restored, "Copy");
+    ASSERT_TRUE(copy);
+    EXPECT_TRUE(PartTestHelpers::boxesMatch(copy->Shape.getBoundingBox(),
+                                            getFeature(doc, "Copy")->Shape.getBoundingBox()));
+}
+
+TEST_F(ShapePoolTest, restoreRecoveryFile)
+{
+    // Arrange
+    auto doc = createDocument();
+    doc->saveCopy(fileName.c_str());
+    std::string recoveryName = fileName + ".recovery.FCStd";
+
+    // Act
+    saveRecoveryFile(doc, recoveryName);
+    auto restored = openDocument(recoveryName);
+
+    // Assert: The recovery file has a separate file for each shape
+    ASSERT_TRUE(restored);
+    expectSameShapes(doc, restored);
+    EXPECT_FALSE(getFeature(restored, "Box")->Shape.getValue().IsPartner(
+        getFeature(restored, "Copy")->Shape.getValue()));
+}
+// NOLINTEND
@@ -2420,6 +2420,44 @@ TEST_F(TopoShapeExpansionTest, makeElementSlices)
                                                     // again after importing other TopoNaming logics
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementSlicesOutsideShape)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    TopoShape slicer;
+    Base::Vector3d direction {1.0, 0.0, 0.0};
+    // Act
+    auto& result = slicer.makeElementSlices(cube1TS, direction, {0.75, 2.0, -1.0, 0.25, 0.5});
+    auto subTopoShapes = result.getSubTopoShapes(TopAbs_WIRE);
+    // Assert the slices outside the cube are skipped and the order of the distances is kept
+    ASSERT_EQ(subTopoShapes.size(), 3);
+    EXPECT_NEAR(subTopoShapes[0].getBoundBox().MinX, 0.75, 1e-4);
+    EXPECT_NEAR(subTopoShapes[1].getBoundBox().MinX, 0.25, 1e-4);
+    EXPECT_NEAR(subTopoShapes[2].getBoundBox().MinX, 0.5, 1e-4);
+    EXPECT_FLOAT_EQ(getLength(result.getShape()), 12);
+}
+
+TEST_F(TopoShapeExpansionTest, slicesKeepOrder)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1};
+    Base::Vector3d direction {0.0, 0.0, 1.0};
+    std::vector<double> distances {0.9, 0.1, 5.0, 0.5};
+    // Act
+    TopoDS_Compound result = cube1TS.slices(direction, distances);
+    // Assert
+    std::vector<double> heights;
+    for (TopExp_Explorer exp(result, TopAbs_WIRE); exp.More(); exp.Next()) {
+        heights.push_back(TopoShape(exp.Current()).getBoundBox().MinZ);
+    }
+    ASSERT_EQ(heights.size(), 3);
+    EXPECT_NEAR(heights[0], 0.9, 1e-4);
+    EXPECT_NEAR(heights[1], 0.1, 1e-4);
+    EXPECT_NEAR(heights[2], 0.5, 1e-4);
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementMirror)
 {
     // Arrange
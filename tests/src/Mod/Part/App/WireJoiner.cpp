@@ -7,6 +7,7 @@
 
 #include "PartTestHelpers.h"
 
+#include <BRepBuilderAPI_MakePolygon.hxx>
 #include <BRepBuilderAPI_MakeShape.hxx>
 
 // NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -461,6 +462,57 @@ TEST_F(WireJoinerTest, setMergeEdges)
     EXPECT_EQ(wireMergeEdges.getSubTopoShapes(TopAbs_EDGE).size(), 6);
 }
 
+TEST_F(WireJoinerTest, setParallel)
+{
+    // Arrange
+
+    // A zigzag line whose edges share their vertices. It has more edges than one chunk of
+    // intersection checks, so the chunks run on several threads
+    BRepBuilderAPI_MakePolygon mkPoly;
+    for (int i = 0; i < 100; ++i) {
+        mkPoly.Add(gp_Pnt(double(i), double(i % 2), 0.0));
+    }
+    // A line that crosses every edge of the zigzag line
+    auto edge {BRepBuilderAPI_MakeEdge(gp_Pnt(-1.0, 0.5, 0.0), gp_Pnt(100.0, 0.5, 0.0)).Edge()};
+    std::vector<TopoDS_Shape> shapes {mkPoly.Wire(), edge};
+
+    auto wjSerial {WireJoiner()};
+    auto wjParallel {WireJoiner()};
+    auto wiresSerial {TopoShape(1)};
+    auto wiresParallel {TopoShape(2)};
+    auto openWiresSerial {TopoShape(3)};
+    auto openWiresParallel {TopoShape(4)};
+
+    // Act
+    wjSerial.addShape(shapes);
+    wjSerial.setParallel(false);
+    wjSerial.Build();
+    wjSerial.getResultWires(wiresSerial, nullptr);
+    wjSerial.getOpenWires(openWiresSerial, nullptr, false);
+
+    wjParallel.addShape(shapes);
+    // same as wjParallel.setParallel(true);
+    wjParallel.setParallel();
+    wjParallel.Build();
+    wjParallel.getResultWires(wiresParallel, nullptr);
+    wjParallel.getOpenWires(openWiresParallel, nullptr, false);
+
+    // Assert
+
+    // The crossings with the zigzag line close wires, which must be the same with and without
+    // threads
+    EXPECT_FALSE(wiresSerial.getSubTopoShapes(TopAbs_WIRE).empty());
+    EXPECT_EQ(wiresParallel.getSubTopoShapes(TopAbs_WIRE).size(),
+              wiresSerial.getSubTopoShapes(TopAbs_WIRE).size());
+    EXPECT_EQ(wiresParallel.getSubTopoShapes(TopAbs_EDGE).size(),
+              wiresSerial.getSubTopoShapes(TopAbs_EDGE).size());
+    EXPECT_EQ(wiresParallel.getSubTopoShapes(TopAbs_VERTEX).size(),
+              wiresSerial.getSubTopoShapes(TopAbs_VERTEX).size());
+    EXPECT_EQ(openWiresParallel.getSubTopoShapes(TopAbs_EDGE).size(),
+              openWiresSerial.getSubTopoShapes(TopAbs_EDGE).size());
+    EXPECT_NEAR(getLength(wiresParallel.getShape()), getLength(wiresSerial.getShape()), 1e-6);
+}
+
 TEST_F(WireJoinerTest, setTolerance)
 {
     // Arrange
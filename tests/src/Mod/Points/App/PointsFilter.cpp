@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <Mod/Points/App/PointsFilter.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsFilterTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a regular grid of 10x10 points with spacing 1
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                points.emplace_back(float(i), float(j), 0.0F);
+            }
+        }
+        kernel.setBasicPoints(points);
+    }
+
+    Points::PointKernel kernel;
+};
+
+TEST_F(PointsFilterTest, voxelGrid)
+{
+    Points::PointAttributes attr;
+    attr.intensity.resize(kernel.size(), 0.5F);
+    attr.normals.resize(kernel.size(), Base::Vector3f(0, 0, 2));
+
+    Points::PointKernel output;
+    Points::PointAttributes outputAttr;
+    Points::VoxelGrid voxel(2.0, 2.0, 2.0);
+    voxel.filter(kernel, attr, output, outputAttr);
+
+    EXPECT_EQ(output.size(), 25);
+    ASSERT_EQ(outputAttr.intensity.size(), 25);
+    ASSERT_EQ(outputAttr.normals.size(), 25);
+    EXPECT_TRUE(outputAttr.colors.empty());
+    EXPECT_FLOAT_EQ(outputAttr.intensity.front(), 0.5F);
+    EXPECT_FLOAT_EQ(outputAttr.normals.front().z, 1.0F);
+
+    // each voxel contains 2x2 points and the centroid is in the middle of them
+    const auto& pnt = output.getBasicPoints().front();
+    EXPECT_FLOAT_EQ(pnt.x, 0.5F);
+    EXPECT_FLOAT_EQ(pnt.y, 0.5F);
+    EXPECT_FLOAT_EQ(pnt.z, 0.0F);
+}
+
+TEST_F(PointsFilterTest, voxelGridInvalid)
+{
+    EXPECT_THROW(Points::VoxelGrid(0.0, 1.0, 1.0), Base::ValueError);
+}
+
+TEST_F(PointsFilterTest, statisticalOutlierRemoval)
+{
+    kernel.getBasicPoints().emplace_back(50.0F, 50.0F, 50.0F);
+
+    Points::StatisticalOutlierRemoval filter(4, 1.0);
+    std::vector<unsigned long> outliers = filter.outliers(kernel);
+
+    ASSERT_EQ(outliers.size(), 1);
+    EXPECT_EQ(outliers.front(), 100);
+}
+
+TEST_F(PointsFilterTest, radiusOutlierRemoval)
+{
+    kernel.getBasicPoints().emplace_back(50.0F, 50.0F, 50.0F);
+    kernel.getBasicPoints().emplace_back(50.5F, 50.0F, 50.0F);
+
+    Points::RadiusOutlierRemoval filter(1.1, 2);
+    std::vector<unsigned long> outliers = filter.outliers(kernel);
+
+    // the two separated points have only one neighbour
+    ASSERT_EQ(outliers.size(), 2);
+    EXPECT_EQ(outliers[0], 100);
+    EXPECT_EQ(outliers[1], 101);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
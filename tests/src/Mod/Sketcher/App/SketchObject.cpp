@@ -1906,3 +1906,167 @@ TEST_F(SketchObjectTest, testGetElementName)
     EXPECT_STREQ(reverse_export_name.newName.c_str(), (";" + tagName + "v1;SKT.Vertex1").c_str());
     EXPECT_STREQ(reverse_export_name.oldName.c_str(), "Vertex1");
 }
+
+TEST_F(SketchObjectTest, testFullDiagnosisAfterMove)
+{
+    // Arrange
+    Part::GeomLineSegment lineSeg;
+    setupLineSegment(lineSeg);
+    int geoId = getObject()->addGeometry(&lineSeg);
+    auto horizontal = std::make_unique<Sketcher::Constraint>();
+    horizontal->Type = Sketcher::Horizontal;
+    horizontal->First = geoId;
+    getObject()->addConstraint(std::move(horizontal));
+    getObject()->solve();
+
+    // Act
+    int moved = getObject()->moveGeometry(geoId,
+                                          Sketcher::PointPos::end,
+                                          Base::Vector3d(5.0, 2.0, 0.0),
+                                          false,
+                                          true);
+    getObject()->solve();
+
+    // Assert: Only the setup for the move may reuse the diagnosis
+    EXPECT_EQ(moved, 0);
+    EXPECT_FALSE(getObject()->getSolvedSketch().getDiagnoseTimings().reused);
+    EXPECT_EQ(getObject()->getLastDoF(), 3);
+}
+
+TEST_F(SketchObjectTest, testSolveAfterChangingConstraints)
+{
+    // Arrange
+    Part::GeomLineSegment line1, line2;
+    line1.setPoints(Base::Vector3d(0.0, 0.0, 0.0), Base::Vector3d(2.0, 0.1, 0.0));
+    line2.setPoints(Base::Vector3d(2.0, 0.1, 0.0), Base::Vector3d(2.1, 3.0, 0.0));
+    int geoId1 = getObject()->addGeometry(&line1);
+    int geoId2 = getObject()->addGeometry(&line2);
+    auto addConstraint = [this](Sketcher::ConstraintType type, int geoId, double value = 0.0) {
+        auto constr = std::make_unique<Sketcher::Constraint>();
+        constr->Type = type;
+        constr->First = geoId;
+        constr->setValue(value);
+        getObject()->addConstraint(std::move(constr));
+        getObject()->solve();
+    };
+    auto coincident = std::make_unique<Sketcher::Constraint>();
+    coincident->Type = Sketcher::Coincident;
+    coincident->First = geoId1;
+    coincident->FirstPos = Sketcher::PointPos::end;
+    coincident->Second = geoId2;
+    coincident->SecondPos = Sketcher::PointPos::start;
+    getObject()->addConstraint(std::move(coincident));
+    addConstraint(Sketcher::Horizontal, geoId1);
+    int initialDoF = getObject()->getLastDoF();
+
+    // Act
+    // The sketch set up by the first solve is updated by the following ones
+    addConstraint(Sketcher::Vertical, geoId2);
+    addConstraint(Sketcher::Distance, geoId1, 2.0);
+    int addedDoF = getObject()->getLastDoF();
+    getObject()->delConstraint(0);
+    getObject()->solve();
+    int removedDoF = getObject()->getLastDoF();
+    getObject()->setDatum(2, 3.0);
+    auto line = getObject()->getGeometry<Part::GeomLineSegment>(geoId1);
+    double length = (line->getEndPoint() - line->getStartPoint()).Length();
+    // redundant constraints
+    addConstraint(Sketcher::Horizontal, geoId1);
+    addConstraint(Sketcher::Vertical, geoId2);
+    // a constraint in the middle is removed from the solver and added again
+    getObject()->toggleActive(1);
+    getObject()->solve();
+    getObject()->toggleActive(1);
+    getObject()->solve();
+    // the same sketch set up from scratch
+    auto rebuilt = static_cast<Sketcher::SketchObject*>(
+        getObject()->getDocument()->addObject("Sketcher::SketchObject"));
+    rebuilt->Geometry.setValues(getObject()->Geometry.getValues());
+    rebuilt->Constraints.setValues(getObject()->Constraints.getValues());
+    rebuilt->solve();
+
+    // Assert
+    EXPECT_EQ(initialDoF, 5);
+    EXPECT_EQ(addedDoF, 3);
+    EXPECT_EQ(removedDoF, 5);
+    EXPECT_NEAR(length, 3.0, 1e-6);
+    EXPECT_FALSE(getObject()->getLastRedundant().empty());
+    EXPECT_EQ(getObject()->getLastDoF(), rebuilt->getLastDoF());
+    EXPECT_EQ(getObject()->getLastRedundant(), rebuilt->getLastRedundant());
+    EXPECT_EQ(getObject()->getLastConflicting(), rebuilt->getLastConflicting());
+}
+
+TEST_F(SketchObjectTest, testMissingCoincidentsOneByOneWithUnsolvableCoincidence)
+{
+    // Arrange
+    auto addLine = [this](double x1, double y1, double x2, double y2) {
+        Part::GeomLineSegment line;
+        line.setPoints(Base::Vector3d(x1, y1, 0.0), Base::Vector3d(x2, y2, 0.0));
+        return getObject()->addGeometry(&line);
+    };
+    auto addConstraint = [this](Sketcher::ConstraintType type,
+                                int first,
+                                Sketcher::PointPos firstPos = Sketcher::PointPos::none,
+                                int second = Sketcher::GeoEnum::GeoUndef,
+                                Sketcher::PointPos secondPos = Sketcher::PointPos::none,
+                                double value = 0.0) {
+        auto constr = std::make_unique<Sketcher::Constraint>();
+        constr->Type = type;
+        constr->First = first;
+        constr->FirstPos = firstPos;
+        constr->Second = second;
+        constr->SecondPos = secondPos;
+        constr->setValue(value);
+        getObject()->addConstraint(std::move(constr));
+    };
+    // a coincidence at (-10, -5) that can be solved
+    addLine(-20.0, -5.0, -10.0, -5.0);
+    addLine(-10.0, -5.0, -10.0, -15.0);
+    // a line of length 10 from the origin and a line starting on a circle of radius 1 at
+    // (5, 10) can't have a common point, but their ends at (20, 0) are coincident
+    int line = addLine(0.0, 0.0, 20.0, 0.0);
+    Part::GeomCircle circle;
+    circle.setCenter(Base::Vector3d(5.0, 10.0, 0.0));
+    circle.setRadius(1.0);
+    int circleId = getObject()->addGeometry(&circle);
+    int onCircle = addLine(20.0, 0.0, 30.0, 5.0);
+    addConstraint(Sketcher::Coincident,
+                  line,
+                  Sketcher::PointPos::start,
+                  Sketcher::GeoEnum::RtPnt,
+                  Sketcher::PointPos::start);
+    addConstraint(Sketcher::Distance,
+                  line,
+                  Sketcher::PointPos::none,
+                  Sketcher::GeoEnum::GeoUndef,
+                  Sketcher::PointPos::none,
+                  10.0);
+    addConstraint(Sketcher::Block, circleId);
+    addConstraint(Sketcher::PointOnObject, onCircle, Sketcher::PointPos::start, circleId);
+    // two horizontal lines on top of each other, the coincidences of their ends make one of
+    // the horizontal constraints redundant
+    int lower = addLine(40.0, 0.0, 50.0, 0.0);
+    int upper = addLine(50.0, 0.0, 40.0, 0.0);
+    addConstraint(Sketcher::Horizontal, lower);
+    addConstraint(Sketcher::Horizontal, upper);
+    std::vector<boost::uuids::uuid> tags;
+    for (auto constr : getObject()->Constraints.getValues()) {
+        tags.push_back(constr->getTag());
+    }
+
+    // Act
+    int missing = getObject()->detectMissingPointOnPointConstraints(0.001);
+    EXPECT_THROW(getObject()->makeMissingPointOnPointCoincident(true), Base::RuntimeError);
+
+    // Assert: The sketch keeps its constraints and gets the coincidences up to the unsolvable
+    // one
+    EXPECT_EQ(missing, 4);
+    const auto& constraints = getObject()->Constraints.getValues();
+    ASSERT_EQ(constraints.size(), tags.size() + 2);
+    for (std::size_t i = 0; i < tags.size(); i++) {
+        EXPECT_EQ(constraints[i]->getTag(), tags[i]);
+    }
+    EXPECT_EQ(constraints.back()->Type, Sketcher::Coincident);
+    EXPECT_EQ(constraints.back()->First, line);
+    EXPECT_EQ(constraints.back()->Second, onCircle);
+}
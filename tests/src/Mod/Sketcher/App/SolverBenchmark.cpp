@@ -0,0 +1,645 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+// Benchmark of the Sketcher solver.
+// A corpus of generated sketches and of the sketches of the documents given on the command line
+// is set up and solved with the algorithms of the solver. For each sketch the time of the setup
+// and of its diagnosis, the time and iterations of a solve with DogLeg, Levenberg-Marquardt and
+// BFGS and the mean time and iterations of a drag step are reported. The solver runs with its
+// default settings, i.e. not with the preferences of the user. If the selected algorithm fails,
+// Sketch::solve() falls back to the others, and their time and iterations are included.
+//
+// The results can be saved as a baseline and compared with a later run. The benchmark exits with
+// a non-zero code if a generated sketch can't be solved, or if, compared with the baseline, a
+// sketch has other DoFs, a solve fails or a time exceeds the baseline by the tolerance factor.
+//
+// Run it with: Sketcher_solver_benchmark [--save-baseline file] [--baseline file]
+//                                        [--tolerance factor] [document.FCStd ...]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <FCConfig.h>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Exception.h>
+#include <Base/Interpreter.h>
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/Sketcher/App/Constraint.h>
+#include <Mod/Sketcher/App/GeometryFacade.h>
+#include <Mod/Sketcher/App/Sketch.h>
+#include <Mod/Sketcher/App/SketchObject.h>
+#include <src/App/InitApplication.h>
+
+namespace
+{
+
+// each measurement is repeated and the fastest run is reported
+constexpr int repeat = 3;
+constexpr int dragSteps = 10;
+// times below this difference in ms are considered as noise when comparing with the baseline
+constexpr double timeNoise = 0.5;
+constexpr double defaultTolerance = 1.5;
+
+using GeometryPtr = std::unique_ptr<Part::Geometry>;
+using ConstraintPtr = std::unique_ptr<Sketcher::Constraint>;
+
+struct Case
+{
+    std::string name;
+    // a generated sketch must be solvable
+    bool generated = true;
+    std::vector<GeometryPtr> geometry;  // the internal geometry followed by the external one
+    std::vector<ConstraintPtr> constraints;
+    int extGeoCount = 0;
+    // the point that gets dragged
+    int dragGeoId = 0;
+    Sketcher::PointPos dragPos = Sketcher::PointPos::start;
+
+    std::vector<Part::Geometry*> getGeometry() const
+    {
+        std::vector<Part::Geometry*> geos;
+        for (const auto& geo : geometry) {
+            geos.push_back(geo.get());
+        }
+        return geos;
+    }
+
+    std::vector<Sketcher::Constraint*> getConstraints() const
+    {
+        std::vector<Sketcher::Constraint*> constrs;
+        for (const auto& constr : constraints) {
+            constrs.push_back(constr.get());
+        }
+        return constrs;
+    }
+
+    int addGeometry(GeometryPtr geo)
+    {
+        Sketcher::GeometryFacade::setConstruction(geo.get(), false);
+        geometry.push_back(std::move(geo));
+        return static_cast<int>(geometry.size()) - 1;
+    }
+
+    int addLine(const Base::Vector3d& start, const Base::Vector3d& end)
+    {
+        auto line = std::make_unique<Part::GeomLineSegment>();
+        line->setPoints(start, end);
+        return addGeometry(std::move(line));
+    }
+
+    void addConstraint(Sketcher::ConstraintType type,
+                       int first,
+                       Sketcher::PointPos firstPos = Sketcher::PointPos::none,
+                       int second = Sketcher::GeoEnum::GeoUndef,
+                       Sketcher::PointPos secondPos = Sketcher::PointPos::none,
+                       double value = 0.0)
+    {
+        auto constr = std::make_unique<Sketcher::Constraint>();
+        constr->Type = type;
+        constr->First = first;
+        constr->FirstPos = firstPos;
+        constr->Second = second;
+        constr->SecondPos = secondPos;
+        constr->setValue(value);
+        constraints.push_back(std::move(constr));
+    }
+
+    void addInternalAlignment(Sketcher::InternalAlignmentType type,
+                              int first,
+                              int second,
+                              int index)
+    {
+        addConstraint(Sketcher::InternalAlignment, first, Sketcher::PointPos::none, second);
+        constraints.back()->AlignmentType = type;
+        constraints.back()->InternalAlignmentIndex = index;
+    }
+
+    /// adds the axes as external geometry like SketchObject::getCompleteGeometry()
+    void addAxes()
+    {
+        addLine(Base::Vector3d(0, 0, 0), Base::Vector3d(0, 1, 0));
+        addLine(Base::Vector3d(0, 0, 0), Base::Vector3d(1, 0, 0));
+        extGeoCount = 2;
+    }
+};
+
+using Sketcher::PointPos;
+
+/// A grid of rectangles, each at a fixed distance to its neighbours. If `free` is true the sizes
+/// of the rectangles are left open, if `redundant` is true each rectangle gets a redundant
+/// parallel constraint.
+Case makeRectangles(const std::string& name, int rows, int columns, bool free, bool redundant)
+{
+    Case sketch;
+    sketch.name = name;
+    int previous = -1;
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            double x = 12.0 * column;
+            double y = 8.0 * row;
+            std::array<Base::Vector3d, 4> corners {Base::Vector3d(x, y, 0),
+                                                   Base::Vector3d(x + 10.5, y + 0.2, 0),
+                                                   Base::Vector3d(x + 10, y + 5.3, 0),
+                                                   Base::Vector3d(x - 0.2, y + 5, 0)};
+            int first = static_cast<int>(sketch.geometry.size());
+            for (int j = 0; j < 4; j++) {
+                sketch.addLine(corners[j], corners[(j + 1) % 4]);
+            }
+            for (int j = 0; j < 4; j++) {
+                sketch.addConstraint(Sketcher::Coincident,
+                                     first + j,
+                                     PointPos::end,
+                                     first + (j + 1) % 4,
+                                     PointPos::start);
+            }
+            sketch.addConstraint(Sketcher::Horizontal, first);
+            sketch.addConstraint(Sketcher::Horizontal, first + 2);
+            sketch.addConstraint(Sketcher::Vertical, first + 1);
+            sketch.addConstraint(Sketcher::Vertical, first + 3);
+            if (redundant) {
+                sketch.addConstraint(Sketcher::Parallel,
+                                     first,
+                                     PointPos::none,
+                                     first + 2);
+            }
+            if (!free) {
+                sketch.addConstraint(Sketcher::DistanceX,
+                                     first,
+                                     PointPos::start,
+                                     first,
+                                     PointPos::end,
+                                     10);
+                sketch.addConstraint(Sketcher::DistanceY,
+                                     first + 1,
+                                     PointPos::start,
+                                     first + 1,
+                                     PointPos::end,
+                                     5);
+            }
+            // the first rectangle of a row is placed relative to the one below it
+            int neighbour = column == 0 ? previous - 4 * (columns - 1) : previous;
+            if (previous < 0) {
+                // the origin is the last geometry of the sketch
+                sketch.addConstraint(Sketcher::Coincident,
+                                     first,
+                                     PointPos::start,
+                                     Sketcher::GeoEnum::RtPnt,
+                                     PointPos::start);
+            }
+            else if (column == 0) {
+                sketch.addConstraint(Sketcher::DistanceX,
+                                     neighbour,
+                                     PointPos::start,
+                                     first,
+                                     PointPos::start,
+                                     0);
+                sketch.addConstraint(Sketcher::DistanceY,
+                                     neighbour,
+                                     PointPos::start,
+                                     first,
+                                     PointPos::start,
+                                     8);
+            }
+            else {
+                sketch.addConstraint(Sketcher::DistanceX,
+                                     neighbour,
+                                     PointPos::end,
+                                     first,
+                                     PointPos::start,
+                                     2);
+                sketch.addConstraint(Sketcher::DistanceY,
+                                     neighbour,
+                                     PointPos::end,
+                                     first,
+                                     PointPos::start,
+                                     0);
+            }
+            previous = first;
+        }
+    }
+    sketch.dragGeoId = previous + 2;
+    sketch.dragPos = PointPos::start;
+    sketch.addAxes();
+    return sketch;
+}
+
+/// A chain of tangent half circles with fixed radii, the end of the chain is free.
+Case makeArcChain(const std::string& name, int count)
+{
+    Case sketch;
+    sketch.name = name;
+    for (int i = 0; i < count; i++) {
+        auto arc = std::make_unique<Part::GeomArcOfCircle>();
+        arc->setCenter(Base::Vector3d(4.2 * i, (i % 2) * 0.1, 0));
+        arc->setRadius(2.1);
+        arc->setRange(0.0, M_PI, /*emulateCCWXY=*/true);
+        sketch.addGeometry(std::move(arc));
+    }
+    sketch.addConstraint(Sketcher::Coincident,
+                         0,
+                         PointPos::mid,
+                         Sketcher::GeoEnum::RtPnt,
+                         PointPos::start);
+    for (int i = 0; i < count; i++) {
+        sketch.addConstraint(Sketcher::Radius, i, PointPos::none, Sketcher::GeoEnum::GeoUndef,
+                             PointPos::none, 2.0);
+    }
+    for (int i = 1; i < count; i++) {
+        // an angle of zero lets the solver pick the tangency of the start geometry
+        sketch.addConstraint(Sketcher::Tangent, i - 1, PointPos::start, i, PointPos::end);
+    }
+    sketch.dragGeoId = count - 1;
+    sketch.dragPos = PointPos::mid;
+    sketch.addAxes();
+    return sketch;
+}
+
+/// A chain of cubic B-splines with their control polygons, the poles of each B-spline have equal
+/// weights and its ends are joined to its neighbours.
+Case makeBSplines(const std::string& name, int count)
+{
+    constexpr int poleCount = 5;
+    Case sketch;
+    sketch.name = name;
+    int previous = -1;
+    for (int i = 0; i < count; i++) {
+        double x = 10.0 * i;
+        std::vector<Base::Vector3d> poles;
+        for (int j = 0; j < poleCount; j++) {
+            poles.emplace_back(x + 2.5 * j, (j % 2) * 4.0 + 0.1 * i, 0);
+        }
+        std::vector<double> weights(poleCount, 1.0);
+        std::vector<double> knots {0.0, 0.5, 1.0};
+        std::vector<int> mults {4, 1, 4};
+        int bspline = sketch.addGeometry(
+            std::make_unique<Part::GeomBSplineCurve>(poles, weights, knots, mults, 3));
+        int firstPole = -1;
+        for (int j = 0; j < poleCount; j++) {
+            auto circle = std::make_unique<Part::GeomCircle>();
+            circle->setCenter(poles[j]);
+            circle->setRadius(1.0);
+            Sketcher::GeometryFacade::setConstruction(circle.get(), true);
+            sketch.geometry.push_back(std::move(circle));
+            int pole = static_cast<int>(sketch.geometry.size()) - 1;
+            sketch.addInternalAlignment(Sketcher::BSplineControlPoint, pole, bspline, j);
+            if (j == 0) {
+                firstPole = pole;
+                sketch.addConstraint(Sketcher::Weight, pole, PointPos::none,
+                                     Sketcher::GeoEnum::GeoUndef, PointPos::none, 1.0);
+            }
+            else {
+                sketch.addConstraint(Sketcher::Equal, firstPole, PointPos::none, pole);
+            }
+        }
+        if (previous < 0) {
+            sketch.addConstraint(Sketcher::Coincident,
+                                 bspline,
+                                 PointPos::start,
+                                 Sketcher::GeoEnum::RtPnt,
+                                 PointPos::start);
+        }
+        else {
+            sketch.addConstraint(Sketcher::Coincident,
+                                 previous,
+                                 PointPos::end,
+                                 bspline,
+                                 PointPos::start);
+        }
+        previous = bspline;
+    }
+    sketch.dragGeoId = previous;
+    sketch.dragPos = PointPos::end;
+    sketch.addAxes();
+    return sketch;
+}
+
+/// the sketches of a document
+std::vector<Case> loadDocument(const std::string& path)
+{
+    std::vector<Case> sketches;
+    App::Document* doc = App::GetApplication().openDocument(path.c_str());
+    if (!doc) {
+        std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+        return sketches;
+    }
+    for (auto obj : doc->getObjectsOfType(Sketcher::SketchObject::getClassTypeId())) {
+        auto sketchObject = static_cast<Sketcher::SketchObject*>(obj);
+        Case sketch;
+        sketch.name = std::string(doc->getName()) + "#" + obj->getNameInDocument();
+        sketch.generated = false;
+        for (auto geo : sketchObject->getCompleteGeometry()) {
+            sketch.geometry.emplace_back(geo->clone());
+        }
+        for (auto constr : sketchObject->Constraints.getValues()) {
+            sketch.constraints.emplace_back(constr->clone());
+        }
+        sketch.extGeoCount = sketchObject->getExternalGeometryCount();
+        int internalCount = static_cast<int>(sketch.geometry.size()) - sketch.extGeoCount;
+        if (internalCount == 0) {
+            continue;
+        }
+        // drag a point of the last geometry
+        sketch.dragGeoId = internalCount - 1;
+        const Part::Geometry* geo = sketch.geometry[sketch.dragGeoId].get();
+        if (geo->is<Part::GeomCircle>() || geo->is<Part::GeomEllipse>()
+            || geo->is<Part::GeomPoint>()) {
+            sketch.dragPos = geo->is<Part::GeomPoint>() ? PointPos::start : PointPos::mid;
+        }
+        sketches.push_back(std::move(sketch));
+    }
+    App::GetApplication().closeDocument(doc->getName());
+    return sketches;
+}
+
+double measure(const std::function<void()>& func)
+{
+    double fastest = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeat; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        fastest = std::min(fastest, elapsed.count());
+    }
+    return fastest;
+}
+
+struct Result
+{
+    int dofs = 0;
+    double setUp = 0.0;
+    double diagnose = 0.0;
+    // DogLeg, Levenberg-Marquardt and BFGS
+    std::array<double, 3> solve {};
+    std::array<bool, 3> failed {};
+    double drag = 0.0;
+};
+
+constexpr std::array<const char*, 3> algorithmNames {"DogLeg", "LM", "BFGS"};
+
+Result run(const Case& sketch)
+{
+    Result result;
+    auto geos = sketch.getGeometry();
+    auto constrs = sketch.getConstraints();
+
+    int dofs = 0;
+    GCS::DiagnoseTimings diagnose;
+    double setUp = measure([&]() {
+        Sketcher::Sketch solver;
+        dofs = solver.setUpSketch(geos, constrs, sketch.extGeoCount);
+        diagnose = solver.getDiagnoseTimings();
+    });
+    std::printf("%-24s %6d %7d %5d %9.2f %9.2f (%.2f %.2f %.2f)",
+                sketch.name.c_str(),
+                static_cast<int>(geos.size()) - sketch.extGeoCount,
+                static_cast<int>(constrs.size()),
+                dofs,
+                setUp,
+                diagnose.total,
+                diagnose.jacobian,
+                diagnose.decomposition,
+                diagnose.redundancy);
+    result.dofs = dofs;
+    result.setUp = setUp;
+    result.diagnose = diagnose.total;
+
+    constexpr std::array<GCS::Algorithm, 3> algorithms {GCS::DogLeg,
+                                                        GCS::LevenbergMarquardt,
+                                                        GCS::BFGS};
+    for (std::size_t index = 0; index < algorithms.size(); index++) {
+        GCS::Algorithm algorithm = algorithms[index];
+        int iterations = 0;
+        int status = 0;
+        double time = std::numeric_limits<double>::max();
+        for (int i = 0; i < repeat; i++) {
+            // the setup is not part of the solve
+            Sketcher::Sketch solver;
+            solver.setUpSketch(geos, constrs, sketch.extGeoCount);
+            solver.defaultSolver = algorithm;
+            solver.defaultSolverRedundant = algorithm;
+            auto start = std::chrono::steady_clock::now();
+            status = solver.solve();
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            time = std::min(time, elapsed.count());
+            iterations = solver.getSolverIterations();
+        }
+        std::printf(" %9.2f %5d%c", time, iterations, status == 0 ? ' ' : '*');
+        result.solve[index] = time;
+        result.failed[index] = status != 0;
+    }
+
+    int iterations = 0;
+    double drag = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeat; i++) {
+        Sketcher::Sketch solver;
+        solver.setUpSketch(geos, constrs, sketch.extGeoCount);
+        solver.solve();
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 1; step <= dragSteps; step++) {
+            solver.moveGeometry(sketch.dragGeoId,
+                                sketch.dragPos,
+                                Base::Vector3d(0.1 * step, 0.1 * step, 0),
+                                /*relative=*/true);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        drag = std::min(drag, elapsed.count() / dragSteps);
+        iterations = solver.getSolverIterations() / dragSteps;
+    }
+    std::printf(" %9.2f %5d\n", drag, iterations);
+    result.drag = drag;
+    return result;
+}
+
+/// Writes one line per sketch with its name and results, separated by tabs
+void saveBaseline(const std::string& path, const std::map<std::string, Result>& results)
+{
+    std::ofstream file(path);
+    for (const auto& it : results) {
+        const Result& result = it.second;
+        file << it.first << '\t' << result.dofs << '\t' << result.setUp << '\t'
+             << result.diagnose;
+        for (std::size_t i = 0; i < result.solve.size(); i++) {
+            file << '\t' << result.solve[i] << '\t' << result.failed[i];
+        }
+        file << '\t' << result.drag << '\n';
+    }
+    if (!file) {
+        std::fprintf(stderr, "Failed to write the baseline %s\n", path.c_str());
+    }
+}
+
+std::map<std::string, Result> loadBaseline(const std::string& path)
+{
+    std::map<std::string, Result> results;
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Failed to read the baseline %s\n", path.c_str());
+        return results;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        auto pos = line.find('\t');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        Result result;
+        std::istringstream values(line.substr(pos + 1));
+        values >> result.dofs >> result.setUp >> result.diagnose;
+        for (std::size_t i = 0; i < result.solve.size(); i++) {
+            values >> result.solve[i] >> result.failed[i];
+        }
+        values >> result.drag;
+        if (values) {
+            results[line.substr(0, pos)] = result;
+        }
+    }
+    return results;
+}
+
+/// Reports the differences of a result that count as a regression and returns their number
+int compare(const std::string& name, const Result& result, const Result& base, double tolerance)
+{
+    int regressions = 0;
+    auto checkTime = [&](const char* what, double time, double baseTime) {
+        if (time > baseTime * tolerance && time - baseTime > timeNoise) {
+            std::fprintf(stderr,
+                         "%s: %s takes %.2f ms instead of %.2f ms\n",
+                         name.c_str(),
+                         what,
+                         time,
+                         baseTime);
+            regressions++;
+        }
+    };
+    if (result.dofs != base.dofs) {
+        std::fprintf(stderr,
+                     "%s: %d DoFs instead of %d\n",
+                     name.c_str(),
+                     result.dofs,
+                     base.dofs);
+        regressions++;
+    }
+    checkTime("the setup", result.setUp, base.setUp);
+    checkTime("the diagnosis", result.diagnose, base.diagnose);
+    for (std::size_t i = 0; i < result.solve.size(); i++) {
+        if (result.failed[i] && !base.failed[i]) {
+            std::fprintf(stderr, "%s: %s fails\n", name.c_str(), algorithmNames[i]);
+            regressions++;
+        }
+        checkTime(algorithmNames[i], result.solve[i], base.solve[i]);
+    }
+    checkTime("a drag step", result.drag, base.drag);
+    return regressions;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    tests::initApplication();
+    Base::Interpreter().loadModule("Sketcher");
+
+    std::string baselinePath;
+    std::string savePath;
+    double tolerance = defaultTolerance;
+    std::vector<std::string> documents;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--baseline" || arg == "--save-baseline" || arg == "--tolerance")
+            && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (arg == "--baseline") {
+                baselinePath = value;
+            }
+            else if (arg == "--save-baseline") {
+                savePath = value;
+            }
+            else {
+                tolerance = std::stod(value);
+            }
+        }
+        else {
+            documents.push_back(arg);
+        }
+    }
+
+    std::vector<Case> corpus;
+    corpus.push_back(makeRectangles("rectangles 5x5", 5, 5, false, false));
+    corpus.push_back(makeRectangles("rectangles 10x20", 10, 20, false, false));
+    corpus.push_back(makeRectangles("rectangles free 10x20", 10, 20, true, false));
+    corpus.push_back(makeRectangles("rectangles redundant 5x5", 5, 5, false, true));
+    corpus.push_back(makeArcChain("arc chain 50", 50));
+    corpus.push_back(makeArcChain("arc chain 200", 200));
+    corpus.push_back(makeBSplines("bsplines 10", 10));
+    corpus.push_back(makeBSplines("bsplines 40", 40));
+    for (const auto& path : documents) {
+        try {
+            for (auto& sketch : loadDocument(path)) {
+                corpus.push_back(std::move(sketch));
+            }
+        }
+        catch (const Base::Exception& e) {
+            std::fprintf(stderr, "Failed to load %s: %s\n", path.c_str(), e.what());
+        }
+    }
+
+    std::printf("Times in ms, a '*' marks a failed solve. The time and iterations (it+fb) of a "
+                "solve include\nthe fallback algorithms that Sketch::solve() tries after a "
+                "failure.\n");
+    std::printf("%-24s %6s %7s %5s %9s %9s %-18s %15s %15s %15s %15s\n",
+                "sketch",
+                "geos",
+                "constrs",
+                "dofs",
+                "setup",
+                "diagnose",
+                "(jac qr redund)",
+                "DogLeg (it+fb)",
+                "LM (it+fb)",
+                "BFGS (it+fb)",
+                "drag step (it)");
+    int failures = 0;
+    std::map<std::string, Result> results;
+    for (const auto& sketch : corpus) {
+        Result result = run(sketch);
+        for (std::size_t i = 0; i < result.failed.size(); i++) {
+            if (sketch.generated && result.failed[i]) {
+                std::fprintf(stderr,
+                             "%s: %s fails\n",
+                             sketch.name.c_str(),
+                             algorithmNames[i]);
+                failures++;
+            }
+        }
+        results[sketch.name] = result;
+    }
+
+    if (!baselinePath.empty()) {
+        auto baseline = loadBaseline(baselinePath);
+        if (baseline.empty()) {
+            failures++;
+        }
+        for (const auto& it : baseline) {
+            auto jt = results.find(it.first);
+            if (jt != results.end()) {
+                failures += compare(it.first, jt->second, it.second, tolerance);
+            }
+        }
+    }
+    if (!savePath.empty()) {
+        saveBaseline(savePath, results);
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <cmath>
+#include <memory>
 
 #include <gtest/gtest.h>
 
@@ -178,3 +179,59 @@ TEST_F(ConstraintsTest, tangentBSplineAndArc)  // NOLINT
                 1.0,
                 0.005);
 }
+
+TEST_F(ConstraintsTest, errorAndGradsMatchesGrad)  // NOLINT
+{
+    // Arrange
+    std::vector<double> values = {0.3, -1.2, 4.1, 2.5, -2.2, 3.7, 1.9, -0.4, 2.5, 0.7, 0.35, 1.1};
+    GCS::Point p1(&values[0], &values[1]), p2(&values[2], &values[3]);
+    GCS::Point p3(&values[4], &values[5]), p4(&values[6], &values[7]);
+    GCS::Line l1, l2;
+    l1.p1 = p1;
+    l1.p2 = p2;
+    l2.p1 = p3;
+    l2.p2 = p4;
+    // p5 shares its x coordinate with p1
+    GCS::Point p5(&values[0], &values[5]);
+    double* length = &values[8];
+    double* angle = &values[10];
+    std::vector<std::unique_ptr<GCS::Constraint>> constraints;
+    constraints.push_back(std::make_unique<GCS::ConstraintEqual>(&values[0], &values[2], 2.0));
+    constraints.push_back(
+        std::make_unique<GCS::ConstraintDifference>(&values[0], &values[2], length));
+    constraints.push_back(std::make_unique<GCS::ConstraintP2PDistance>(p1, p3, length));
+    constraints.push_back(std::make_unique<GCS::ConstraintP2PDistance>(p1, p5, length));
+    constraints.push_back(std::make_unique<GCS::ConstraintP2PAngle>(p2, p4, angle, 0.1));
+    constraints.push_back(std::make_unique<GCS::ConstraintP2LDistance>(p3, l1, length));
+    constraints.push_back(std::make_unique<GCS::ConstraintP2LDistance>(p4, l1, length));
+    constraints.push_back(std::make_unique<GCS::ConstraintPointOnLine>(p3, l1));
+    constraints.push_back(std::make_unique<GCS::ConstraintPointOnLine>(p5, l2));
+    constraints.push_back(std::make_unique<GCS::ConstraintPointOnPerpBisector>(p3, l1));
+    constraints.push_back(std::make_unique<GCS::ConstraintParallel>(l1, l2));
+    constraints.push_back(std::make_unique<GCS::ConstraintPerpendicular>(l1, l2));
+    constraints.push_back(std::make_unique<GCS::ConstraintL2LAngle>(l1, l2, angle));
+    constraints.push_back(std::make_unique<GCS::ConstraintMidpointOnLine>(l1, l2));
+    constraints.push_back(
+        std::make_unique<GCS::ConstraintTangentCircumf>(p1, p2, length, &values[11], false));
+    constraints.push_back(
+        std::make_unique<GCS::ConstraintTangentCircumf>(p1, p2, length, &values[11], true));
+
+    for (auto& constr : constraints) {
+        // Act
+        GCS::VEC_pD params = constr->params();
+        std::vector<double> grads(params.size());
+        double error = constr->errorAndGrads(grads.data());
+
+        // Assert
+        EXPECT_DOUBLE_EQ(error, constr->error()) << "type " << constr->getTypeId();
+        for (double* param : params) {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < params.size(); ++i) {
+                if (params[i] == param) {
+                    sum += grads[i];
+                }
+            }
+            EXPECT_DOUBLE_EQ(sum, constr->grad(param)) << "type " << constr->getTypeId();
+        }
+    }
+}
@@ -50,3 +50,225 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+// A comb of points where the first row is a horizontal chain and each column a vertical chain.
+// Each point is fixed by a distance and a horizontal or vertical constraint, so the system is
+// fully constrained without redundancies.
+class CombSketch
+{
+public:
+    CombSketch(GCS::System& system, int size)
+        : values(2 * size * size + 2)
+        , distance(1.0)
+    {
+        for (int i = 0; i < size * size; ++i) {
+            // start close to the solution
+            values[2 * i] = (i % size) * 1.1 + 0.01 * (i % 3);
+            values[2 * i + 1] = (i / size) * 0.9 - 0.01 * (i % 5);
+            points.emplace_back(&values[2 * i], &values[2 * i + 1]);
+            unknowns.push_back(&values[2 * i]);
+            unknowns.push_back(&values[2 * i + 1]);
+        }
+        double* origin = &values[2 * size * size];
+        system.addConstraintCoordinateX(points[0], origin);
+        system.addConstraintCoordinateY(points[0], origin + 1);
+        for (int i = 1; i < size; ++i) {
+            system.addConstraintHorizontal(points[i - 1], points[i]);
+            system.addConstraintP2PDistance(points[i - 1], points[i], &distance);
+        }
+        for (int i = size; i < size * size; ++i) {
+            system.addConstraintVertical(points[i - size], points[i]);
+            system.addConstraintP2PDistance(points[i - size], points[i], &distance);
+        }
+    }
+
+    std::vector<double> values;
+    std::vector<GCS::Point> points;
+    GCS::VEC_pD unknowns;
+    double distance;
+};
+
+TEST_F(GCSTest, solveSparseDogLeg)  // NOLINT
+{
+    // Arrange
+    SystemTest denseSystem;
+    CombSketch dense(denseSystem, 8);
+    denseSystem.sparseThreshold = 0;
+    CombSketch sparse(*System(), 8);
+    System()->sparseThreshold = 1;
+
+    // Act
+    int denseResult = denseSystem.solve(dense.unknowns, true, GCS::DogLeg);
+    denseSystem.applySolution();
+    int sparseResult = System()->solve(sparse.unknowns, true, GCS::DogLeg);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(denseResult, GCS::Success);
+    EXPECT_EQ(sparseResult, GCS::Success);
+    for (std::size_t i = 0; i < dense.values.size(); ++i) {
+        EXPECT_NEAR(dense.values[i], sparse.values[i], 1e-8);
+    }
+}
+
+TEST_F(GCSTest, solveSparseLevenbergMarquardt)  // NOLINT
+{
+    // Arrange
+    SystemTest denseSystem;
+    CombSketch dense(denseSystem, 8);
+    denseSystem.sparseThreshold = 0;
+    CombSketch sparse(*System(), 8);
+    System()->sparseThreshold = 1;
+
+    // Act
+    int denseResult = denseSystem.solve(dense.unknowns, true, GCS::LevenbergMarquardt);
+    denseSystem.applySolution();
+    int sparseResult = System()->solve(sparse.unknowns, true, GCS::LevenbergMarquardt);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(denseResult, GCS::Success);
+    EXPECT_EQ(sparseResult, GCS::Success);
+    for (std::size_t i = 0; i < dense.values.size(); ++i) {
+        EXPECT_NEAR(dense.values[i], sparse.values[i], 1e-8);
+    }
+}
+
+TEST_F(GCSTest, solveSparseWithRedundantConstraint)  // NOLINT
+{
+    // Arrange
+    CombSketch sparse(*System(), 4);
+    // closes a loop of the comb, so that J * J^T is singular
+    System()->addConstraintHorizontal(sparse.points[4], sparse.points[5]);
+    System()->sparseThreshold = 1;
+
+    // Act
+    int result = System()->solve(sparse.unknowns, true, GCS::DogLeg);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(result, GCS::Success);
+    EXPECT_NEAR(sparse.values[11], sparse.values[9], 1e-8);
+}
+
+TEST_F(GCSTest, solveDecoupledComponentsConcurrently)  // NOLINT
+{
+    // Arrange
+    SystemTest serialSystem;
+    serialSystem.concurrentThreshold = 0;
+    System()->concurrentThreshold = 1;
+    std::vector<std::unique_ptr<CombSketch>> serial, concurrent;
+    GCS::VEC_pD serialUnknowns, concurrentUnknowns;
+    for (int size : {6, 3, 5, 4}) {
+        serial.push_back(std::make_unique<CombSketch>(serialSystem, size));
+        concurrent.push_back(std::make_unique<CombSketch>(*System(), size));
+        serialUnknowns.insert(serialUnknowns.end(),
+                              serial.back()->unknowns.begin(),
+                              serial.back()->unknowns.end());
+        concurrentUnknowns.insert(concurrentUnknowns.end(),
+                                  concurrent.back()->unknowns.begin(),
+                                  concurrent.back()->unknowns.end());
+    }
+
+    // Act
+    int serialResult = serialSystem.solve(serialUnknowns, true, GCS::DogLeg);
+    serialSystem.applySolution();
+    int concurrentResult = System()->solve(concurrentUnknowns, true, GCS::DogLeg);
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(serialResult, GCS::Success);
+    EXPECT_EQ(concurrentResult, GCS::Success);
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i]->values, concurrent[i]->values);
+    }
+}
+
+TEST_F(GCSTest, reuseDiagnosisAfterDragging)  // NOLINT
+{
+    // Arrange
+    std::unique_ptr<CombSketch> sketch;
+    // sets up the same sketch again like a sketch object after each change
+    auto setUp = [&](double distance, double offset) {
+        System()->clear();
+        sketch = std::make_unique<CombSketch>(*System(), 4);
+        sketch->distance = distance;
+        sketch->values[10] += offset;
+        // closes a loop of the comb, so that there is a redundant constraint
+        System()->addConstraintHorizontal(sketch->points[4], sketch->points[5], 1);
+        System()->declareUnknowns(sketch->unknowns);
+        return System()->diagnose();
+    };
+    int dofs = setUp(1.0, 0.0);
+    GCS::VEC_I redundant;
+    System()->getRedundant(redundant);
+    System()->deferDiagnosis = true;
+
+    // Act
+    // a drag step moves a point, but the constraints stay the same
+    int draggedDofs = setUp(1.0, 0.5);
+    bool draggedReused = System()->getDiagnoseTimings().reused;
+    GCS::VEC_I draggedRedundant;
+    System()->getRedundant(draggedRedundant);
+    setUp(2.0, 0.5);
+    bool changedReused = System()->getDiagnoseTimings().reused;
+
+    // Assert
+    EXPECT_FALSE(redundant.empty());
+    EXPECT_TRUE(draggedReused);
+    EXPECT_EQ(draggedDofs, dofs);
+    EXPECT_EQ(draggedRedundant, redundant);
+    EXPECT_FALSE(changedReused);
+}
+
+TEST_F(GCSTest, changeTagsAfterRemovingConstraint)  // NOLINT
+{
+    // Arrange
+    // tagged like the constraints of a sketch, the horizontal ones close loops of the comb
+    CombSketch sketch(*System(), 3);
+    System()->addConstraintP2PDistance(sketch.points[0], sketch.points[8], &sketch.distance, 1);
+    System()->addConstraintHorizontal(sketch.points[3], sketch.points[4], 2);
+    System()->addConstraintHorizontal(sketch.points[6], sketch.points[7], 3);
+    // the same system set up without the first constraint
+    SystemTest rebuiltSystem;
+    CombSketch rebuilt(rebuiltSystem, 3);
+    rebuiltSystem.addConstraintHorizontal(rebuilt.points[3], rebuilt.points[4], 1);
+    rebuiltSystem.addConstraintHorizontal(rebuilt.points[6], rebuilt.points[7], 2);
+    rebuiltSystem.declareUnknowns(rebuilt.unknowns);
+    int rebuiltDofs = rebuiltSystem.diagnose();
+    GCS::VEC_I rebuiltRedundant;
+    rebuiltSystem.getRedundant(rebuiltRedundant);
+
+    // Act
+    // removes the first constraint and renumbers the others like a sketch does
+    System()->clearByTag(1);
+    System()->changeTags({0, -1, 1, 2});
+    System()->declareUnknowns(sketch.unknowns);
+    int dofs = System()->diagnose();
+    GCS::VEC_I redundant;
+    System()->getRedundant(redundant);
+
+    // Assert
+    EXPECT_EQ(System()->getNumberOfConstraints(1), 1);
+    EXPECT_EQ(System()->getNumberOfConstraints(2), 1);
+    EXPECT_EQ(System()->getNumberOfConstraints(3), 0);
+    EXPECT_FALSE(redundant.empty());
+    EXPECT_EQ(dofs, rebuiltDofs);
+    EXPECT_EQ(redundant, rebuiltRedundant);
+}
+
+TEST_F(GCSTest, countIterations)  // NOLINT
+{
+    // Arrange
+    CombSketch comb(*System(), 4);
+
+    // Act
+    int result = System()->solve(comb.unknowns, true, GCS::DogLeg);
+    int iterations = System()->getIterations();
+    System()->initSolution();
+
+    // Assert
+    EXPECT_EQ(result, GCS::Success);
+    EXPECT_GT(iterations, 0);
+    EXPECT_EQ(System()->getIterations(), 0);
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include "Mod/Sketcher/App/planegcs/Constraints.h"
+#include "Mod/Sketcher/App/planegcs/SubSystem.h"
+
+// NOLINTBEGIN
+class SubSystemTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        values = {0.0, 0.0, 3.0, 1.0, 4.0, 5.0, 2.0};
+        p1 = GCS::Point(&values[0], &values[1]);
+        p2 = GCS::Point(&values[2], &values[3]);
+        p3 = GCS::Point(&values[4], &values[5]);
+        constraints.push_back(new GCS::ConstraintP2PDistance(p1, p2, &values[6]));
+        constraints.push_back(new GCS::ConstraintP2PDistance(p2, p3, &values[6]));
+        constraints.push_back(new GCS::ConstraintEqual(&values[0], &values[4]));
+        params = {&values[0], &values[1], &values[2], &values[3], &values[4], &values[5]};
+    }
+
+    void TearDown() override
+    {
+        for (auto constr : constraints) {
+            delete constr;
+        }
+    }
+
+    std::vector<double> values;
+    GCS::Point p1, p2, p3;
+    std::vector<GCS::Constraint*> constraints;
+    GCS::VEC_pD params;
+};
+
+TEST_F(SubSystemTest, sparseJacobi)
+{
+    // Arrange
+    GCS::SubSystem subsys(constraints, params);
+    subsys.redirectParams();
+    Eigen::MatrixXd dense;
+    Eigen::SparseMatrix<double> sparse;
+
+    // Act
+    subsys.calcJacobi(dense);
+    subsys.calcJacobi(sparse);
+    subsys.revertParams();
+
+    // Assert
+    EXPECT_EQ(sparse.rows(), dense.rows());
+    EXPECT_EQ(sparse.cols(), dense.cols());
+    // every constraint only depends on four or two of the six parameters
+    EXPECT_EQ(sparse.nonZeros(), 10);
+    EXPECT_TRUE(Eigen::MatrixXd(sparse).isApprox(dense));
+}
+
+TEST_F(SubSystemTest, solveNormal)
+{
+    // Arrange
+    GCS::SubSystem subsys(constraints, params);
+    subsys.redirectParams();
+    Eigen::SparseMatrix<double> J;
+    subsys.calcJacobi(J);
+    subsys.revertParams();
+    Eigen::SparseMatrix<double> identity(J.cols(), J.cols());
+    identity.setIdentity();
+    Eigen::SparseMatrix<double> A = Eigen::SparseMatrix<double>(J.transpose() * J) + identity;
+    Eigen::VectorXd b = Eigen::VectorXd::Ones(J.cols());
+    Eigen::VectorXd x;
+
+    // Act
+    bool first = subsys.solveNormal(A, b, x);
+    Eigen::VectorXd x2;
+    bool second = subsys.solveNormal(A * 2.0, b, x2);
+
+    // Assert
+    EXPECT_TRUE(first);
+    EXPECT_TRUE(second);
+    EXPECT_TRUE((Eigen::MatrixXd(A) * x).isApprox(b));
+    EXPECT_TRUE(x2.isApprox(x * 0.5));
+}
+TEST_F(SubSystemTest, jacobiWithReductionMap)
+{
+    // Arrange
+    // the x coordinates of p1 and p3 are reduced to one unknown
+    GCS::MAP_pD_pD reductionMap = {{&values[0], &values[0]}, {&values[4], &values[0]}};
+    GCS::SubSystem subsys(constraints, params, reductionMap);
+    subsys.redirectParams();
+    GCS::VEC_pD plist;
+    subsys.getParamList(plist);
+    Eigen::MatrixXd expected;
+    Eigen::MatrixXd dense;
+    Eigen::SparseMatrix<double> sparse;
+
+    // Act
+    subsys.calcJacobi(plist, expected);
+    subsys.calcJacobi(dense);
+    subsys.calcJacobi(sparse);
+    subsys.revertParams();
+
+    // Assert
+    EXPECT_EQ(plist.size(), 5U);
+    EXPECT_TRUE(dense.isApprox(expected));
+    EXPECT_TRUE(Eigen::MatrixXd(sparse).isApprox(expected));
+    // the equality constraint has no derivative left
+    EXPECT_EQ(expected.row(2).norm(), 0.0);
+}
+// NOLINTEND
@@ -0,0 +1,61 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the inspection of a point cloud against a shape.
+# It compares the exact distance computation with BRepExtrema_DistShapeShape for every point
+# with the tessellation based pre-selection of faces (Inspection::Feature::FastShapeDistance).
+#
+# Run it with: FreeCADCmd tools/profile/inspection_shape.py [number of points]
+
+import random
+import sys
+import time
+
+import FreeCAD as App
+import Part
+import Points
+import Inspection
+
+count = 100000
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+doc = App.newDocument("InspectionBenchmark")
+
+# a solid with planar, cylindrical and toroidal faces
+box = Part.makeBox(100, 60, 40)
+cyl = Part.makeCylinder(15, 80, App.Vector(50, 30, -20))
+solid = box.cut(cyl).makeFillet(5, box.Edges[:4])
+nominal = doc.addObject("Part::Feature", "Nominal")
+nominal.Shape = solid
+
+# sample points near the surface of the solid
+random.seed(0)
+mesh_points, _ = solid.tessellate(0.5)
+pts = []
+for _ in range(count):
+    p = random.choice(mesh_points)
+    pts.append(p + App.Vector(random.uniform(-1, 1), random.uniform(-1, 1), random.uniform(-1, 1)))
+
+actual = doc.addObject("Points::Feature", "Actual")
+actual.Points = Points.Points(pts)
+
+results = {}
+for fast in (True, False):
+    insp = doc.addObject("Inspection::Feature", "Inspection")
+    insp.Actual = actual
+    insp.Nominals = [nominal]
+    insp.SearchRadius = 2.0
+    insp.FastShapeDistance = fast
+    start = time.perf_counter()
+    doc.recompute()
+    elapsed = time.perf_counter() - start
+    results[fast] = (elapsed, insp.Distances)
+    print(f"FastShapeDistance={fast}: {count} points in {elapsed:.3f} s")
+
+fast_dist = results[True][1]
+exact_dist = results[False][1]
+valid = [(a, b) for a, b in zip(fast_dist, exact_dist) if abs(a) < 1e30 and abs(b) < 1e30]
+deviation = max((abs(a - b) for a, b in valid), default=0.0)
+print(f"Speed-up: {results[False][0] / results[True][0]:.1f}x, max. deviation: {deviation:.2e}")
+
+App.closeDocument(doc.Name)
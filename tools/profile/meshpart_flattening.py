@@ -0,0 +1,67 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the LSCM flattening with FEM relaxation of the flatmesh module.
+# It reports the time of the conformal map and of every relaxation step for a doubly curved
+# sheet and for a tessellated cylinder segment.
+#
+# Run it with: FreeCADCmd tools/profile/meshpart_flattening.py [number of subdivisions]
+
+import math
+import sys
+import time
+
+import numpy as np
+
+import FreeCAD as App
+import Part
+import MeshPart
+import flatmesh
+
+count = 200
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+
+def grid_mesh(n, height):
+    u, v = np.meshgrid(np.linspace(0, 1, n), np.linspace(0, 1, n), indexing="ij")
+    nodes = np.column_stack(
+        (u.ravel() * 300, v.ravel() * 300, height(u.ravel(), v.ravel()))
+    )
+    tris = []
+    for i in range(n - 1):
+        for j in range(n - 1):
+            a, b, c, d = i * n + j, (i + 1) * n + j, (i + 1) * n + j + 1, i * n + j + 1
+            tris.append((a, b, c))
+            tris.append((a, c, d))
+    return nodes, np.array(tris)
+
+
+def shape_mesh(shape, deflection):
+    mesh = MeshPart.meshFromShape(Shape=shape, LinearDeflection=deflection)
+    nodes = np.array([[p.x, p.y, p.z] for p in mesh.Points])
+    tris = np.array(mesh.Topology[1])
+    return nodes, tris
+
+
+def run(name, nodes, tris, steps=5):
+    flattener = flatmesh.LscmRelax(nodes, tris, [])
+    start = time.perf_counter()
+    flattener.lscm()
+    lscm = time.perf_counter() - start
+    times = []
+    for _ in range(steps):
+        start = time.perf_counter()
+        flattener.relax(0.95)
+        times.append(time.perf_counter() - start)
+    print(
+        f"{name:>10}: {len(tris)} triangles, lscm {lscm:.3f} s, "
+        f"first relax {times[0]:.3f} s, following relax {sum(times[1:]) / (steps - 1):.3f} s, "
+        f"area ratio {flattener.flat_area / flattener.area:.5f}"
+    )
+
+
+run("sheet", *grid_mesh(count, lambda u, v: 30 * np.sin(3 * u) * np.cos(2 * v)))
+
+cylinder = Part.makeCylinder(100, 300, App.Vector(), App.Vector(0, 0, 1), 120)
+face = max(cylinder.Faces, key=lambda f: f.Area)
+run("cylinder", *shape_mesh(face, 100.0 / count))
@@ -0,0 +1,55 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of MeshPart.meshFromShape for a shape with many faces.
+# It reports the number of faces per second for each available meshing method. For the
+# standard mesher the serial and the parallel tessellation are compared and the resulting
+# meshes are checked for equality.
+#
+# Run it with: FreeCADCmd tools/profile/meshpart_mesher.py [number of solids]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+import MeshPart
+
+count = 200
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+# an assembly-like compound of filleted solids with a hole
+solids = []
+base = Part.makeBox(10, 10, 10).makeFillet(1, Part.makeBox(10, 10, 10).Edges)
+base = base.cut(Part.makeCylinder(2, 10, App.Vector(5, 5, 0)))
+for i in range(count):
+    solid = base.copy()
+    solid.translate(App.Vector(15 * (i % 20), 15 * (i // 20), 0))
+    solids.append(solid)
+shape = Part.makeCompound(solids)
+num_faces = len(shape.Faces)
+
+
+def run(name, **kwargs):
+    shape.clean()
+    start = time.perf_counter()
+    mesh = MeshPart.meshFromShape(Shape=shape, **kwargs)
+    elapsed = time.perf_counter() - start
+    print(f"{name:>20}: {num_faces / elapsed:10.0f} faces/s ({mesh.CountFacets} triangles)")
+    return mesh
+
+
+serial = run("Standard (serial)", LinearDeflection=0.01, Parallel=False)
+parallel = run("Standard (parallel)", LinearDeflection=0.01, Parallel=True)
+same = serial.Topology == parallel.Topology
+print(f"Serial and parallel mesh are {'identical' if same else 'DIFFERENT'}")
+
+try:
+    run("Mefisto", MaxLength=1.0)
+except Exception as e:
+    print(f"Mefisto: not available ({e})")
+
+try:
+    run("Netgen", Fineness=2)
+except Exception as e:
+    print(f"Netgen: not available ({e})")
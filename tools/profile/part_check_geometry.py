@@ -0,0 +1,35 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the geometry check of a large assembly-like compound.
+# A compound of many filleted boxes is checked with Part.checkGeometry() in one thread and in
+# several threads. The time, the number of parts and the number of invalid parts are reported.
+#
+# Run it with: FreeCADCmd tools/profile/part_check_geometry.py [number of boxes per row]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+
+count = 15
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+box = Part.makeBox(10, 10, 10)
+cell = box.makeFillet(1, box.Edges)
+solids = []
+for i in range(count * count):
+    solid = cell.copy()
+    solid.translate(App.Vector(15 * (i % count), 15 * (i // count), 0))
+    solids.append(solid)
+compound = Part.makeCompound(solids)
+
+for run_bop in (False, True):
+    for parallel in (False, True):
+        start = time.perf_counter()
+        results = Part.checkGeometry(compound, runBopCheck=run_bop, parallel=parallel)
+        elapsed = time.perf_counter() - start
+        invalid = sum(1 for r in results if not r["Valid"])
+        name = ("BOP " if run_bop else "") + ("parallel" if parallel else "serial")
+        print(f"{name:>20}: {elapsed:10.3f} s ({len(results)} parts, {invalid} invalid)")
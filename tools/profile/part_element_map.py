@@ -0,0 +1,120 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the element map generation of Part and PartDesign features.
+# A plate with a grid of holes and filleted hole edges is built twice: as a chain of Part
+# boolean cuts and a Part fillet, and as a PartDesign body with a pad, one pocket per hole
+# and a fillet. Each document is recomputed several times. The time per recompute and the
+# size of the resulting element maps are reported.
+#
+# Run it with: FreeCADCmd tools/profile/part_element_map.py [number of holes]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+import Sketcher  # noqa: F401, registers the sketch type
+
+count = 100
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+
+def hole_position(i):
+    return App.Vector(6 + 12 * (i // 10), 6 + 12 * (i % 10), 0)
+
+
+def top_circle_edges(shape):
+    return [
+        f"Edge{i + 1}"
+        for i, e in enumerate(shape.Edges)
+        if e.Curve.TypeId == "Part::GeomCircle" and e.Vertexes[0].Point.z > 4.9
+    ]
+
+
+def build_part(doc):
+    # a plate with a grid of holes where each cut is a separate feature
+    base = doc.addObject("Part::Box", "Plate")
+    base.Length = 12 * (count // 10 + 1)
+    base.Width = 12 * 11
+    base.Height = 5
+    for i in range(count):
+        hole = doc.addObject("Part::Cylinder", f"Hole{i}")
+        hole.Radius = 3
+        hole.Height = 5
+        hole.Placement.Base = hole_position(i)
+        cut = doc.addObject("Part::Cut", f"Cut{i}")
+        cut.Base = base
+        cut.Tool = hole
+        base = cut
+
+    fillet = doc.addObject("Part::Fillet", "Fillet")
+    fillet.Base = base
+    doc.recompute()
+    fillet.Edges = [(int(name[4:]), 1.0, 1.0) for name in top_circle_edges(base.Shape)]
+    return fillet
+
+
+def build_partdesign(doc):
+    # the same plate as pad, one pocket per hole and a fillet of the hole edges
+    body = doc.addObject("PartDesign::Body", "Body")
+    sketch = body.newObject("Sketcher::SketchObject", "PlateSketch")
+    sketch.AttachmentSupport = (doc.getObject("XY_Plane"), [""])
+    sketch.MapMode = "FlatFace"
+    corners = [
+        App.Vector(0, 0, 0),
+        App.Vector(12 * (count // 10 + 1), 0, 0),
+        App.Vector(12 * (count // 10 + 1), 12 * 11, 0),
+        App.Vector(0, 12 * 11, 0),
+    ]
+    for i in range(4):
+        sketch.addGeometry(Part.LineSegment(corners[i], corners[(i + 1) % 4]))
+    pad = body.newObject("PartDesign::Pad", "Pad")
+    pad.Profile = sketch
+    pad.Length = 5
+
+    base = pad
+    for i in range(count):
+        sketch = body.newObject("Sketcher::SketchObject", f"HoleSketch{i}")
+        sketch.AttachmentSupport = (doc.getObject("XY_Plane"), [""])
+        sketch.MapMode = "FlatFace"
+        sketch.AttachmentOffset = App.Placement(App.Vector(0, 0, 5), App.Rotation())
+        sketch.addGeometry(Part.Circle(hole_position(i), App.Vector(0, 0, 1), 3))
+        pocket = body.newObject("PartDesign::Pocket", f"Pocket{i}")
+        pocket.Profile = sketch
+        pocket.Type = "ThroughAll"
+        base = pocket
+
+    doc.recompute()
+    fillet = body.newObject("PartDesign::Fillet", "Fillet")
+    fillet.Base = (base, top_circle_edges(base.Shape))
+    fillet.Radius = 1.0
+    return fillet
+
+
+def run(name, build):
+    doc = App.newDocument(name)
+    result = build(doc)
+    doc.recompute()
+
+    runs = 3
+    elapsed = []
+    for _ in range(runs):
+        for obj in doc.Objects:
+            obj.touch()
+        start = time.perf_counter()
+        doc.recompute()
+        elapsed.append(time.perf_counter() - start)
+
+    shape = result.Shape
+    print(name)
+    print(f"{'Features':>20}: {len(doc.Objects)}")
+    print(f"{'Faces':>20}: {len(shape.Faces)}")
+    print(f"{'Element map size':>20}: {shape.ElementMapSize}")
+    print(f"{'Recompute':>20}: {min(elapsed):10.3f} s (best of {runs})")
+
+    App.closeDocument(doc.Name)
+
+
+run("PartElementMap", build_part)
+run("PartDesignElementMap", build_partdesign)
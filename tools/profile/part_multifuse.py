@@ -0,0 +1,69 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of a Part MultiFuse of many operands.
+# Rows of plates with bolts are fused once in a single boolean operation and once bottom-up in
+# clusters of overlapping bounding boxes, with at most ClusteredFuseThreshold operands per
+# operation. The time and the volume of the result are reported for a growing number of
+# operands.
+#
+# Run it with: FreeCADCmd tools/profile/part_multifuse.py [maximum number of bolts]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+
+max_bolts = 2000
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    max_bolts = int(sys.argv[-1])
+
+BOLTS_PER_PLATE = 10
+
+
+def make_operands(count):
+    head = Part.makeCylinder(1.5, 1, App.Vector(0, 0, 2))
+    bolt = Part.makeCylinder(0.8, 6, App.Vector(0, 0, -3)).fuse(head)
+    shapes = []
+    for p in range((count + BOLTS_PER_PLATE - 1) // BOLTS_PER_PLATE):
+        x = 50 * (p % 20)
+        y = 10 * (p // 20)
+        shapes.append(Part.makeBox(4 * BOLTS_PER_PLATE, 4, 2, App.Vector(x, y, 0)))
+        for i in range(min(BOLTS_PER_PLATE, count - p * BOLTS_PER_PLATE)):
+            b = bolt.copy()
+            b.translate(App.Vector(x + 2 + 4 * i, y + 2, 0))
+            shapes.append(b)
+    return shapes
+
+
+param = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/Boolean")
+threshold = param.GetInt("ClusteredFuseThreshold", 0)
+clustered_threshold = threshold if threshold > 0 else 50
+doc = App.newDocument("MultiFuseBenchmark")
+
+count = 50
+while count <= max_bolts:
+    shapes = make_operands(count)
+    objects = []
+    for s in shapes:
+        obj = doc.addObject("Part::Feature", "Operand")
+        obj.Shape = s
+        objects.append(obj)
+
+    for name, clustered in (("single", False), ("clustered", True)):
+        param.SetInt("ClusteredFuseThreshold", clustered_threshold if clustered else 0)
+        fuse = doc.addObject("Part::MultiFuse", "Fusion")
+        fuse.Shapes = objects
+        start = time.perf_counter()
+        doc.recompute([fuse])
+        elapsed = time.perf_counter() - start
+        print(f"{len(shapes):6} operands {name:>10}: {elapsed:10.3f} s "
+              f"(volume {fuse.Shape.Volume:.3f})")
+        doc.removeObject(fuse.Name)
+
+    for obj in objects:
+        doc.removeObject(obj.Name)
+    count *= 2
+
+param.SetInt("ClusteredFuseThreshold", threshold)
+App.closeDocument(doc.Name)
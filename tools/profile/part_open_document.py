@@ -0,0 +1,55 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of opening a document with many Part features in the GUI.
+# A document with fused bolts of different sizes is saved and opened once with the shapes
+# meshed one after another and once with the shapes meshed concurrently after the restore
+# (parameter Mod/Part/ParallelTessellation). Each run uses its own geometry so that the
+# tessellation cache doesn't hide the meshing time.
+#
+# Run it with: FreeCAD tools/profile/part_open_document.py [number of shapes]
+
+import os
+import sys
+import tempfile
+import time
+
+import FreeCAD as App
+import FreeCADGui as Gui
+import Part
+
+count = 500
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+
+def make_document(path, scale):
+    doc = App.newDocument("OpenBenchmark")
+    for i in range(count):
+        radius = scale * (1.0 + 0.001 * i)
+        head = Part.makeCylinder(2 * radius, radius, App.Vector(0, 0, 6))
+        bolt = Part.makeCylinder(radius, 6).fuse(head)
+        bolt = bolt.makeFillet(0.2 * radius, bolt.Edges)
+        bolt.translate(App.Vector(10 * (i % 50), 10 * (i // 50), 0))
+        obj = doc.addObject("Part::Feature", "Bolt")
+        obj.Shape = bolt
+    doc.saveAs(path)
+    App.closeDocument(doc.Name)
+
+
+param = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Part")
+parallel = param.GetBool("ParallelTessellation", True)
+
+with tempfile.TemporaryDirectory() as tmp:
+    for run, enabled in enumerate((False, True)):
+        path = os.path.join(tmp, f"open_benchmark_{run}.FCStd")
+        make_document(path, 1.0 + 0.1 * run)
+        param.SetBool("ParallelTessellation", enabled)
+        start = time.perf_counter()
+        doc = App.openDocument(path)
+        Gui.updateGui()
+        elapsed = time.perf_counter() - start
+        name = "concurrent" if enabled else "serial"
+        print(f"{count:6} shapes {name:>10}: {elapsed:10.3f} s")
+        App.closeDocument(doc.Name)
+
+param.SetBool("ParallelTessellation", parallel)
@@ -0,0 +1,39 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the refinement of a shape with many coplanar and coaxial faces.
+# A grid of touching boxes with a hole each is fused without refinement, which is what a large
+# PartDesign pattern produces, and then refined with removeSplitter(). The time and the number
+# of faces before and after the refinement are reported.
+#
+# Run it with: FreeCADCmd tools/profile/part_refine.py [number of boxes per row]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+
+count = 20
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    count = int(sys.argv[-1])
+
+cell = Part.makeBox(10, 10, 5).cut(Part.makeCylinder(2, 5, App.Vector(5, 5, 0)))
+cells = []
+for i in range(count * count):
+    solid = cell.copy()
+    solid.translate(App.Vector(10 * (i % count), 10 * (i // count), 0))
+    cells.append(solid)
+
+start = time.perf_counter()
+fused = cells[0].multiFuse(cells[1:])
+fuse_time = time.perf_counter() - start
+
+start = time.perf_counter()
+refined = fused.removeSplitter()
+refine_time = time.perf_counter() - start
+
+print(f"{'Fuse':>20}: {fuse_time:10.3f} s")
+print(f"{'Refine':>20}: {refine_time:10.3f} s")
+print(f"{'Faces':>20}: {len(fused.Faces)} -> {len(refined.Faces)}")
+print(f"{'Volume':>20}: {fused.Volume:.3f} -> {refined.Volume:.3f}")
+print(f"{'Valid':>20}: {refined.isValid()}")
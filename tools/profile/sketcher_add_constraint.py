@@ -0,0 +1,80 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of adding and removing a constraint in large sketches.
+# Each sketch of a corpus with a growing number of constraints gets a constraint added and
+# removed again several times, once with the solver system rebuilt for each change and once with
+# the solver system updated (parameter Mod/Sketcher/SolverAdvanced/IncrementalSetUp). The mean
+# time of adding and of removing a constraint, including the solve, is reported for each sketch.
+#
+# Run it with: FreeCADCmd tools/profile/sketcher_add_constraint.py [maximum number of constraints]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+import Sketcher
+
+max_constraints = 8000
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    max_constraints = int(sys.argv[-1])
+
+repeat = 10
+V = App.Vector
+
+
+def add_rectangles(sketch, count):
+    """A row of fully constrained rectangles, the width of the last one is free."""
+    for i in range(count):
+        x = 12.0 * i
+        first = sketch.GeometryCount
+        corners = [V(x, 0, 0), V(x + 10.5, 0.2, 0), V(x + 10, 5.3, 0), V(x - 0.2, 5, 0)]
+        for j in range(4):
+            sketch.addGeometry(Part.LineSegment(corners[j], corners[(j + 1) % 4]))
+        constraints = []
+        for j in range(4):
+            constraints.append(Sketcher.Constraint("Coincident", first + j, 2, first + (j + 1) % 4, 1))
+        constraints.append(Sketcher.Constraint("Horizontal", first))
+        constraints.append(Sketcher.Constraint("Horizontal", first + 2))
+        constraints.append(Sketcher.Constraint("Vertical", first + 1))
+        constraints.append(Sketcher.Constraint("Vertical", first + 3))
+        if i < count - 1:
+            constraints.append(Sketcher.Constraint("DistanceX", first, 1, first, 2, 10))
+        constraints.append(Sketcher.Constraint("DistanceY", first + 1, 1, first + 1, 2, 5))
+        if i == 0:
+            constraints.append(Sketcher.Constraint("Coincident", first, 1, -1, 1))
+        else:
+            constraints.append(Sketcher.Constraint("DistanceX", first - 4, 2, first, 1, 2))
+            constraints.append(Sketcher.Constraint("DistanceY", first - 4, 2, first, 1, 0))
+        sketch.addConstraint(constraints)
+
+
+param = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Sketcher/SolverAdvanced")
+incremental = param.GetBool("IncrementalSetUp", True)
+doc = App.newDocument("AddConstraintBenchmark")
+
+count = 250
+while count <= max_constraints:
+    for name, enabled in (("rebuilt", False), ("updated", True)):
+        param.SetBool("IncrementalSetUp", enabled)
+        sketch = doc.addObject("Sketcher::SketchObject", "Sketch")
+        add_rectangles(sketch, max(count // 11, 1))
+        sketch.solve()
+        last = sketch.GeometryCount - 4
+        added = removed = 0.0
+        for step in range(repeat):
+            start = time.perf_counter()
+            index = sketch.addConstraint(Sketcher.Constraint("DistanceX", last, 1, last, 2, 10 + step))
+            middle = time.perf_counter()
+            sketch.delConstraint(index)
+            sketch.solve()
+            end = time.perf_counter()
+            added += middle - start
+            removed += end - middle
+        print(f"{sketch.ConstraintCount:6} constraints {name:>7}: add {1000 * added / repeat:8.2f} ms, "
+              f"remove {1000 * removed / repeat:8.2f} ms")
+        doc.removeObject(sketch.Name)
+    count *= 2
+
+param.SetBool("IncrementalSetUp", incremental)
+App.closeDocument(doc.Name)
@@ -0,0 +1,92 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Benchmark of the Sketcher solver on large sketches.
+# A corpus of sketches with a growing number of constraints is solved once with dense matrices
+# and once with sparse matrices (parameter Mod/Sketcher/SolverAdvanced/SparseThreshold). The time
+# of a full solve and of dragging an arc is reported for each sketch.
+#
+# Run it with: FreeCADCmd tools/profile/sketcher_solver.py [maximum number of constraints]
+
+import sys
+import time
+
+import FreeCAD as App
+import Part
+import Sketcher
+
+max_constraints = 4000
+if len(sys.argv) > 1 and sys.argv[-1].isdigit():
+    max_constraints = int(sys.argv[-1])
+
+V = App.Vector
+
+
+def add_rectangles(sketch, count):
+    """A row of fully constrained rectangles, each at a fixed distance to its neighbour."""
+    for i in range(count):
+        x = 12.0 * i
+        first = sketch.GeometryCount
+        corners = [V(x, 0, 0), V(x + 10.5, 0.2, 0), V(x + 10, 5.3, 0), V(x - 0.2, 5, 0)]
+        for j in range(4):
+            sketch.addGeometry(Part.LineSegment(corners[j], corners[(j + 1) % 4]))
+        constraints = []
+        for j in range(4):
+            constraints.append(Sketcher.Constraint("Coincident", first + j, 2, first + (j + 1) % 4, 1))
+        constraints.append(Sketcher.Constraint("Horizontal", first))
+        constraints.append(Sketcher.Constraint("Horizontal", first + 2))
+        constraints.append(Sketcher.Constraint("Vertical", first + 1))
+        constraints.append(Sketcher.Constraint("Vertical", first + 3))
+        constraints.append(Sketcher.Constraint("DistanceX", first, 1, first, 2, 10))
+        constraints.append(Sketcher.Constraint("DistanceY", first + 1, 1, first + 1, 2, 5))
+        if i == 0:
+            constraints.append(Sketcher.Constraint("Coincident", first, 1, -1, 1))
+        else:
+            constraints.append(Sketcher.Constraint("DistanceX", first - 4, 2, first, 1, 2))
+            constraints.append(Sketcher.Constraint("DistanceY", first - 4, 2, first, 1, 0))
+        sketch.addConstraint(constraints)
+
+
+def add_arc_chain(sketch, count):
+    """A chain of tangent arcs with fixed radii."""
+    first = sketch.GeometryCount
+    for i in range(count):
+        center = V(4.0 * i, 20.0 + (i % 2) * 0.5, 0)
+        arc = Part.ArcOfCircle(Part.Circle(center, V(0, 0, 1), 2.1), 0.0, 3.0)
+        sketch.addGeometry(arc)
+    constraints = [Sketcher.Constraint("Radius", first + i, 2) for i in range(count)]
+    for i in range(1, count):
+        constraints.append(Sketcher.Constraint("Tangent", first + i - 1, 2, first + i, 1))
+    sketch.addConstraint(constraints)
+
+
+def make_sketch(doc, constraints):
+    sketch = doc.addObject("Sketcher::SketchObject", "Sketch")
+    rectangles = constraints * 3 // 4 // 12
+    add_rectangles(sketch, max(rectangles, 1))
+    add_arc_chain(sketch, max((constraints - sketch.ConstraintCount) // 2, 2))
+    return sketch, sketch.GeometryCount - 1
+
+
+param = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Sketcher/SolverAdvanced")
+threshold = param.GetInt("SparseThreshold", 1000)
+doc = App.newDocument("SolverBenchmark")
+
+count = 250
+while count <= max_constraints:
+    for name, value in (("dense", 0), ("sparse", 1)):
+        param.SetInt("SparseThreshold", value)
+        sketch, arc = make_sketch(doc, count)
+        start = time.perf_counter()
+        sketch.solve()
+        solved = time.perf_counter()
+        for step in range(10):
+            # the center of the last arc of the chain is free
+            sketch.moveGeometry(arc, 3, V(0.1, 0.1, 0), True)
+        dragged = time.perf_counter()
+        print(f"{sketch.ConstraintCount:6} constraints {name:>6}: solve {solved - start:8.3f} s, "
+              f"10 drag steps {dragged - solved:8.3f} s")
+        doc.removeObject(sketch.Name)
+    count *= 2
+
+param.SetInt("SparseThreshold", threshold)
+App.closeDocument(doc.Name)